@@ -0,0 +1,267 @@
+/* See LICENSE file for copyright and license details.
+ *
+ * Configuration parser benchmark, run with `make bench`.
+ *
+ * Generates dwm.conf files with the given numbers of keybinds, buttonbinds
+ * and rules (10, 1000, 10000 and 100000 by default), then parses them with
+ * parse_config(), like dwm does, reporting the wall time of every phase it
+ * times, and for the whole parse and config_cleanup() their wall time, the
+ * number and size of the heap allocations they made, and the peak RSS of
+ * the process while they ran. Built on libdwmconf.c, so no X server is
+ * needed. Parser logs are discarded unless -v is given.
+ */
+#include <sys/resource.h>
+#include <time.h>
+
+#include "libdwmconf.c"
+
+typedef struct {
+	double us;
+	unsigned long allocs;
+	unsigned long bytes;
+	long rsskb;
+} Phase;
+
+static const char *benchmods[] = { "Alt", "Super", "Alt + Shift", "Super + Shift",
+	"Alt + Control", "Super + Control", "Alt + Control + Shift", "Super + Alt" };
+static const char *benchkeys[] = { "A", "B", "C", "D", "E", "F", "G", "H", "I",
+	"J", "K", "L", "M", "N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X",
+	"Y", "Z", "1", "2", "3", "4", "5", "6", "7", "8", "9", "0", "F1", "F2", "F3",
+	"F4", "F5", "F6", "F7", "F8", "F9", "F10", "F11", "F12", "Return", "space" };
+static const char *benchbuttons[] = { "Leftclick", "Middleclick", "Rightclick",
+	"Scrollup", "Scrolldown" };
+static const char *benchclicks[] = { "Tag", "Layout", "Status", "Title", "Client",
+	"Desktop" };
+
+static unsigned long nallocs, nbytes;
+
+#ifdef __GLIBC__
+/* count every allocation, including libconfig's, by replacing glibc's
+ * malloc family with thin wrappers around its real implementation */
+void *__libc_malloc(size_t);
+void *__libc_calloc(size_t, size_t);
+void *__libc_realloc(void *, size_t);
+void __libc_free(void *);
+
+void *
+malloc(size_t size)
+{
+	nallocs++;
+	nbytes += size;
+	return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+	nallocs++;
+	nbytes += nmemb * size;
+	return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *p, size_t size)
+{
+	nallocs++;
+	nbytes += size;
+	return __libc_realloc(p, size);
+}
+
+void
+free(void *p)
+{
+	__libc_free(p);
+}
+#endif /* __GLIBC__ */
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/* resets the peak RSS so it can be measured per phase, Linux only */
+static void
+resetrss(void)
+{
+	FILE *f;
+
+	if ((f = fopen("/proc/self/clear_refs", "w"))) {
+		fputs("5", f);
+		fclose(f);
+	}
+}
+
+static long
+peakrss(void)
+{
+	FILE *f;
+	char line[256];
+	long kb = -1;
+	struct rusage ru;
+
+	if ((f = fopen("/proc/self/status", "r"))) {
+		while (fgets(line, sizeof line, f))
+			if (sscanf(line, "VmHWM: %ld kB", &kb) == 1)
+				break;
+		fclose(f);
+	}
+	if (kb < 0 && !getrusage(RUSAGE_SELF, &ru))
+		kb = ru.ru_maxrss;
+	return kb;
+}
+
+static void
+begin(Phase *p, double *start)
+{
+	resetrss();
+	p->allocs = nallocs;
+	p->bytes = nbytes;
+	*start = now();
+}
+
+static void
+end(Phase *p, double start)
+{
+	p->us = now() - start;
+	p->allocs = nallocs - p->allocs;
+	p->bytes = nbytes - p->bytes;
+	p->rsskb = peakrss();
+}
+
+static int
+generate(const char *path, unsigned int n)
+{
+	FILE *f;
+	unsigned int i;
+
+	if (!(f = fopen(path, "w")))
+		return -1;
+	fputs("themes = ( { fonts = ( \"monospace:size=10\" );\n"
+	      "\tnormal-foreground = \"#bbbbbb\"; normal-background = \"#222222\"; normal-border = \"#444444\";\n"
+	      "\tselected-foreground = \"#eeeeee\"; selected-background = \"#005577\"; selected-border = \"#005577\"; } );\n", f);
+	fputs("rules = (\n", f);
+	for (i = 0; i < n; i++)
+		fprintf(f, "\t{ class = \"Class%u\"; instance = \"%s\"; title = \"Title %u\"; tag-mask = %u; floating = %u; monitor = -1; }%s\n",
+		        i, i % 4 ? "NULL" : "instance", i % 16, i % 512, i % 2, i + 1 < n ? "," : "");
+	fputs(");\nkeybinds = (\n", f);
+	for (i = 0; i < n; i++) {
+		fprintf(f, "\t{ modifier = \"%s\", key = \"%s\", ", benchmods[i % LENGTH(benchmods)],
+		        benchkeys[i / LENGTH(benchmods) % LENGTH(benchkeys)]);
+		switch (i % 4) {
+		case 0: fprintf(f, "function = \"spawn\", argument = \"command-%u --flag\" }", i % 64); break;
+		case 1: fprintf(f, "function = \"view\", argument = %u }", 1u << (i % 9)); break;
+		case 2: fprintf(f, "function = \"focusstack\", argument = %d }", i % 8 ? 1 : -1); break;
+		case 3: fputs("function = \"zoom\" }", f); break;
+		}
+		fputs(i + 1 < n ? ",\n" : "\n", f);
+	}
+	fputs(");\nbuttonbinds = (\n", f);
+	for (i = 0; i < n; i++)
+		fprintf(f, "\t{ modifier = \"%s\", button = \"%s\", click = \"%s\", function = \"%s\" }%s\n",
+		        i % 2 ? "Alt" : "", benchbuttons[i % LENGTH(benchbuttons)], benchclicks[i / 2 % LENGTH(benchclicks)],
+		        i % 3 ? "togglefloating" : "zoom", i + 1 < n ? "," : "");
+	fputs(");\ntags = ( \"1\", \"2\", \"3\", \"4\", \"5\", \"6\", \"7\", \"8\", \"9\" );\n"
+	      "showbar = true; topbar = true; resizehints = true; lockfullscreen = true;\n"
+	      "borderpx = 1; snap = 32; nmaster = 1; refreshrate = 120; statusrate = 30; mfact = 0.55;\n", f);
+	return fclose(f);
+}
+
+/* parses path once, the phases parse_config() timed are left in
+ * _parser_report */
+static int
+run(const char *path, Phase *parse, Phase *cleanup)
+{
+	double t;
+	int errors;
+
+	begin(parse, &t);
+	errors = dwmconf_parse(path);
+	end(parse, t);
+	/* loaded from a snapshot, nothing was parsed */
+	if (errors >= 0 && !_parser_report.phase_nanoseconds[PHASE_READ])
+		errors = -1;
+	begin(cleanup, &t);
+	dwmconf_cleanup();
+	end(cleanup, t);
+	return errors;
+}
+
+static int
+bench(FILE *out, const char *dir, unsigned int n)
+{
+	char path[PATH_MAX];
+	Phase ph[2], sum[2];
+	double phases[PHASE_ENUM_LENGTH] = { 0 };
+	unsigned int i, r, reps = MAX(1, MIN(1000, 10000 / MAX(n, 1)));
+	int errors = 0;
+
+	snprintf(path, sizeof path, "%s/dwm-%u.conf", dir, n);
+	if (generate(path, n)) {
+		fprintf(stderr, "dwm-bench: cannot write %s\n", path);
+		return -1;
+	}
+	memset(sum, 0, sizeof sum);
+	for (r = 0; r < reps; r++) {
+		memset(ph, 0, sizeof ph);
+		if ((errors = run(path, &ph[0], &ph[1])) < 0) {
+			fprintf(stderr, "dwm-bench: cannot parse %s\n", path);
+			return -1;
+		}
+		for (i = 0; i < PHASE_ENUM_LENGTH; i++)
+			phases[i] += _parser_report.phase_nanoseconds[i] / 1e3;
+		for (i = 0; i < LENGTH(ph); i++) {
+			sum[i].us += ph[i].us;
+			sum[i].allocs = ph[i].allocs;
+			sum[i].bytes = ph[i].bytes;
+			sum[i].rsskb = MAX(sum[i].rsskb, ph[i].rsskb);
+		}
+	}
+	fprintf(out, "\n%u keybinds, buttonbinds and rules, %u run%s, %d error%s\n",
+	        n, reps, reps == 1 ? "" : "s", errors, errors == 1 ? "" : "s");
+	fprintf(out, "%-28s %12s %10s %12s %12s\n", "phase", "time (us)", "allocs", "alloc (KiB)", "peak (KiB)");
+	for (i = 0; i < PHASE_ENUM_LENGTH; i++)
+		fprintf(out, "%-28s %12.1f\n", PHASE_ENUM_STRINGS[i], phases[i] / reps);
+	for (i = 0; i < LENGTH(ph); i++)
+		fprintf(out, "%-28s %12.1f %10lu %12.1f %12ld\n", i ? "config_cleanup" : "parse_config",
+		        sum[i].us / reps, sum[i].allocs, sum[i].bytes / 1024.0, sum[i].rsskb);
+	remove(path);
+	return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+	static const unsigned int defaults[] = { 10, 1000, 10000, 100000 };
+	char dir[] = "/tmp/dwm-bench.XXXXXX", data[sizeof(dir) + 5];
+	FILE *out = stdout, *f;
+	int i, verbose = 0, ret = 0, nsizes = 0;
+
+	if (argc > 1 && !strcmp(argv[1], "-v"))
+		verbose = 1;
+	if (!mkdtemp(dir))
+		die("dwm-bench: mkdtemp:");
+	/* a file in place of the data directory keeps the parses from touching
+	 * the user's backup and snapshot, and from writing any, so every run
+	 * parses instead of loading the snapshot of the previous one */
+	snprintf(data, sizeof data, "%s/data", dir);
+	if (!(f = fopen(data, "w")) || fclose(f))
+		die("dwm-bench: cannot write %s:", data);
+	setenv("XDG_DATA_HOME", data, 1);
+	if (!verbose) {
+		out = fdopen(dup(STDOUT_FILENO), "w");
+		if (!out || !freopen("/dev/null", "w", stdout))
+			die("dwm-bench: cannot redirect parser logs:");
+	}
+	for (i = 1 + verbose; i < argc; i++, nsizes++)
+		ret |= bench(out, dir, strtoul(argv[i], NULL, 10));
+	for (i = 0; !nsizes && i < (int)LENGTH(defaults); i++)
+		ret |= bench(out, dir, defaults[i]);
+	fclose(out);
+	remove(data);
+	rmdir(dir);
+	return ret ? 1 : 0;
+}
@@ -36,7 +36,9 @@ static float mfact        = 0.55; /* factor of master area size [0.05..0.95] */
 static int nmaster        = 1;    /* number of clients in master area */
 static int resizehints    = 1;    /* 1 means respect size hints in tiled resizals */
 static int lockfullscreen = 1;    /* 1 will force focus on the fullscreen window */
-static int refreshrate    = 120;  /* refresh rate (per second) for client move/resize */
+static int refreshrate    = 120;  /* client move/resize rate (per second) if the monitor's is unknown */
+static int statusrate     = 30;   /* status redraws per second at most, 0 for no limit */
+static const char *ipcsocket = NULL; /* control socket path, NULL for $XDG_RUNTIME_DIR/dwm-<display>.sock, "" for none */
 
 static const Layout layouts[] = {
 	/* symbol     arrange function */
@@ -96,6 +98,7 @@ static Key default_keys[] = {
 	TAGKEYS(                        XK_8,                      7)
 	TAGKEYS(                        XK_9,                      8)
 	{ MODKEY|ShiftMask,             XK_q,      quit,           {0} },
+	{ MODKEY|ControlMask|ShiftMask, XK_q,      restart,        {0} },
 };
 
 /* button definitions */
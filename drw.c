@@ -1,7 +1,9 @@
 /* See LICENSE file for copyright and license details. */
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <X11/Xlib.h>
 #include <X11/Xft/Xft.h>
 
@@ -9,6 +11,45 @@
 #include "util.h"
 
 #define UTF_INVALID 0xFFFD
+#define GLYPHCACHE  1024 /* must be a power of two */
+#define MATCHBLOCK  7    /* codepoints share a font match in blocks of 1 << MATCHBLOCK */
+#define MAXMATCHES  1024
+
+/* first font of a fontset with a glyph for a codepoint, and its width */
+struct Glyph {
+	long codepoint;
+	unsigned int w;
+	Fnt *font;
+};
+
+/* font fontconfig matched for a block of codepoints, for fallbacks of the
+ * fontset whose first font is base */
+struct FontMatch {
+	long block;
+	int index;
+	char *base, *file;
+};
+
+/* returns the length of the printable ASCII run at the start of s, which is
+ * a string ending at end, checking 8 bytes at a time */
+static size_t
+asciirun(const char *s, const char *end)
+{
+	const uint64_t ones = 0x0101010101010101ULL, high = ones << 7;
+	const char *p = s;
+	uint64_t v, t;
+
+	for (; end - p >= 8; p += 8) {
+		memcpy(&v, p, sizeof(v));
+		t = v & ~high;
+		/* high bit of each byte: set if >= 0x20, set if >= 0x7F */
+		if (high & ~(~v & (t + ones * (0x80 - 0x20)) & ~(t + ones)))
+			break;
+	}
+	for (; p < end && *p >= 0x20 && *p < 0x7F; p++)
+		;
+	return p - s;
+}
 
 static int
 utf8decode(const char *s_in, long *u, int *err)
@@ -82,6 +123,11 @@ drw_free(Drw *drw)
 	XFreePixmap(drw->dpy, drw->drawable);
 	XFreeGC(drw->dpy, drw->gc);
 	drw_fontset_free(drw->fonts);
+	for (size_t i = 0; i < drw->nmatches; i++) {
+		free(drw->matches[i].base);
+		free(drw->matches[i].file);
+	}
+	free(drw->matches);
 	free(drw);
 }
 
@@ -94,6 +140,7 @@ xfont_create(Drw *drw, const char *fontname, FcPattern *fontpattern)
 	Fnt *font;
 	XftFont *xfont = NULL;
 	FcPattern *pattern = NULL;
+	FcChar32 c;
 
 	if (fontname) {
 		/* Using the pattern found at font->xfont->pattern does not yield the
@@ -122,8 +169,13 @@ xfont_create(Drw *drw, const char *fontname, FcPattern *fontpattern)
 	font = ecalloc(1, sizeof(Fnt));
 	font->xfont = xfont;
 	font->pattern = pattern;
+	if (fontname && !(font->name = strdup(fontname)))
+		die("strdup:");
 	font->h = xfont->ascent + xfont->descent;
 	font->dpy = drw->dpy;
+	for (c = 0x20; c < 0x7F && XftCharExists(drw->dpy, xfont, c); c++)
+		; /* NOP */
+	font->ascii = c == 0x7F;
 
 	return font;
 }
@@ -135,10 +187,177 @@ xfont_free(Fnt *font)
 		return;
 	if (font->pattern)
 		FcPatternDestroy(font->pattern);
-	XftFontClose(font->dpy, font->xfont);
+	if (font->xfont)
+		XftFontClose(font->dpy, font->xfont);
+	free(font->name);
+	free(font->glyphs);
 	free(font);
 }
 
+/* loads a fallback font created by drw_fontset_create() in place */
+static int
+xfont_load(Drw *drw, Fnt *font)
+{
+	Fnt *loaded;
+
+	if (!(loaded = xfont_create(drw, font->name, NULL)))
+		return 0;
+	font->xfont = loaded->xfont;
+	font->pattern = loaded->pattern;
+	font->h = loaded->h;
+	font->ascii = loaded->ascii;
+	free(loaded->name);
+	free(loaded);
+	return 1;
+}
+
+static struct FontMatch *
+fontmatch_find(Drw *drw, long block, const char *base)
+{
+	size_t i;
+
+	for (i = 0; i < drw->nmatches; i++)
+		if (drw->matches[i].block == block && !strcmp(drw->matches[i].base, base))
+			return &drw->matches[i];
+	return NULL;
+}
+
+/* returns fontconfig's pattern of the font in m, without opening it */
+static FcPattern *
+fontmatch_face(const struct FontMatch *m)
+{
+	FcFontSet *set;
+	FcChar8 *file;
+	int i, index;
+
+	if (!(set = FcConfigGetFonts(NULL, FcSetSystem)))
+		return NULL;
+	for (i = 0; i < set->nfont; i++)
+		if (FcPatternGetString(set->fonts[i], FC_FILE, 0, &file) == FcResultMatch
+		&& !strcmp((char *)file, m->file)
+		&& FcPatternGetInteger(set->fonts[i], FC_INDEX, 0, &index) == FcResultMatch
+		&& index == m->index)
+			return set->fonts[i];
+	return NULL;
+}
+
+static void
+fontmatch_add(Drw *drw, long block, int index, const char *base, const char *file)
+{
+	struct FontMatch *m;
+
+	if (!(m = fontmatch_find(drw, block, base))) {
+		if (drw->nmatches >= MAXMATCHES)
+			return;
+		if (!(drw->matches = realloc(drw->matches, (drw->nmatches + 1) * sizeof(struct FontMatch))))
+			die("realloc:");
+		m = &drw->matches[drw->nmatches++];
+		if (!(m->base = strdup(base)))
+			die("strdup:");
+	} else {
+		free(m->file);
+	}
+	m->block = block;
+	m->index = index;
+	if (!(m->file = strdup(file)))
+		die("strdup:");
+}
+
+/* Returns a pattern of a font with a glyph for codepoint u, to fall back on
+ * when none of the fontset has it. The font matched before for a codepoint
+ * near u, in this session or a previous one, is tried before fontconfig is
+ * asked to score every font it knows for one.
+ */
+static FcPattern *
+xfont_match(Drw *drw, long u)
+{
+	FcCharSet *fccharset, *cs;
+	FcPattern *fcpattern, *face, *match = NULL;
+	FcChar8 *file;
+	XftResult result;
+	struct FontMatch *m;
+	int index;
+
+	if (!drw->fonts->pattern) {
+		/* Refer to the comment in xfont_create for more information. */
+		die("the first font in the cache must be loaded from a font string.");
+	}
+
+	fccharset = FcCharSetCreate();
+	FcCharSetAddChar(fccharset, u);
+
+	fcpattern = FcPatternDuplicate(drw->fonts->pattern);
+	FcPatternAddCharSet(fcpattern, FC_CHARSET, fccharset);
+	FcPatternAddBool(fcpattern, FC_SCALABLE, FcTrue);
+
+	FcConfigSubstitute(NULL, fcpattern, FcMatchPattern);
+	FcDefaultSubstitute(fcpattern);
+
+	if ((m = fontmatch_find(drw, u >> MATCHBLOCK, drw->fonts->name)) && (face = fontmatch_face(m))
+	&& FcPatternGetCharSet(face, FC_CHARSET, 0, &cs) == FcResultMatch && FcCharSetHasChar(cs, u)) {
+		/* what XftFontMatch() would have done before matching */
+		XftDefaultSubstitute(drw->dpy, drw->screen, fcpattern);
+		match = FcFontRenderPrepare(NULL, fcpattern, face);
+	}
+	if (!match && (match = XftFontMatch(drw->dpy, drw->screen, fcpattern, &result))
+	&& FcPatternGetString(match, FC_FILE, 0, &file) == FcResultMatch
+	&& FcPatternGetCharSet(match, FC_CHARSET, 0, &cs) == FcResultMatch && FcCharSetHasChar(cs, u)) {
+		if (FcPatternGetInteger(match, FC_INDEX, 0, &index) != FcResultMatch)
+			index = 0;
+		fontmatch_add(drw, u >> MATCHBLOCK, index, drw->fonts->name, (char *)file);
+		drw->matcheschanged = 1;
+	}
+
+	FcCharSetDestroy(fccharset);
+	FcPatternDestroy(fcpattern);
+
+	return match;
+}
+
+/* Returns the first font of the fontset with a glyph for codepoint u, and
+ * its width in w. Neither changes once found, as fallback fonts are only
+ * ever appended to the fontset and loaded in order, so they are cached on
+ * its first font.
+ */
+static Fnt *
+xfont_glyph(Drw *drw, const char *text, int len, long u, int err, unsigned int *w)
+{
+	struct Glyph *g = NULL;
+	Fnt *f, **fp;
+
+	/* invalid sequences are measured by their bytes, not by codepoint */
+	if (!err) {
+		if (!drw->fonts->glyphs)
+			drw->fonts->glyphs = ecalloc(GLYPHCACHE, sizeof(struct Glyph));
+		g = &drw->fonts->glyphs[u & (GLYPHCACHE - 1)];
+		if (g->font && g->codepoint == u) {
+			*w = g->w;
+			return g->font;
+		}
+	}
+	for (fp = &drw->fonts; (f = *fp); fp = &f->next) {
+		/* fallback fonts are only loaded once a glyph is looked up in them */
+		while (f && !f->xfont && !xfont_load(drw, f)) {
+			*fp = f->next;
+			xfont_free(f);
+			f = *fp;
+		}
+		if (!f || XftCharExists(drw->dpy, f->xfont, u))
+			break;
+	}
+	if (!f)
+		return NULL;
+	drw_font_getexts(f, text, len, w, NULL);
+	if (g) {
+		g->codepoint = u;
+		g->w = *w;
+		g->font = f;
+	}
+	return f;
+}
+
+/* Only the first font that can be loaded is, the rest are fallbacks loaded
+ * the first time a glyph is looked up in them, see xfont_glyph(). */
 Fnt*
 drw_fontset_create(Drw* drw, const char *fonts[], size_t fontcount)
 {
@@ -148,11 +367,13 @@ drw_fontset_create(Drw* drw, const char *fonts[], size_t fontcount)
 	if (!drw || !fonts)
 		return NULL;
 
-	for (i = 1; i <= fontcount; i++) {
-		if ((cur = xfont_create(drw, fonts[fontcount - i], NULL))) {
-			cur->next = ret;
-			ret = cur;
-		}
+	for (i = 0; i < fontcount && !ret; i++)
+		ret = xfont_create(drw, fonts[i], NULL);
+	for (cur = ret; ret && i < fontcount; i++, cur = cur->next) {
+		cur->next = ecalloc(1, sizeof(Fnt));
+		cur->next->dpy = drw->dpy;
+		if (!(cur->next->name = strdup(fonts[i])))
+			die("strdup:");
 	}
 	return (drw->fonts = ret);
 }
@@ -166,6 +387,66 @@ drw_fontset_free(Fnt *font)
 	}
 }
 
+/* reads the fonts fontconfig matched in previous sessions from path */
+void
+drw_fontcache_load(Drw *drw, const char *path)
+{
+	FILE *fp;
+	char *line = NULL, *base, *file, *end;
+	size_t size = 0;
+	ssize_t len;
+	long block;
+	int index;
+
+	if (!drw || !path || !(fp = fopen(path, "r")))
+		return;
+	/* block, index, base and file, separated by tabs */
+	while ((len = getline(&line, &size, fp)) > 0) {
+		if (line[len - 1] == '\n')
+			line[len - 1] = '\0';
+		block = strtol(line, &end, 16);
+		if (*end != '\t')
+			continue;
+		index = strtol(end + 1, &end, 10);
+		if (*end != '\t' || !(file = strchr(base = end + 1, '\t')))
+			continue;
+		*file++ = '\0';
+		fontmatch_add(drw, block, index, base, file);
+	}
+	free(line);
+	fclose(fp);
+}
+
+/* writes the fonts fontconfig matched to path, if there were new ones */
+void
+drw_fontcache_save(Drw *drw, const char *path)
+{
+	FILE *fp;
+	char tmp[4096];
+	size_t i;
+	int fd, err;
+
+	/* a unique file, synced before it replaces the cache, so neither a
+	 * concurrent save nor a crash leaves a partial one */
+	if (!drw || !path || !drw->matcheschanged
+	|| snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path) >= (int)sizeof(tmp)
+	|| (fd = mkstemp(tmp)) == -1)
+		return;
+	if (!(fp = fdopen(fd, "w"))) {
+		close(fd);
+		remove(tmp);
+		return;
+	}
+	for (i = 0; i < drw->nmatches; i++)
+		fprintf(fp, "%lx\t%d\t%s\t%s\n", drw->matches[i].block, drw->matches[i].index,
+		        drw->matches[i].base, drw->matches[i].file);
+	err = fflush(fp) || ferror(fp) || fsync(fileno(fp));
+	if (fclose(fp) || err || rename(tmp, path))
+		remove(tmp);
+	else
+		drw->matcheschanged = 0;
+}
+
 void
 drw_clr_create(Drw *drw, Clr *dest, const char *clrname)
 {
@@ -253,19 +534,19 @@ drw_text(Drw *drw, int x, int y, unsigned int w, unsigned int h, unsigned int lp
 	Fnt *usedfont, *curfont, *nextfont;
 	int utf8strlen, utf8charlen, utf8err, render = x || y || w || h;
 	long utf8codepoint = 0;
-	const char *utf8str;
-	FcCharSet *fccharset;
-	FcPattern *fcpattern;
+	size_t runlen;
+	const char *utf8str, *end;
 	FcPattern *match;
-	XftResult result;
 	int charexists = 0, overflow = 0;
 	/* keep track of a couple codepoints for which we have no match. */
-	static unsigned int nomatches[128], ellipsis_width, invalid_width;
+	static unsigned int nomatches[128];
 	static const char invalid[] = "�";
+	unsigned int ellipsis_width, invalid_width;
 
 	if (!drw || (render && (!drw->scheme || !w)) || !text || !drw->fonts)
 		return 0;
 
+	end = text + strlen(text);
 	if (!render) {
 		w = invert ? invert : ~invert;
 	} else {
@@ -281,44 +562,62 @@ drw_text(Drw *drw, int x, int y, unsigned int w, unsigned int h, unsigned int lp
 	}
 
 	usedfont = drw->fonts;
-	if (!ellipsis_width && render)
-		ellipsis_width = drw_fontset_getwidth(drw, "...");
-	if (!invalid_width && render)
-		invalid_width = drw_fontset_getwidth(drw, invalid);
+	/* measured once per fontset, themes switch between them */
+	if (!usedfont->ellipsisw && render)
+		usedfont->ellipsisw = drw_fontset_getwidth(drw, "...");
+	if (!usedfont->invalidw && render)
+		usedfont->invalidw = drw_fontset_getwidth(drw, invalid);
+	ellipsis_width = usedfont->ellipsisw;
+	invalid_width = usedfont->invalidw;
 	while (1) {
 		ew = ellipsis_len = utf8err = utf8charlen = utf8strlen = 0;
 		utf8str = text;
 		nextfont = NULL;
 		while (*text) {
+			/* measure a run of ASCII the first font has at once, as
+			 * long as the text can't overflow or need an ellipsis in it */
+			if (!charexists && usedfont == drw->fonts && usedfont->ascii
+			&& (runlen = asciirun(text, end)) > 1) {
+				drw_font_getexts(usedfont, text, runlen, &tmpw, NULL);
+				if (ew + tmpw + ellipsis_width <= w) {
+					text += runlen;
+					utf8strlen += runlen;
+					ew += tmpw;
+					continue;
+				}
+			}
 			utf8charlen = utf8decode(text, &utf8codepoint, &utf8err);
-			for (curfont = drw->fonts; curfont; curfont = curfont->next) {
-				charexists = charexists || XftCharExists(drw->dpy, curfont->xfont, utf8codepoint);
-				if (charexists) {
-					drw_font_getexts(curfont, text, utf8charlen, &tmpw, NULL);
-					if (ew + ellipsis_width <= w) {
-						/* keep track where the ellipsis still fits */
-						ellipsis_x = x + ew;
-						ellipsis_w = w - ew;
-						ellipsis_len = utf8strlen;
-					}
-
-					if (ew + tmpw > w) {
-						overflow = 1;
-						/* called from drw_fontset_getwidth_clamp():
-						 * it wants the width AFTER the overflow
-						 */
-						if (!render)
-							x += tmpw;
-						else
-							utf8strlen = ellipsis_len;
-					} else if (curfont == usedfont) {
-						text += utf8charlen;
-						utf8strlen += utf8err ? 0 : utf8charlen;
-						ew += utf8err ? 0 : tmpw;
-					} else {
-						nextfont = curfont;
-					}
-					break;
+			if (charexists) {
+				/* no font has it, draw it with the first one anyway */
+				curfont = drw->fonts;
+				drw_font_getexts(curfont, text, utf8charlen, &tmpw, NULL);
+			} else {
+				curfont = xfont_glyph(drw, text, utf8charlen, utf8codepoint, utf8err, &tmpw);
+				charexists = curfont != NULL;
+			}
+			if (charexists) {
+				if (ew + ellipsis_width <= w) {
+					/* keep track where the ellipsis still fits */
+					ellipsis_x = x + ew;
+					ellipsis_w = w - ew;
+					ellipsis_len = utf8strlen;
+				}
+
+				if (ew + tmpw > w) {
+					overflow = 1;
+					/* called from drw_fontset_getwidth_clamp():
+					 * it wants the width AFTER the overflow
+					 */
+					if (!render)
+						x += tmpw;
+					else
+						utf8strlen = ellipsis_len;
+				} else if (curfont == usedfont) {
+					text += utf8charlen;
+					utf8strlen += utf8err ? 0 : utf8charlen;
+					ew += utf8err ? 0 : tmpw;
+				} else {
+					nextfont = curfont;
 				}
 			}
 
@@ -365,26 +664,7 @@ drw_text(Drw *drw, int x, int y, unsigned int w, unsigned int h, unsigned int lp
 			if (nomatches[h0] == utf8codepoint || nomatches[h1] == utf8codepoint)
 				goto no_match;
 
-			fccharset = FcCharSetCreate();
-			FcCharSetAddChar(fccharset, utf8codepoint);
-
-			if (!drw->fonts->pattern) {
-				/* Refer to the comment in xfont_create for more information. */
-				die("the first font in the cache must be loaded from a font string.");
-			}
-
-			fcpattern = FcPatternDuplicate(drw->fonts->pattern);
-			FcPatternAddCharSet(fcpattern, FC_CHARSET, fccharset);
-			FcPatternAddBool(fcpattern, FC_SCALABLE, FcTrue);
-
-			FcConfigSubstitute(NULL, fcpattern, FcMatchPattern);
-			FcDefaultSubstitute(fcpattern);
-			match = XftFontMatch(drw->dpy, drw->screen, fcpattern, &result);
-
-			FcCharSetDestroy(fccharset);
-			FcPatternDestroy(fcpattern);
-
-			if (match) {
+			if ((match = xfont_match(drw, utf8codepoint))) {
 				usedfont = xfont_create(drw, NULL, match);
 				if (usedfont && XftCharExists(drw->dpy, usedfont->xfont, utf8codepoint)) {
 					for (curfont = drw->fonts; curfont->next; curfont = curfont->next)
@@ -406,12 +686,21 @@ no_match:
 }
 
 void
-drw_map(Drw *drw, Window win, int x, int y, unsigned int w, unsigned int h)
+drw_copy(Drw *drw, Window win, int x, int y, unsigned int w, unsigned int h)
 {
 	if (!drw)
 		return;
 
 	XCopyArea(drw->dpy, drw->drawable, win, drw->gc, x, y, w, h, x, y);
+}
+
+void
+drw_map(Drw *drw, Window win, int x, int y, unsigned int w, unsigned int h)
+{
+	if (!drw)
+		return;
+
+	drw_copy(drw, win, x, y, w, h);
 	XSync(drw->dpy, False);
 }
 
@@ -7,9 +7,13 @@ typedef struct {
 typedef struct Fnt {
 	Display *dpy;
 	unsigned int h;
-	XftFont *xfont;
+	XftFont *xfont; /* NULL for a fallback font not loaded yet */
 	FcPattern *pattern;
+	char *name;
 	struct Fnt *next;
+	struct Glyph *glyphs; /* codepoint cache of a fontset's first font */
+	unsigned int ellipsisw, invalidw; /* a fontset's, in its first font, see drw_text() */
+	int ascii; /* has all printable ASCII, see asciirun() */
 } Fnt;
 
 enum { ColFg, ColBg, ColBorder }; /* Clr scheme index */
@@ -24,6 +28,9 @@ typedef struct {
 	GC gc;
 	Clr *scheme;
 	Fnt *fonts;
+	struct FontMatch *matches; /* fonts fontconfig matched, see drw_fontcache_load() */
+	size_t nmatches;
+	int matcheschanged;
 } Drw;
 
 /* Drawable abstraction */
@@ -37,6 +44,8 @@ void drw_fontset_free(Fnt* set);
 unsigned int drw_fontset_getwidth(Drw *drw, const char *text);
 unsigned int drw_fontset_getwidth_clamp(Drw *drw, const char *text, unsigned int n);
 void drw_font_getexts(Fnt *font, const char *text, unsigned int len, unsigned int *w, unsigned int *h);
+void drw_fontcache_load(Drw *drw, const char *path);
+void drw_fontcache_save(Drw *drw, const char *path);
 
 /* Colorscheme abstraction */
 void drw_clr_create(Drw *drw, Clr *dest, const char *clrname);
@@ -57,4 +66,5 @@ void drw_rect(Drw *drw, int x, int y, unsigned int w, unsigned int h, int filled
 int drw_text(Drw *drw, int x, int y, unsigned int w, unsigned int h, unsigned int lpad, const char *text, int invert);
 
 /* Map functions */
+void drw_copy(Drw *drw, Window win, int x, int y, unsigned int w, unsigned int h);
 void drw_map(Drw *drw, Window win, int x, int y, unsigned int w, unsigned int h);
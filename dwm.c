@@ -20,15 +20,30 @@
  *
  * To understand everything else, start reading main().
  */
+#ifdef __linux__
+#define _GNU_SOURCE /* struct ucred, see ipcaccept() */
+#endif /* __linux__ */
 #include <errno.h>
+#include <fcntl.h>
 #include <locale.h>
+#include <poll.h>
+#include <pthread.h>
 #include <signal.h>
+#include <spawn.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif /* __linux__ */
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <X11/cursorfont.h>
 #include <X11/keysym.h>
@@ -39,6 +54,9 @@
 #ifdef XINERAMA
 #include <X11/extensions/Xinerama.h>
 #endif /* XINERAMA */
+#ifdef XRANDR
+#include <X11/extensions/Xrandr.h>
+#endif /* XRANDR */
 #include <X11/Xft/Xft.h>
 
 #include "drw.h"
@@ -55,6 +73,16 @@
 #define HEIGHT(X)               ((X)->h + 2 * (X)->bw)
 #define TAGMASK                 ((1 << LENGTH(tags)) - 1)
 #define TEXTW(X)                (drw_fontset_getwidth(drw, (X)) + lrpad)
+#define LATBUCKETS              24 /* 1us to 8s in powers of two */
+#define SESSIONVERSION          1
+#define FONTCACHE               "dwm_fonts.cache" /* next to the configuration backup */
+#define FONTCACHEDELAY          2000 /* ms from new fontconfig matches to saving them */
+#define IPCCLIENTS              8 /* connections to ipcsocket at once */
+#ifdef POSIX_SPAWN_SETSID
+#define SPAWNSESSION            POSIX_SPAWN_SETSID
+#else /* own process group where the libc can't start a new session */
+#define SPAWNSESSION            POSIX_SPAWN_SETPGROUP
+#endif
 
 /* enums */
 enum { CurNormal, CurResize, CurMove, CurLast }; /* cursor */
@@ -62,9 +90,10 @@ enum { SchemeNorm, SchemeSel }; /* color schemes */
 enum { NetSupported, NetWMName, NetWMState, NetWMCheck,
        NetWMFullscreen, NetActiveWindow, NetWMWindowType,
        NetWMWindowTypeDialog, NetClientList, NetLast }; /* EWMH atoms */
-enum { WMProtocols, WMDelete, WMState, WMTakeFocus, WMLast }; /* default atoms */
+enum { WMProtocols, WMDelete, WMState, WMTakeFocus, WMSession, WMLast }; /* default atoms */
 enum { ClkTagBar, ClkLtSymbol, ClkStatusText, ClkWinTitle,
        ClkClientWin, ClkRootWin, ClkLast }; /* clicks */
+enum { BatchBar = 1, BatchRestack = 2, BatchArrange = 4 }; /* deferred work */
 
 typedef union {
 	int i;
@@ -81,6 +110,16 @@ typedef struct {
 	Arg arg;
 } Button;
 
+typedef struct {
+	int valid;            /* redraw everything if not */
+	int ww, tw;           /* bar and status width */
+	unsigned int seltags, occ, urg, filled;
+	char stext[256];
+	char ltsymbol[16];
+	int tx, title;        /* title x and what was drawn there */
+	char name[256];
+} Bar; /* what a bar last showed, see drawbar() */
+
 typedef struct Monitor Monitor;
 typedef struct Client Client;
 struct Client {
@@ -90,14 +129,24 @@ struct Client {
 	int oldx, oldy, oldw, oldh;
 	int basew, baseh, incw, inch, maxw, maxh, minw, minh, hintsvalid;
 	int bw, oldbw;
+	int cfgx, cfgy, cfgw, cfgh, cfgbw; /* geometry last sent to the server */
 	unsigned int tags;
 	int isfixed, isfloating, isurgent, neverfocus, oldstate, isfullscreen;
+	int shown, refit;     /* on screen, and to be fit again, see showhide() */
+	Window stacked;       /* sibling restack() last put it below */
 	Client *next;
 	Client *snext;
 	Monitor *mon;
 	Window win;
 };
 
+typedef struct {
+	int fd;               /* -1 if unused */
+	unsigned int oks;     /* commands that ran and are not answered yet */
+	size_t len;
+	char buf[1024];       /* start of a command, until its newline */
+} IpcClient; /* a connection to ipcsocket, see ipcread() */
+
 typedef struct {
 	unsigned int mod;
 	KeySym keysym;
@@ -105,6 +154,11 @@ typedef struct {
 	Arg arg;
 } Key;
 
+typedef struct {
+	KeyCode keycode;
+	unsigned int mod;
+} KeyGrab;
+
 typedef struct {
 	const char *symbol;
 	void (*arrange)(Monitor *);
@@ -128,6 +182,9 @@ struct Monitor {
 	Client *stack;
 	Monitor *next;
 	Window barwin;
+	Bar bar;
+	int batch;            /* work deferred to flushbatch() */
+	int dirty;            /* layout inputs changed, see arrangemon() */
 	const Layout *lt[2];
 };
 
@@ -140,6 +197,33 @@ typedef struct {
 	int monitor;
 } Rule;
 
+typedef struct {
+	Fnt *fonts;
+	Clr **scheme;
+} Look; /* a theme's fonts and colors, loaded once */
+
+typedef struct { /* a client carried over restart(), as 32-bit property items */
+	long win, mon, tags, isfloating, isfullscreen;
+	long x, y, w, h, oldbw, stack;
+} Session;
+
+typedef struct {
+	KeySym keysym;
+	KeyCode keycode;
+} SymCode;
+
+typedef struct {
+	unsigned long count;
+	uint64_t sum, max;                /* in microseconds */
+	unsigned long bucket[LATBUCKETS]; /* latencies below 1 << i us */
+} Latency;
+
+typedef struct {
+	Window win;
+	Client *c;   /* NULL for bar windows */
+	Monitor *m;  /* monitor of a bar window */
+} WinEntry;
+
 /* function declarations */
 static void applyrules(Client *c);
 static int applysizehints(Client *c, int *x, int *y, int *w, int *h, int interact);
@@ -152,47 +236,77 @@ static void checkotherwm(void);
 static void cleanup(void);
 static void cleanupmon(Monitor *mon);
 static void clientmessage(XEvent *e);
+static int cmpkeygrab(const void *a, const void *b);
+static int cmpsymcode(const void *a, const void *b);
 static void configure(Client *c);
 static void configurenotify(XEvent *e);
 static void configurerequest(XEvent *e);
+static unsigned int configurewin(Client *c, int x, int y, int w, int h, int bw);
+static Look *createlooks(unsigned int *n);
 static Monitor *createmon(void);
+static void cycletheme(const Arg *arg);
 static void destroynotify(XEvent *e);
 static void detach(Client *c);
 static void detachstack(Client *c);
 static Monitor *dirtomon(int dir);
+static void dispatch(void);
 static void drawbar(Monitor *m);
 static void drawbars(void);
+static void dumplatency(void);
 static void enternotify(XEvent *e);
+static Window evwindow(XEvent *e);
 static void expose(XEvent *e);
+static void flushbatch(void);
+static int flushfontcache(void);
+static int flushstatus(void);
 static void focus(Client *c);
 static void focusin(XEvent *e);
 static void focusmon(const Arg *arg);
 static void focusstack(const Arg *arg);
+static int frametimer(Monitor *m);
+static void freelooks(Look *l, unsigned int n);
 static Atom getatomprop(Client *c, Atom prop);
 static int getrootptr(int *x, int *y);
 static long getstate(Window w);
 static int gettextprop(Window w, Atom atom, char *text, unsigned int size);
+static uint64_t gettime(void);
 static void grabbuttons(Client *c, int focused);
 static void grabkeys(void);
 static void incnmaster(const Arg *arg);
+static void ipcaccept(void);
+static void ipcanswer(IpcClient *ic);
+static void ipcclose(IpcClient *ic);
+static void ipcread(IpcClient *ic);
+static void ipcrun(IpcClient *ic, char *line);
+static void joinparse(void);
 static void keypress(XEvent *e);
 static void killclient(const Arg *arg);
-static void manage(Window w, XWindowAttributes *wa);
+static void manage(Window w, XWindowAttributes *wa, const Session *saved);
 static void mappingnotify(XEvent *e);
 static void maprequest(XEvent *e);
 static void monocle(Monitor *m);
+static int monrate(Monitor *m);
 static void motionnotify(XEvent *e);
 static void movemouse(const Arg *arg);
+static int nextevent(int timer, XEvent *ev);
 static Client *nexttiled(Client *c);
+static void *parseworker(void *unused);
 static void pop(Client *c);
 static void propertynotify(XEvent *e);
 static void quit(const Arg *arg);
+static void recordlatency(Latency *l, uint64_t start);
 static Monitor *recttomon(int x, int y, int w, int h);
+static void refit(Client *c);
+static void reloadconfig(void);
 static void resize(Client *c, int x, int y, int w, int h, int interact);
 static void resizeclient(Client *c, int x, int y, int w, int h);
 static void resizemouse(const Arg *arg);
 static void restack(Monitor *m);
+static void restart(const Arg *arg);
+static void restoresession(Window *wins, unsigned int num);
 static void run(void);
+static void runbind(void (*func)(const Arg *), const Arg *arg);
+static void savesession(void);
 static void scan(void);
 static int sendevent(Client *c, Atom proto);
 static void sendmon(Client *c, Monitor *m);
@@ -201,12 +315,18 @@ static void setfocus(Client *c);
 static void setfullscreen(Client *c, int fullscreen);
 static void setlayout(const Arg *arg);
 static void setmfact(const Arg *arg);
+static void settheme(const Arg *arg);
 static void setup(void);
+static void setupipc(void);
 static void seturgent(Client *c, int urg);
 static void showhide(Client *c);
+static void sigusr1(int unused);
 static void spawn(const Arg *arg);
+static void startparse(void);
 static void tag(const Arg *arg);
 static void tagmon(const Arg *arg);
+static int themediffers(const char **f, unsigned int nf, const char *c[][3],
+                        const char **of, unsigned int onf, const char *oc[][3]);
 static void tile(Monitor *m);
 static void togglebar(const Arg *arg);
 static void togglefloating(const Arg *arg);
@@ -217,15 +337,22 @@ static void unmanage(Client *c, int destroyed);
 static void unmapnotify(XEvent *e);
 static void updatebarpos(Monitor *m);
 static void updatebars(void);
-static void updateclientlist(void);
+static void updatebarwidths(void);
+static void updateclientlist(Window w, int mapped);
 static int updategeom(void);
+static void updatekeymap(void);
 static void updatenumlockmask(void);
 static void updatesizehints(Client *c);
 static void updatestatus(void);
 static void updatetitle(Client *c);
 static void updatewindowtype(Client *c);
 static void updatewmhints(Client *c);
+static void uselook(unsigned int i);
 static void view(const Arg *arg);
+static void wininsert(Window w, Client *c, Monitor *m);
+static WinEntry *winlookup(Window w);
+static void winremove(Window w);
+static size_t winslot(Window w);
 static Client *wintoclient(Window w);
 static Monitor *wintomon(Window w);
 static int xerror(Display *dpy, XErrorEvent *ee);
@@ -234,14 +361,34 @@ static int xerrorstart(Display *dpy, XErrorEvent *ee);
 static void zoom(const Arg *arg);
 
 /* variables */
+extern char **environ;
 static const char broken[] = "broken";
 static char stext[256];
 static int screen;
 static int sw, sh;           /* X display screen geometry width, height */
 static int bh;               /* bar height */
 static int lrpad;            /* sum of left and right padding for text */
+static int statuspending;    /* status changed but was not redrawn yet */
+static int ipcstatus;        /* stext came from ipcsocket, not the root name */
+static int ipcfd = -1;       /* listening on ipcsocket, see setupipc() */
+static char *ipcpath;        /* where ipcfd is bound, removed by cleanup() */
+static IpcClient ipcclients[IPCCLIENTS];
+static pthread_t parsethread;
+static int parsing;          /* parse_config() runs on parsethread */
+static int sigpipe[2] = { -1, -1 }; /* SIGUSR1 wakes run() through it, see sigusr1() */
+static int batching;         /* defer arrange(), restack() and drawbar() */
+static XEvent *batchevs;     /* events of the batch dispatch() handles */
+static size_t batchevssz;
+static Window *clientlist;   /* _NET_CLIENT_LIST, in mapping order */
+static size_t nclientlist, clientlistsz;
+static long laststatus;      /* when the status was last redrawn, in ms */
+static long fontcachedue;    /* when flushfontcache() saves new matches, in ms */
 static int (*xerrorxlib)(Display *, XErrorEvent *);
 static unsigned int numlockmask = 0;
+static SymCode *symcodes;    /* keyboard mapping sorted by keysym */
+static size_t nsymcodes;
+static KeyGrab *keygrabs;    /* key grabs held on root, sorted */
+static size_t nkeygrabs;
 static void (*handler[LASTEvent]) (XEvent *) = {
 	[ButtonPress] = buttonpress,
 	[ClientMessage] = clientmessage,
@@ -258,14 +405,35 @@ static void (*handler[LASTEvent]) (XEvent *) = {
 	[PropertyNotify] = propertynotify,
 	[UnmapNotify] = unmapnotify
 };
+static const char *handlername[LASTEvent] = {
+	[ButtonPress] = "buttonpress",
+	[ClientMessage] = "clientmessage",
+	[ConfigureRequest] = "configurerequest",
+	[ConfigureNotify] = "configurenotify",
+	[DestroyNotify] = "destroynotify",
+	[EnterNotify] = "enternotify",
+	[Expose] = "expose",
+	[FocusIn] = "focusin",
+	[KeyPress] = "keypress",
+	[MappingNotify] = "mappingnotify",
+	[MapRequest] = "maprequest",
+	[MotionNotify] = "motionnotify",
+	[PropertyNotify] = "propertynotify",
+	[UnmapNotify] = "unmapnotify"
+};
 static Atom wmatom[WMLast], netatom[NetLast];
 static int running = 1;
+static int restarting;       /* exec dwm again once run() returns */
 static Cur *cursor[CurLast];
-static Clr **scheme;
+static Clr **scheme;         /* colors of the look in use */
+static Look *looks;          /* one per theme, see createlooks() */
+static unsigned int nlooks, sellook;
 static Display *dpy;
 static Drw *drw;
 static Monitor *mons, *selmon;
 static Window root, wmcheckwin;
+static WinEntry *wintable;   /* open addressed, Window -> client or bar */
+static size_t wintablesz, nwins;
 
 /* configuration, allows nested code to access above variables */
 #include "config.h"
@@ -273,9 +441,27 @@ static Window root, wmcheckwin;
 /* compile-time check if all tags fit into an unsigned int bit array. */
 struct NumTags { char limitexceeded[LENGTH(tags) > 31 ? -1 : 1]; };
 
+static unsigned int tagw[LENGTH(tags)]; /* TEXTW() of each tag, see updatebarwidths() */
+
+/* the parser runs on its own thread at startup, see joinparse() */
+#define SET_STATUS_TEXT(...) \
+	do { \
+		snprintf(stext, sizeof(stext), "" __VA_ARGS__); \
+		if (!parsing) { \
+			XStoreName(dpy, root, stext); \
+			XSync(dpy, False); \
+		} \
+	} while (0)
+
 /* parser, allows for parsing dwm.conf at runtime */
 #include "parser.c"
 
+/* latency of every handler[] and bound function call, the last entry of
+ * funclatency is for functions FUNCTION_ALIAS_MAP has no alias for */
+static Latency eventlatency[LASTEvent];
+static Latency funclatency[LENGTH(FUNCTION_ALIAS_MAP) + 1];
+static Latency flushlatency; /* flushbatch() calls that had work deferred to them */
+
 /* function implementations */
 void
 applyrules(Client *c)
@@ -293,18 +479,13 @@ applyrules(Client *c)
 	class    = ch.res_class ? ch.res_class : broken;
 	instance = ch.res_name  ? ch.res_name  : broken;
 
-	for (i = 0; i < rules_count; i++) {
+	for (i = first_rule(class, instance, c->name); i < rules_count; i = next_rule(i)) {
 		r = &rules[i];
-		if ((!r->title || strstr(c->name, r->title))
-		&& (!r->class || strstr(class, r->class))
-		&& (!r->instance || strstr(instance, r->instance)))
-		{
-			c->isfloating = r->isfloating;
-			c->tags |= r->tags;
-			for (m = mons; m && m->num != r->monitor; m = m->next);
-			if (m)
-				c->mon = m;
-		}
+		c->isfloating = r->isfloating;
+		c->tags |= r->tags;
+		for (m = mons; m && m->num != r->monitor; m = m->next);
+		if (m)
+			c->mon = m;
 	}
 	if (ch.res_class)
 		XFree(ch.res_class);
@@ -384,6 +565,13 @@ applysizehints(Client *c, int *x, int *y, int *w, int *h, int interact)
 void
 arrange(Monitor *m)
 {
+	if (batching) {
+		if (m)
+			m->batch |= BatchArrange|BatchRestack;
+		else for (m = mons; m; m = m->next)
+			m->batch |= BatchArrange;
+		return;
+	}
 	if (m)
 		showhide(m->stack);
 	else for (m = mons; m; m = m->next)
@@ -391,13 +579,20 @@ arrange(Monitor *m)
 	if (m) {
 		arrangemon(m);
 		restack(m);
-	} else for (m = mons; m; m = m->next)
-		arrangemon(m);
+	} else {
+		for (m = mons; m; m = m->next)
+			arrangemon(m);
+		XSync(dpy, False);
+	}
 }
 
+/* lays m out again if anything the layout depends on changed since */
 void
 arrangemon(Monitor *m)
 {
+	if (!m->dirty)
+		return;
+	m->dirty = 0;
 	strncpy(m->ltsymbol, m->lt[m->sellt]->symbol, sizeof m->ltsymbol);
 	if (m->lt[m->sellt]->arrange)
 		m->lt[m->sellt]->arrange(m);
@@ -408,6 +603,7 @@ attach(Client *c)
 {
 	c->next = c->mon->clients;
 	c->mon->clients = c;
+	refit(c);
 }
 
 void
@@ -436,7 +632,7 @@ buttonpress(XEvent *e)
 	if (ev->window == selmon->barwin) {
 		i = x = 0;
 		do
-			x += TEXTW(tags[i]);
+			x += tagw[i];
 		while (ev->x >= x && ++i < LENGTH(tags));
 		if (i < LENGTH(tags)) {
 			click = ClkTagBar;
@@ -453,10 +649,10 @@ buttonpress(XEvent *e)
 		XAllowEvents(dpy, ReplayPointer, CurrentTime);
 		click = ClkClientWin;
 	}
-	for (i = 0; i < buttons_count; i++)
-		if (click == buttons[i].click && buttons[i].func && buttons[i].button == ev->button
-		&& CLEANMASK(buttons[i].mask) == CLEANMASK(ev->state))
-			buttons[i].func(click == ClkTagBar && buttons[i].arg.i == 0 ? &arg : &buttons[i].arg);
+	for (i = first_buttonbind(click, ev->button, ev->state); i < buttons_count;
+	     i = next_buttonbind(i, click, ev->button, ev->state))
+		if (buttons[i].func)
+			runbind(buttons[i].func, click == ClkTagBar && buttons[i].arg.i == 0 ? &arg : &buttons[i].arg);
 }
 
 void
@@ -477,6 +673,7 @@ cleanup(void)
 	Layout foo = { "", NULL };
 	Monitor *m;
 	size_t i;
+	char *path;
 
 	view(&a);
 	selmon->lt[selmon->sellt] = &foo;
@@ -484,15 +681,38 @@ cleanup(void)
 		while (m->stack)
 			unmanage(m->stack, 0);
 	XUngrabKey(dpy, AnyKey, AnyModifier, root);
+	free(keygrabs);
+	keygrabs = NULL;
+	nkeygrabs = 0;
+	free(symcodes);
+	symcodes = NULL;
+	nsymcodes = 0;
 	while (mons)
 		cleanupmon(mons);
+	free(wintable);
+	wintable = NULL;
+	wintablesz = nwins = 0;
 	for (i = 0; i < CurLast; i++)
 		drw_cur_free(drw, cursor[i]);
-	for (i = 0; i < LENGTH(colors); i++)
-		drw_scm_free(drw, scheme[i], 3);
-	free(scheme);
+	freelooks(looks, nlooks);
+	drw_setfontset(drw, NULL); /* freed along with the looks */
+	free(batchevs);
+	free(clientlist);
+	for (i = 0; i < LENGTH(ipcclients); i++)
+		ipcclose(&ipcclients[i]);
+	if (ipcfd != -1) {
+		close(ipcfd);
+		unlink(ipcpath);
+		free(ipcpath);
+	}
+	close(sigpipe[0]);
+	close(sigpipe[1]);
 	config_cleanup();
 	XDestroyWindow(dpy, wmcheckwin);
+	if (drw->matcheschanged && (path = get_data_filepath(FONTCACHE, 1))) {
+		drw_fontcache_save(drw, path);
+		free(path);
+	}
 	drw_free(drw);
 	XSync(dpy, False);
 	XSetInputFocus(dpy, PointerRoot, RevertToPointerRoot, CurrentTime);
@@ -510,6 +730,7 @@ cleanupmon(Monitor *mon)
 		for (m = mons; m && m->next != mon; m = m->next);
 		m->next = mon->next;
 	}
+	winremove(mon->barwin);
 	XUnmapWindow(dpy, mon->barwin);
 	XDestroyWindow(dpy, mon->barwin);
 	free(mon);
@@ -534,6 +755,26 @@ clientmessage(XEvent *e)
 	}
 }
 
+int
+cmpkeygrab(const void *a, const void *b)
+{
+	const KeyGrab *ga = a, *gb = b;
+
+	if (ga->keycode != gb->keycode)
+		return ga->keycode < gb->keycode ? -1 : 1;
+	return ga->mod < gb->mod ? -1 : ga->mod > gb->mod;
+}
+
+int
+cmpsymcode(const void *a, const void *b)
+{
+	const SymCode *sa = a, *sb = b;
+
+	if (sa->keysym != sb->keysym)
+		return sa->keysym < sb->keysym ? -1 : 1;
+	return sa->keycode < sb->keycode ? -1 : sa->keycode > sb->keycode;
+}
+
 void
 configure(Client *c)
 {
@@ -590,9 +831,10 @@ configurerequest(XEvent *e)
 	XWindowChanges wc;
 
 	if ((c = wintoclient(ev->window))) {
-		if (ev->value_mask & CWBorderWidth)
+		if (ev->value_mask & CWBorderWidth) {
 			c->bw = ev->border_width;
-		else if (c->isfloating || !selmon->lt[selmon->sellt]->arrange) {
+			refit(c);
+		} else if (c->isfloating || !selmon->lt[selmon->sellt]->arrange) {
 			m = c->mon;
 			if (ev->value_mask & CWX) {
 				c->oldx = c->x;
@@ -616,8 +858,8 @@ configurerequest(XEvent *e)
 				c->y = m->my + (m->mh / 2 - HEIGHT(c) / 2); /* center in y direction */
 			if ((ev->value_mask & (CWX|CWY)) && !(ev->value_mask & (CWWidth|CWHeight)))
 				configure(c);
-			if (ISVISIBLE(c))
-				XMoveResizeWindow(dpy, c->win, c->x, c->y, c->w, c->h);
+			if (ISVISIBLE(c) && !configurewin(c, c->x, c->y, c->w, c->h, c->cfgbw))
+				configure(c); /* nothing changes, still answer the request */
 		} else
 			configure(c);
 	} else {
@@ -633,6 +875,82 @@ configurerequest(XEvent *e)
 	XSync(dpy, False);
 }
 
+/* sends only the parts of the geometry that differ from what the server
+ * already has, returns the CW* mask of them */
+unsigned int
+configurewin(Client *c, int x, int y, int w, int h, int bw)
+{
+	unsigned int mask = 0;
+	XWindowChanges wc;
+
+	if (x != c->cfgx)
+		mask |= CWX;
+	if (y != c->cfgy)
+		mask |= CWY;
+	if (w != c->cfgw)
+		mask |= CWWidth;
+	if (h != c->cfgh)
+		mask |= CWHeight;
+	if (bw != c->cfgbw)
+		mask |= CWBorderWidth;
+	if (!mask)
+		return 0;
+	c->cfgx = wc.x = x;
+	c->cfgy = wc.y = y;
+	c->cfgw = wc.width = w;
+	c->cfgh = wc.height = h;
+	c->cfgbw = wc.border_width = bw;
+	XConfigureWindow(dpy, c->win, mask, &wc);
+	return mask;
+}
+
+/* loads the fonts and colors of every theme up front, so switching between
+ * them allocates nothing. a theme that cannot be loaded is skipped, leaving
+ * its look without fonts. returns NULL if the first one cannot be loaded */
+Look *
+createlooks(unsigned int *n)
+{
+	Look *l;
+	Fnt *cur = drw->fonts;
+	XftColor clr;
+	const char **f = fonts, *(*c)[3] = colors;
+	unsigned int i, j, k, nf = fonts_count, nt = MAX(themes_count, 1);
+	int ok;
+
+	l = ecalloc(nt, sizeof(Look));
+	for (i = 0; i < nt; i++) {
+		if (themes_count) {
+			f = themes[i].fonts;
+			nf = themes[i].fonts_count;
+			c = themes[i].colors;
+		}
+		/* check every color first, drw_scm_create() dies on one it cannot allocate */
+		for (ok = 1, j = 0; ok && j < LENGTH(colors); j++)
+			for (k = 0; ok && k < 3; k++) {
+				if ((ok = XftColorAllocName(dpy, DefaultVisual(dpy, screen),
+				                            DefaultColormap(dpy, screen), c[j][k], &clr)))
+					XftColorFree(dpy, DefaultVisual(dpy, screen), DefaultColormap(dpy, screen), &clr);
+				else
+					fprintf(stderr, "dwm: skipping theme %u, cannot allocate color '%s'\n", i + 1, c[j][k]);
+			}
+		if (ok && !(l[i].fonts = drw_fontset_create(drw, f, nf)))
+			fprintf(stderr, "dwm: skipping theme %u, no fonts could be loaded\n", i + 1);
+		if (!l[i].fonts) {
+			if (i > 0)
+				continue;
+			free(l);
+			drw_setfontset(drw, cur);
+			return NULL;
+		}
+		l[i].scheme = ecalloc(LENGTH(colors), sizeof(Clr *));
+		for (j = 0; j < LENGTH(colors); j++)
+			l[i].scheme[j] = drw_scm_create(drw, c[j], 3);
+	}
+	drw_setfontset(drw, cur); /* drw_fontset_create() made the last set current */
+	*n = nt;
+	return l;
+}
+
 Monitor *
 createmon(void)
 {
@@ -640,6 +958,7 @@ createmon(void)
 
 	m = ecalloc(1, sizeof(Monitor));
 	m->tagset[0] = m->tagset[1] = 1;
+	m->dirty = 1;
 	m->mfact = mfact;
 	m->nmaster = nmaster;
 	m->showbar = showbar;
@@ -650,6 +969,20 @@ createmon(void)
 	return m;
 }
 
+void
+cycletheme(const Arg *arg)
+{
+	Arg a = { .ui = sellook };
+	unsigned int i;
+
+	for (i = 0; i < nlooks; i++) { /* past the themes that were skipped */
+		a.ui = ((int)a.ui + arg->i % (int)nlooks + (int)nlooks) % (int)nlooks;
+		if (looks[a.ui].fonts)
+			break;
+	}
+	settheme(&a);
+}
+
 void
 destroynotify(XEvent *e)
 {
@@ -667,6 +1000,7 @@ detach(Client *c)
 
 	for (tc = &c->mon->clients; *tc && *tc != c; tc = &(*tc)->next);
 	*tc = c->next;
+	c->mon->dirty = 1;
 }
 
 void
@@ -698,23 +1032,105 @@ dirtomon(int dir)
 	return m;
 }
 
+/* handles the events Xlib has queued, up to the next key or button press,
+ * deferring arrange(), restack() and drawbar() to the end of the batch */
+void
+dispatch(void)
+{
+	size_t i, j, n = 0;
+	int type;
+	uint64_t start;
+	Monitor *m;
+	Window w;
+	XConfigureRequestEvent *a, *b;
+
+	do {
+		if (n == batchevssz) {
+			batchevssz = batchevssz ? batchevssz * 2 : 64;
+			if (!(batchevs = realloc(batchevs, batchevssz * sizeof(XEvent))))
+				die("realloc:");
+		}
+		XNextEvent(dpy, &batchevs[n]);
+		type = batchevs[n++].type;
+	} while (type != KeyPress && type != ButtonPress && XPending(dpy));
+
+	/* drop events superseded by the next event for the same window */
+	for (i = 0; i < n; i++) {
+		type = batchevs[i].type;
+		if (type != ConfigureRequest && type != Expose && type != PropertyNotify)
+			continue;
+		w = evwindow(&batchevs[i]);
+		for (j = i + 1; j < n && evwindow(&batchevs[j]) != w; j++)
+			; /* NOP */
+		if (j == n || batchevs[j].type != type || (type == PropertyNotify
+		&& (batchevs[j].xproperty.atom != batchevs[i].xproperty.atom
+		|| batchevs[j].xproperty.state != batchevs[i].xproperty.state)))
+			continue;
+		if (type == ConfigureRequest) {
+			a = &batchevs[i].xconfigurerequest;
+			b = &batchevs[j].xconfigurerequest;
+			if (a->value_mask & ~b->value_mask & CWX)
+				b->x = a->x;
+			if (a->value_mask & ~b->value_mask & CWY)
+				b->y = a->y;
+			if (a->value_mask & ~b->value_mask & CWWidth)
+				b->width = a->width;
+			if (a->value_mask & ~b->value_mask & CWHeight)
+				b->height = a->height;
+			if (a->value_mask & ~b->value_mask & CWBorderWidth)
+				b->border_width = a->border_width;
+			if (a->value_mask & ~b->value_mask & CWSibling)
+				b->above = a->above;
+			if (a->value_mask & ~b->value_mask & CWStackMode)
+				b->detail = a->detail;
+			b->value_mask |= a->value_mask;
+		} else if (type == Expose && !batchevs[i].xexpose.count) {
+			batchevs[j].xexpose.count = 0;
+		}
+		batchevs[i].type = 0; /* no handler */
+	}
+
+	for (i = 0; i < n && running; i++) {
+		type = batchevs[i].type;
+		if (type == KeyPress || type == ButtonPress) {
+			/* bindings may grab the pointer and wait for events */
+			flushbatch();
+		} else if (type == EnterNotify) {
+			/* a pending restack() discards crossing events */
+			for (m = mons; m && !(m->batch & BatchRestack); m = m->next)
+				; /* NOP */
+			if (m)
+				continue;
+		}
+		if (handler[type]) {
+			batching = type != KeyPress && type != ButtonPress;
+			start = gettime();
+			handler[type](&batchevs[i]); /* call handler */
+			recordlatency(&eventlatency[type], start);
+			batching = 0;
+		}
+	}
+	flushbatch();
+}
+
 void
 drawbar(Monitor *m)
 {
-	int x, w, tw = 0;
+	int x, w, tw = 0, title = 0, status;
 	int boxs = drw->fonts->h / 9;
 	int boxw = drw->fonts->h / 6 + 2;
-	unsigned int i, occ = 0, urg = 0;
+	int dx[LENGTH(tags) + 3], dw[LENGTH(tags) + 3], nd = 0; /* damage */
+	unsigned int i, occ = 0, urg = 0, filled = 0, seltags = m->tagset[m->seltags];
+	Bar *b = &m->bar;
 	Client *c;
 
-	if (!m->showbar)
+	if (batching) {
+		m->batch |= BatchBar;
+		return;
+	}
+	if (!m->showbar) {
+		b->valid = 0;
 		return;
-
-	/* draw status first so it can be overdrawn by tags later */
-	if (m == selmon) { /* status is only drawn on selected monitor */
-		drw_setscheme(drw, scheme[SchemeNorm]);
-		tw = TEXTW(stext) - lrpad + 2; /* 2px right padding */
-		drw_text(drw, m->ww - tw, 0, tw, bh, 0, stext, 0);
 	}
 
 	for (c = m->clients; c; c = c->next) {
@@ -722,33 +1138,95 @@ drawbar(Monitor *m)
 		if (c->isurgent)
 			urg |= c->tags;
 	}
+	if (m == selmon && selmon->sel)
+		filled = selmon->sel->tags;
+	if (m == selmon) /* status is only drawn on selected monitor */
+		tw = TEXTW(stext) - lrpad + 2; /* 2px right padding */
+	x = TEXTW(m->ltsymbol);
+	for (i = 0; i < LENGTH(tags); i++)
+		x += tagw[i];
+	/* segments only redraw on their own while they don't overlap */
+	if (b->ww != m->ww || x > m->ww - tw)
+		b->valid = 0;
+
+	/* draw status first so it can be overdrawn by tags later */
+	if ((status = !b->valid || tw != b->tw || (tw && strcmp(stext, b->stext)))) {
+		if (tw) {
+			drw_setscheme(drw, scheme[SchemeNorm]);
+			drw_text(drw, m->ww - tw, 0, tw, bh, 0, stext, 0);
+		}
+		strcpy(b->stext, stext);
+	}
+
 	x = 0;
-	for (i = 0; i < LENGTH(tags); i++) {
-		w = TEXTW(tags[i]);
-		drw_setscheme(drw, scheme[m->tagset[m->seltags] & 1 << i ? SchemeSel : SchemeNorm]);
+	for (i = 0; i < LENGTH(tags); i++, x += w) {
+		w = tagw[i];
+		if (b->valid && !(((seltags ^ b->seltags) | (occ ^ b->occ)
+		    | (urg ^ b->urg) | (filled ^ b->filled)) & 1 << i))
+			continue;
+		drw_setscheme(drw, scheme[seltags & 1 << i ? SchemeSel : SchemeNorm]);
 		drw_text(drw, x, 0, w, bh, lrpad / 2, tags[i], urg & 1 << i);
 		if (occ & 1 << i)
-			drw_rect(drw, x + boxs, boxs, boxw, boxw,
-				m == selmon && selmon->sel && selmon->sel->tags & 1 << i,
-				urg & 1 << i);
-		x += w;
+			drw_rect(drw, x + boxs, boxs, boxw, boxw, filled & 1 << i, urg & 1 << i);
+		if (nd && dx[nd - 1] + dw[nd - 1] == x)
+			dw[nd - 1] += w;
+		else
+			dx[nd] = x, dw[nd++] = w;
 	}
 	w = TEXTW(m->ltsymbol);
-	drw_setscheme(drw, scheme[SchemeNorm]);
-	x = drw_text(drw, x, 0, w, bh, lrpad / 2, m->ltsymbol, 0);
-
-	if ((w = m->ww - tw - x) > bh) {
-		if (m->sel) {
+	if (!b->valid || strcmp(m->ltsymbol, b->ltsymbol)) {
+		drw_setscheme(drw, scheme[SchemeNorm]);
+		drw_text(drw, x, 0, w, bh, lrpad / 2, m->ltsymbol, 0);
+		strcpy(b->ltsymbol, m->ltsymbol);
+		if (nd && dx[nd - 1] + dw[nd - 1] == x)
+			dw[nd - 1] += w;
+		else
+			dx[nd] = x, dw[nd++] = w;
+	}
+	x += w;
+
+	if ((w = m->ww - tw - x) > bh)
+		title = !m->sel ? 1 : 2 | (m == selmon) << 2
+			| m->sel->isfloating << 3 | m->sel->isfixed << 4;
+	/* without room for a title, the gap left of the status is still cleared */
+	if (w > 0 && (!b->valid || title != b->title || x != b->tx || tw != b->tw
+	    || (title && m->sel && strcmp(m->sel->name, b->name)))) {
+		if (title && m->sel) {
 			drw_setscheme(drw, scheme[m == selmon ? SchemeSel : SchemeNorm]);
 			drw_text(drw, x, 0, w, bh, lrpad / 2, m->sel->name, 0);
 			if (m->sel->isfloating)
 				drw_rect(drw, x + boxs, boxs, boxw, boxw, m->sel->isfixed, 0);
+			strcpy(b->name, m->sel->name);
 		} else {
 			drw_setscheme(drw, scheme[SchemeNorm]);
 			drw_rect(drw, x, 0, w, bh, 1, 1);
 		}
+		if (nd && dx[nd - 1] + dw[nd - 1] == x)
+			dw[nd - 1] += w;
+		else
+			dx[nd] = x, dw[nd++] = w;
+	}
+	if (status && tw) {
+		if (nd && dx[nd - 1] + dw[nd - 1] == m->ww - tw)
+			dw[nd - 1] += tw;
+		else
+			dx[nd] = m->ww - tw, dw[nd++] = tw;
 	}
-	drw_map(drw, m->barwin, 0, 0, m->ww, bh);
+
+	/* the drawable is shared by all bars, so only copy what was drawn */
+	for (i = 0; i < nd; i++)
+		drw_copy(drw, m->barwin, dx[i], 0, dw[i], bh);
+	if (nd)
+		XSync(dpy, False);
+	b->valid = 1;
+	b->ww = m->ww;
+	b->tw = tw;
+	b->seltags = seltags;
+	b->occ = occ;
+	b->urg = urg;
+	b->filled = filled;
+	b->tx = x;
+	b->title = title;
 }
 
 void
@@ -760,6 +1238,44 @@ drawbars(void)
 		drawbar(m);
 }
 
+/* writes the latency histograms of every handler and function called so far,
+ * and of the batched work flushbatch() did after them, to stderr, requested
+ * with SIGUSR1 */
+void
+dumplatency(void)
+{
+	unsigned int i, j;
+	const char *name;
+	char buf[64];
+	Latency *l;
+
+	while (read(sigpipe[0], buf, sizeof(buf)) > 0)
+		; /* NOP, one dump answers every signal so far */
+	fputs("dwm: latency: name count avg max, then count below each time\n", stderr);
+	for (i = 0; i <= LENGTH(eventlatency) + LENGTH(funclatency); i++) {
+		if (i < LENGTH(eventlatency)) {
+			l = &eventlatency[i];
+			name = handlername[i];
+		} else if (i == LENGTH(eventlatency) + LENGTH(funclatency)) {
+			l = &flushlatency;
+			name = "flushbatch";
+		} else {
+			l = &funclatency[i - LENGTH(eventlatency)];
+			name = i - LENGTH(eventlatency) < LENGTH(FUNCTION_ALIAS_MAP)
+				? FUNCTION_ALIAS_MAP[i - LENGTH(eventlatency)].alias : "other";
+		}
+		if (!l->count)
+			continue;
+		fprintf(stderr, "dwm: latency: %s %lu %lluus %lluus", name, l->count,
+		        (unsigned long long)(l->sum / l->count), (unsigned long long)l->max);
+		for (j = 0; j < LATBUCKETS; j++)
+			if (l->bucket[j])
+				fprintf(stderr, " <%luus:%lu", 1UL << j, l->bucket[j]);
+		fputc('\n', stderr);
+	}
+	fflush(stderr);
+}
+
 void
 enternotify(XEvent *e)
 {
@@ -779,14 +1295,106 @@ enternotify(XEvent *e)
 	focus(c);
 }
 
+/* returns the window an event is about, rather than the one it was sent to */
+Window
+evwindow(XEvent *e)
+{
+	switch (e->type) {
+	case ConfigureRequest: return e->xconfigurerequest.window;
+	case ConfigureNotify: return e->xconfigure.window;
+	case DestroyNotify: return e->xdestroywindow.window;
+	case MapRequest: return e->xmaprequest.window;
+	case UnmapNotify: return e->xunmap.window;
+	}
+	return e->xany.window;
+}
+
 void
 expose(XEvent *e)
 {
 	Monitor *m;
 	XExposeEvent *ev = &e->xexpose;
 
-	if (ev->count == 0 && (m = wintomon(ev->window)))
+	if (ev->count == 0 && (m = wintomon(ev->window))) {
+		m->bar.valid = 0;
 		drawbar(m);
+	}
+}
+
+/* runs the arrange(), restack() and drawbar() calls deferred by dispatch(),
+ * once per monitor */
+void
+flushbatch(void)
+{
+	int batch, sync = 0;
+	uint64_t start = gettime();
+	Monitor *m;
+
+	for (m = mons; m && !m->batch; m = m->next)
+		; /* NOP */
+	if (!m)
+		return;
+	for (m = mons; m; m = m->next)
+		if (m->batch & BatchArrange)
+			showhide(m->stack);
+	for (m = mons; m; m = m->next)
+		if (m->batch & BatchArrange)
+			arrangemon(m);
+	for (m = mons; m; m = m->next) {
+		batch = m->batch;
+		m->batch = 0;
+		if (batch & BatchRestack)
+			restack(m);
+		else {
+			if (batch & BatchBar)
+				drawbar(m);
+			sync |= batch & BatchArrange;
+		}
+	}
+	if (sync) /* restack() syncs the others */
+		XSync(dpy, False);
+	recordlatency(&flushlatency, start);
+}
+
+/* saves the fonts fontconfig matched for new glyphs a while after they were
+ * first drawn, as dwm rarely exits cleanly enough for cleanup() to, returns
+ * the poll() timeout until then or -1 when nothing is to be saved */
+int
+flushfontcache(void)
+{
+	long now = gettime() / 1000;
+	char *path;
+
+	if (!drw->matcheschanged)
+		return -1;
+	if (!fontcachedue)
+		fontcachedue = now + FONTCACHEDELAY;
+	if (fontcachedue > now)
+		return fontcachedue - now;
+	fontcachedue = 0;
+	if ((path = get_data_filepath(FONTCACHE, 1))) {
+		drw_fontcache_save(drw, path);
+		free(path);
+	}
+	drw->matcheschanged = 0; /* even if saving failed, instead of retrying */
+	return -1;
+}
+
+/* redraws a pending status change once statusrate allows it, returns the
+ * poll() timeout until then, 0 once redrawn or -1 when nothing is pending */
+int
+flushstatus(void)
+{
+	long wait = 0;
+
+	if (!statuspending)
+		return -1;
+	if (statusrate)
+		wait = laststatus + 1000 / statusrate - (long)(gettime() / 1000);
+	if (wait > 0)
+		return wait;
+	updatestatus();
+	return 0;
 }
 
 void
@@ -864,6 +1472,51 @@ focusstack(const Arg *arg)
 	}
 }
 
+/* returns a timerfd expiring at the refresh rate of m, or -1 to apply every
+ * pointer motion right away while moving or resizing, throttled by motion
+ * time where there is no timerfd */
+int
+frametimer(Monitor *m)
+{
+#ifdef __linux__
+	struct itimerspec its = {0};
+	long ns;
+	int fd, rate;
+
+	if (!(rate = monrate(m)))
+		rate = refreshrate;
+	if (rate <= 0 || (fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK|TFD_CLOEXEC)) == -1)
+		return -1;
+	ns = 1000000000L / rate;
+	its.it_interval.tv_sec = ns / 1000000000L;
+	its.it_interval.tv_nsec = ns % 1000000000L;
+	its.it_value = its.it_interval;
+	if (timerfd_settime(fd, 0, &its, NULL) == -1) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+#else
+	return -1;
+#endif /* __linux__ */
+}
+
+void
+freelooks(Look *l, unsigned int n)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		if (!l[i].fonts) /* skipped by createlooks() */
+			continue;
+		drw_fontset_free(l[i].fonts);
+		for (j = 0; j < LENGTH(colors); j++)
+			drw_scm_free(drw, l[i].scheme[j], 3);
+		free(l[i].scheme);
+	}
+	free(l);
+}
+
 Atom
 getatomprop(Client *c, Atom prop)
 {
@@ -932,6 +1585,16 @@ gettextprop(Window w, Atom atom, char *text, unsigned int size)
 	return 1;
 }
 
+/* returns the monotonic clock in microseconds */
+uint64_t
+gettime(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 void
 grabbuttons(Client *c, int focused)
 {
@@ -958,26 +1621,55 @@ grabkeys(void)
 {
 	updatenumlockmask();
 	{
-		unsigned int i, j, k;
-		unsigned int modifiers[] = { 0, LockMask, numlockmask, numlockmask|LockMask };
-		int start, end, skip;
-		KeySym *syms;
-
-		XUngrabKey(dpy, AnyKey, AnyModifier, root);
-		XDisplayKeycodes(dpy, &start, &end);
-		syms = XGetKeyboardMapping(dpy, start, end - start + 1, &skip);
-		if (!syms)
-			return;
-		for (k = start; k <= end; k++)
-			for (i = 0; i < keys_count; i++)
-				/* skip modifier codes, we do that ourselves */
-				if (keys[i].keysym == syms[(k - start) * skip])
-					for (j = 0; j < LENGTH(modifiers); j++)
-						XGrabKey(dpy, k,
-							 keys[i].mod | modifiers[j],
-							 root, True,
-							 GrabModeAsync, GrabModeAsync);
-		XFree(syms);
+		unsigned int i, j, modifiers[] = { 0, LockMask, numlockmask, numlockmask|LockMask };
+		size_t k, l, lo, hi, n = 0;
+		int c;
+		KeyGrab *grabs;
+
+		if (!symcodes)
+			updatekeymap();
+		/* the grab set wanted, 4 entries per keycode bound to each key */
+		for (l = 0; l < 2; l++) {
+			grabs = l ? ecalloc(MAX(n, 1), sizeof(KeyGrab)) : NULL;
+			for (i = 0, n = 0; i < keys_count; i++) {
+				for (lo = 0, hi = nsymcodes; lo < hi;)
+					if (symcodes[(lo + hi) / 2].keysym < keys[i].keysym)
+						lo = (lo + hi) / 2 + 1;
+					else
+						hi = (lo + hi) / 2;
+				for (k = lo; k < nsymcodes && symcodes[k].keysym == keys[i].keysym; k++)
+					for (j = 0; j < LENGTH(modifiers); j++, n++)
+						if (grabs) {
+							grabs[n].keycode = symcodes[k].keycode;
+							grabs[n].mod = keys[i].mod | modifiers[j];
+						}
+			}
+		}
+		qsort(grabs, n, sizeof(KeyGrab), cmpkeygrab);
+		for (k = l = 0; k < n; k++)
+			if (!l || cmpkeygrab(&grabs[l - 1], &grabs[k]))
+				grabs[l++] = grabs[k];
+		n = l;
+		/* only send the difference to the grabs already held */
+		if (!nkeygrabs)
+			XUngrabKey(dpy, AnyKey, AnyModifier, root);
+		for (k = l = 0; k < nkeygrabs || l < n;) {
+			c = k == nkeygrabs ? 1 : l == n ? -1 : cmpkeygrab(&keygrabs[k], &grabs[l]);
+			if (c < 0) {
+				XUngrabKey(dpy, keygrabs[k].keycode, keygrabs[k].mod, root);
+				k++;
+			} else if (c > 0) {
+				XGrabKey(dpy, grabs[l].keycode, grabs[l].mod, root, True,
+					 GrabModeAsync, GrabModeAsync);
+				l++;
+			} else {
+				k++;
+				l++;
+			}
+		}
+		free(keygrabs);
+		keygrabs = grabs;
+		nkeygrabs = n;
 	}
 }
 
@@ -985,9 +1677,147 @@ void
 incnmaster(const Arg *arg)
 {
 	selmon->nmaster = MAX(selmon->nmaster + arg->i, 0);
+	selmon->dirty = 1;
 	arrange(selmon);
 }
 
+void
+ipcaccept(void)
+{
+#ifdef __linux__
+	struct ucred cred;
+	socklen_t len = sizeof(cred);
+#else
+	uid_t uid;
+	gid_t gid;
+#endif /* __linux__ */
+	int fd;
+	size_t i;
+
+	if ((fd = accept(ipcfd, NULL, NULL)) == -1)
+		return;
+#ifdef __linux__
+	if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == -1 || cred.uid != getuid()) {
+#else
+	if (getpeereid(fd, &uid, &gid) == -1 || uid != getuid()) {
+#endif /* __linux__ */
+		close(fd); /* commands run as this user, so only they may send them */
+		return;
+	}
+	for (i = 0; i < LENGTH(ipcclients) && ipcclients[i].fd != -1; i++)
+		; /* NOP */
+	if (i == LENGTH(ipcclients)) {
+		close(fd); /* too many connections, the client reads EOF */
+		return;
+	}
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+	ipcclients[i].fd = fd;
+	ipcclients[i].oks = 0;
+	ipcclients[i].len = 0;
+}
+
+/* answers the commands that ran with "ok", once flushbatch() did the work
+ * they deferred, so a client knows they are done */
+void
+ipcanswer(IpcClient *ic)
+{
+	for (; ic->oks; ic->oks--)
+		send(ic->fd, "ok\n", 3, MSG_NOSIGNAL|MSG_DONTWAIT);
+}
+
+void
+ipcclose(IpcClient *ic)
+{
+	if (ic->fd == -1)
+		return;
+	close(ic->fd);
+	ic->fd = -1;
+	ic->oks = 0;
+	ic->len = 0;
+}
+
+/* runs every complete line the client sent, and what is left of
+ * the last one once it hangs up */
+void
+ipcread(IpcClient *ic)
+{
+	char *line, *end;
+	ssize_t n;
+
+	n = read(ic->fd, ic->buf + ic->len, sizeof(ic->buf) - 1 - ic->len);
+	if (n == -1 && (errno == EINTR || errno == EAGAIN))
+		return;
+	if (n <= 0) {
+		if (ic->len) {
+			ic->buf[ic->len] = '\0';
+			ipcrun(ic, ic->buf);
+		}
+		flushbatch();
+		ipcanswer(ic); /* it may still read after shutting down writing */
+		ipcclose(ic);
+		return;
+	}
+	ic->len += n;
+	for (line = ic->buf; (end = memchr(line, '\n', ic->buf + ic->len - line)); line = end + 1) {
+		*end = '\0';
+		ipcrun(ic, line);
+	}
+	ic->len -= line - ic->buf;
+	memmove(ic->buf, line, ic->len);
+	if (ic->len == sizeof(ic->buf) - 1) {
+		flushbatch();
+		ipcanswer(ic);
+		send(ic->fd, "error: line too long\n", 21, MSG_NOSIGNAL|MSG_DONTWAIT);
+		ipcclose(ic);
+	}
+}
+
+/* "status <text>" sets the status text, anything else is a function from
+ * the configuration's aliases and its argument, e.g. "view 4". Functions
+ * are batched like event handlers, so a run of commands arranges once.
+ * Each command is answered in order, with "ok" or "error: <reason>" */
+void
+ipcrun(IpcClient *ic, char *line)
+{
+	char reply[64];
+	void (*func)(const Arg *);
+	Arg arg;
+	Error_t err;
+
+	line += strspn(line, " \t");
+	if (!*line)
+		return;
+	if (!strncmp(line, "status", 6) && (!line[6] || line[6] == ' ' || line[6] == '\t')) {
+		line += 6 + !!line[6];
+		strncpy(stext, line, sizeof(stext) - 1);
+		ipcstatus = 1;
+		if (statusrate)
+			statuspending = 1; /* see flushstatus() */
+		else
+			updatestatus();
+		ic->oks++;
+		return;
+	}
+	if ((err = parse_command(line, &func, &arg)) != ERROR_NONE) {
+		flushbatch(); /* the commands before it are answered first */
+		ipcanswer(ic);
+		snprintf(reply, sizeof(reply), "error: %s\n", ERROR_ENUM_STRINGS[err]);
+		send(ic->fd, reply, strlen(reply), MSG_NOSIGNAL|MSG_DONTWAIT);
+		return;
+	}
+	if (func == movemouse || func == resizemouse) {
+		/* they grab the pointer and wait for events */
+		flushbatch();
+		runbind(func, &arg);
+		ic->oks++;
+		return;
+	}
+	batching = 1;
+	runbind(func, &arg);
+	batching = 0;
+	ic->oks++;
+}
+
 #ifdef XINERAMA
 static int
 isuniquegeom(XineramaScreenInfo *unique, size_t n, XineramaScreenInfo *info)
@@ -1000,6 +1830,22 @@ isuniquegeom(XineramaScreenInfo *unique, size_t n, XineramaScreenInfo *info)
 }
 #endif /* XINERAMA */
 
+/* waits for the configuration startparse() began parsing, or parses it now
+ * if it could not */
+void
+joinparse(void)
+{
+	if (!parsing) {
+		parse_config();
+		return;
+	}
+	pthread_join(parsethread, NULL);
+	parsing = 0;
+	/* the parser could only set the status text, not show it */
+	XStoreName(dpy, root, stext);
+	XSync(dpy, False);
+}
+
 void
 keypress(XEvent *e)
 {
@@ -1009,11 +1855,9 @@ keypress(XEvent *e)
 
 	ev = &e->xkey;
 	keysym = XKeycodeToKeysym(dpy, (KeyCode)ev->keycode, 0);
-	for (i = 0; i < keys_count; i++)
-		if (keysym == keys[i].keysym
-		&& CLEANMASK(keys[i].mod) == CLEANMASK(ev->state)
-		&& keys[i].func)
-			keys[i].func(&(keys[i].arg));
+	for (i = first_keybind(keysym, ev->state); i < keys_count; i = next_keybind(i, keysym, ev->state))
+		if (keys[i].func)
+			runbind(keys[i].func, &(keys[i].arg));
 }
 
 void
@@ -1033,7 +1877,7 @@ killclient(const Arg *arg)
 }
 
 void
-manage(Window w, XWindowAttributes *wa)
+manage(Window w, XWindowAttributes *wa, const Session *saved)
 {
 	Client *c, *t = NULL;
 	Window trans = None;
@@ -1047,9 +1891,19 @@ manage(Window w, XWindowAttributes *wa)
 	c->w = c->oldw = wa->width;
 	c->h = c->oldh = wa->height;
 	c->oldbw = wa->border_width;
+	c->cfgx = wa->x;
+	c->cfgy = wa->y;
+	c->cfgw = wa->width;
+	c->cfgh = wa->height;
 
 	updatetitle(c);
-	if (XGetTransientForHint(dpy, w, &trans) && (t = wintoclient(trans))) {
+	if (saved) { /* restored after restart(), skip the rules */
+		for (c->mon = mons; c->mon && c->mon->num != saved->mon; c->mon = c->mon->next);
+		if (!c->mon)
+			c->mon = selmon;
+		c->tags = saved->tags & TAGMASK ? saved->tags & TAGMASK : c->mon->tagset[c->mon->seltags];
+		c->isfloating = saved->isfloating;
+	} else if (XGetTransientForHint(dpy, w, &trans) && (t = wintoclient(trans))) {
 		c->mon = t->mon;
 		c->tags = t->tags;
 	} else {
@@ -1065,7 +1919,7 @@ manage(Window w, XWindowAttributes *wa)
 	c->y = MAX(c->y, c->mon->wy);
 	c->bw = borderpx;
 
-	wc.border_width = c->bw;
+	c->cfgbw = wc.border_width = c->bw;
 	XConfigureWindow(dpy, w, CWBorderWidth, &wc);
 	XSetWindowBorder(dpy, w, scheme[SchemeNorm][ColBorder].pixel);
 	configure(c); /* propagates border_width, if size doesn't change */
@@ -1080,9 +1934,13 @@ manage(Window w, XWindowAttributes *wa)
 		XRaiseWindow(dpy, c->win);
 	attach(c);
 	attachstack(c);
-	XChangeProperty(dpy, root, netatom[NetClientList], XA_WINDOW, 32, PropModeAppend,
-		(unsigned char *) &(c->win), 1);
+	wininsert(c->win, c, NULL);
+	updateclientlist(c->win, 1);
 	XMoveResizeWindow(dpy, c->win, c->x + 2 * sw, c->y, c->w, c->h); /* some windows require this */
+	c->cfgx = c->x + 2 * sw;
+	c->cfgy = c->y;
+	c->cfgw = c->w;
+	c->cfgh = c->h;
 	setclientstate(c, NormalState);
 	if (c->mon == selmon)
 		unfocus(selmon->sel, 0);
@@ -1098,8 +1956,10 @@ mappingnotify(XEvent *e)
 	XMappingEvent *ev = &e->xmapping;
 
 	XRefreshKeyboardMapping(ev);
-	if (ev->request == MappingKeyboard)
+	if (ev->request == MappingKeyboard) {
+		updatekeymap();
 		grabkeys();
+	}
 }
 
 void
@@ -1111,7 +1971,7 @@ maprequest(XEvent *e)
 	if (!XGetWindowAttributes(dpy, ev->window, &wa) || wa.override_redirect)
 		return;
 	if (!wintoclient(ev->window))
-		manage(ev->window, &wa);
+		manage(ev->window, &wa, NULL);
 }
 
 void
@@ -1129,6 +1989,45 @@ monocle(Monitor *m)
 		resize(c, m->wx, m->wy, m->ww - 2 * c->bw, m->wh - 2 * c->bw, 0);
 }
 
+/* returns the refresh rate of m in Hz, the fastest one of the outputs it
+ * shows if several, or 0 if unknown */
+int
+monrate(Monitor *m)
+{
+	int rate = 0;
+#ifdef XRANDR
+	int i, j;
+	double vtotal;
+	XRRScreenResources *res;
+	XRRCrtcInfo *crtc;
+	XRRModeInfo *mode;
+
+	if (!(res = XRRGetScreenResourcesCurrent(dpy, root)))
+		return 0;
+	for (i = 0; i < res->ncrtc; i++) {
+		if (!(crtc = XRRGetCrtcInfo(dpy, res, res->crtcs[i])))
+			continue;
+		if (crtc->mode != None
+		&& crtc->x < m->mx + m->mw && m->mx < crtc->x + (int)crtc->width
+		&& crtc->y < m->my + m->mh && m->my < crtc->y + (int)crtc->height)
+			for (j = 0; j < res->nmode; j++) {
+				mode = &res->modes[j];
+				if (mode->id != crtc->mode || !mode->hTotal || !mode->vTotal)
+					continue;
+				vtotal = mode->vTotal;
+				if (mode->modeFlags & RR_DoubleScan)
+					vtotal *= 2;
+				if (mode->modeFlags & RR_Interlace)
+					vtotal /= 2;
+				rate = MAX(rate, (int)(mode->dotClock / (mode->hTotal * vtotal) + 0.5));
+			}
+		XRRFreeCrtcInfo(crtc);
+	}
+	XRRFreeScreenResources(res);
+#endif /* XRANDR */
+	return rate;
+}
+
 void
 motionnotify(XEvent *e)
 {
@@ -1149,11 +2048,13 @@ motionnotify(XEvent *e)
 void
 movemouse(const Arg *arg)
 {
-	int x, y, ocx, ocy, nx, ny;
+	int x, y, ocx, ocy, nx, ny, px, py, timer, pending = 0, done = 0;
 	Client *c;
 	Monitor *m;
 	XEvent ev;
+#ifndef __linux__
 	Time lasttime = 0;
+#endif /* __linux__ */
 
 	if (!(c = selmon->sel))
 		return;
@@ -1167,21 +2068,38 @@ movemouse(const Arg *arg)
 		return;
 	if (!getrootptr(&x, &y))
 		return;
-	do {
-		XMaskEvent(dpy, MOUSEMASK|ExposureMask|SubstructureRedirectMask, &ev);
-		switch(ev.type) {
-		case ConfigureRequest:
-		case Expose:
-		case MapRequest:
-			handler[ev.type](&ev);
-			break;
-		case MotionNotify:
-			if ((ev.xmotion.time - lasttime) <= (1000 / refreshrate))
+	px = x;
+	py = y;
+	timer = frametimer(selmon);
+	while (!done) {
+		if (!nextevent(timer, &ev)) {
+			; /* apply the latest motion once per frame */
+		} else if (ev.type == MotionNotify) {
+			px = ev.xmotion.x;
+			py = ev.xmotion.y;
+			pending = 1;
+			if (timer != -1)
+				continue;
+#ifndef __linux__
+			if (refreshrate > 0 && (ev.xmotion.time - lasttime) <= (1000 / refreshrate))
 				continue;
 			lasttime = ev.xmotion.time;
-
-			nx = ocx + (ev.xmotion.x - x);
-			ny = ocy + (ev.xmotion.y - y);
+#endif /* __linux__ */
+		} else if (ev.type == ButtonRelease) {
+			/* always end up where the button was released */
+			pending |= ev.xbutton.x != px || ev.xbutton.y != py;
+			px = ev.xbutton.x;
+			py = ev.xbutton.y;
+			done = 1;
+		} else {
+			if (ev.type == ConfigureRequest || ev.type == Expose || ev.type == MapRequest)
+				handler[ev.type](&ev);
+			continue;
+		}
+		if (pending) {
+			pending = 0;
+			nx = ocx + (px - x);
+			ny = ocy + (py - y);
 			if (abs(selmon->wx - nx) < snap)
 				nx = selmon->wx;
 			else if (abs((selmon->wx + selmon->ww) - (nx + WIDTH(c))) < snap)
@@ -1195,9 +2113,10 @@ movemouse(const Arg *arg)
 				togglefloating(NULL);
 			if (!selmon->lt[selmon->sellt]->arrange || c->isfloating)
 				resize(c, nx, ny, c->w, c->h, 1);
-			break;
 		}
-	} while (ev.type != ButtonRelease);
+	}
+	if (timer != -1)
+		close(timer);
 	XUngrabPointer(dpy, CurrentTime);
 	if ((m = recttomon(c->x, c->y, c->w, c->h)) != selmon) {
 		sendmon(c, m);
@@ -1206,6 +2125,31 @@ movemouse(const Arg *arg)
 	}
 }
 
+/* waits for the next event a pointer grab handles like XMaskEvent(), but
+ * returns 0 instead whenever timer expires first */
+int
+nextevent(int timer, XEvent *ev)
+{
+	struct pollfd fds[2];
+	uint64_t expirations;
+
+	fds[0].fd = ConnectionNumber(dpy);
+	fds[0].events = POLLIN;
+	fds[1].fd = timer; /* ignored by poll() when -1 */
+	fds[1].events = POLLIN;
+	while (!XCheckMaskEvent(dpy, MOUSEMASK|ExposureMask|SubstructureRedirectMask, ev)) {
+		if (poll(fds, LENGTH(fds), -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			die("poll:");
+		}
+		if ((fds[1].revents & POLLIN)
+		&& read(timer, &expirations, sizeof(expirations)) == sizeof(expirations))
+			return 0;
+	}
+	return 1;
+}
+
 Client *
 nexttiled(Client *c)
 {
@@ -1213,6 +2157,13 @@ nexttiled(Client *c)
 	return c;
 }
 
+void *
+parseworker(void *unused)
+{
+	parse_config();
+	return NULL;
+}
+
 void
 pop(Client *c)
 {
@@ -1229,8 +2180,13 @@ propertynotify(XEvent *e)
 	Window trans;
 	XPropertyEvent *ev = &e->xproperty;
 
-	if ((ev->window == root) && (ev->atom == XA_WM_NAME))
-		updatestatus();
+	if ((ev->window == root) && (ev->atom == XA_WM_NAME)) {
+		ipcstatus = 0; /* xsetroot takes the status back */
+		if (statusrate)
+			statuspending = 1; /* see flushstatus() */
+		else
+			updatestatus();
+	}
 	else if (ev->state == PropertyDelete)
 		return; /* ignore */
 	else if ((c = wintoclient(ev->window))) {
@@ -1238,11 +2194,14 @@ propertynotify(XEvent *e)
 		default: break;
 		case XA_WM_TRANSIENT_FOR:
 			if (!c->isfloating && (XGetTransientForHint(dpy, c->win, &trans)) &&
-				(c->isfloating = (wintoclient(trans)) != NULL))
+				(c->isfloating = (wintoclient(trans)) != NULL)) {
+				refit(c);
 				arrange(c->mon);
+			}
 			break;
 		case XA_WM_NORMAL_HINTS:
 			c->hintsvalid = 0;
+			refit(c); /* takes effect with the next arrange() */
 			break;
 		case XA_WM_HINTS:
 			updatewmhints(c);
@@ -1265,6 +2224,20 @@ quit(const Arg *arg)
 	running = 0;
 }
 
+void
+recordlatency(Latency *l, uint64_t start)
+{
+	uint64_t us = gettime() - start;
+	unsigned int i;
+
+	for (i = 0; i < LATBUCKETS - 1 && us >> i; i++)
+		; /* NOP */
+	l->bucket[i]++;
+	l->count++;
+	l->sum += us;
+	l->max = MAX(l->max, us);
+}
+
 Monitor *
 recttomon(int x, int y, int w, int h)
 {
@@ -1279,6 +2252,102 @@ recttomon(int x, int y, int w, int h)
 	return r;
 }
 
+/* makes the next arrange() lay c out and fit it to its monitor again */
+void
+refit(Client *c)
+{
+	c->refit = 1;
+	c->mon->dirty = 1;
+}
+
+void
+reloadconfig(void)
+{
+	Config_Generation_t old;
+	Client *c;
+	Look *newlooks;
+	Monitor *m;
+	unsigned int i, n, oldborderpx = borderpx;
+	int oldshowbar = showbar, oldtopbar = topbar, oldnmaster = nmaster, oldbh = bh;
+	int keyschanged, buttonschanged, themeschanged;
+	float oldmfact = mfact;
+
+	if (reload_config(&old) != ERROR_NONE)
+		return;
+
+	keyschanged = keys_count != old.keys_count;
+	for (i = 0; !keyschanged && i < keys_count; i++)
+		keyschanged = keys[i].mod != old.keys[i].mod || keys[i].keysym != old.keys[i].keysym;
+	buttonschanged = buttons_count != old.buttons_count;
+	for (i = 0; !buttonschanged && i < buttons_count; i++)
+		buttonschanged = buttons[i].click != old.buttons[i].click
+			|| buttons[i].mask != old.buttons[i].mask
+			|| buttons[i].button != old.buttons[i].button;
+	/* the first theme is also the top level fonts and colors */
+	themeschanged = themes_count != old.themes_count
+		|| themediffers(fonts, fonts_count, colors, old.fonts, old.fonts_count, old.colors);
+	for (i = 1; !themeschanged && i < themes_count; i++)
+		themeschanged = themediffers(themes[i].fonts, themes[i].fonts_count, themes[i].colors,
+		                             old.themes[i].fonts, old.themes[i].fonts_count, old.themes[i].colors);
+
+	/* reject the new configuration before touching anything that would die on it */
+	if (themeschanged) {
+		if (!(newlooks = createlooks(&n))) {
+			fprintf(stderr, "dwm: reload: cannot load the first theme\n");
+			revert_config(&old);
+			return;
+		}
+		freelooks(looks, nlooks);
+		looks = newlooks;
+		nlooks = n;
+		uselook(sellook < nlooks && looks[sellook].fonts ? sellook : 0);
+	}
+
+	if (keyschanged)
+		grabkeys();
+	if (buttonschanged)
+		for (m = mons; m; m = m->next)
+			for (c = m->clients; c; c = c->next)
+				grabbuttons(c, c == selmon->sel);
+	if (themeschanged)
+		for (m = mons; m; m = m->next)
+			for (c = m->clients; c; c = c->next)
+				XSetWindowBorder(dpy, c->win, scheme[c == selmon->sel ? SchemeSel : SchemeNorm][ColBorder].pixel);
+	if (borderpx != oldborderpx)
+		for (m = mons; m; m = m->next)
+			for (c = m->clients; c; c = c->next) {
+				if (c->isfullscreen) {
+					c->oldbw = borderpx;
+					continue;
+				}
+				c->bw = borderpx;
+				resizeclient(c, c->x, c->y, c->w, c->h);
+			}
+	if (mfact != oldmfact || nmaster != oldnmaster)
+		for (m = mons; m; m = m->next) {
+			m->mfact = mfact;
+			m->nmaster = nmaster;
+		}
+	if (showbar != oldshowbar || topbar != oldtopbar || bh != oldbh)
+		for (m = mons; m; m = m->next) {
+			m->showbar = showbar;
+			m->topbar = topbar;
+			updatebarpos(m);
+			XMoveResizeWindow(dpy, m->barwin, m->wx, m->by, m->ww, bh);
+		}
+	/* tags, fonts and colors may all have changed */
+	updatebarwidths();
+	for (m = mons; m; m = m->next) {
+		m->bar.valid = 0;
+		for (c = m->clients; c; c = c->next) /* resizehints and layouts too */
+			refit(c);
+		m->dirty = 1;
+	}
+	arrange(NULL);
+	drawbars();
+	free_config_generation(&old);
+}
+
 void
 resize(Client *c, int x, int y, int w, int h, int interact)
 {
@@ -1289,26 +2358,25 @@ resize(Client *c, int x, int y, int w, int h, int interact)
 void
 resizeclient(Client *c, int x, int y, int w, int h)
 {
-	XWindowChanges wc;
-
-	c->oldx = c->x; c->x = wc.x = x;
-	c->oldy = c->y; c->y = wc.y = y;
-	c->oldw = c->w; c->w = wc.width = w;
-	c->oldh = c->h; c->h = wc.height = h;
-	wc.border_width = c->bw;
-	XConfigureWindow(dpy, c->win, CWX|CWY|CWWidth|CWHeight|CWBorderWidth, &wc);
-	configure(c);
-	XSync(dpy, False);
+	c->oldx = c->x; c->x = x;
+	c->oldy = c->y; c->y = y;
+	c->oldw = c->w; c->w = w;
+	c->oldh = c->h; c->h = h;
+	/* the callers sync once they are done, see arrange() and restack() */
+	if (configurewin(c, x, y, w, h, c->bw))
+		configure(c);
 }
 
 void
 resizemouse(const Arg *arg)
 {
-	int ocx, ocy, nw, nh;
+	int ocx, ocy, nw, nh, px, py, timer, pending = 0, done = 0;
 	Client *c;
 	Monitor *m;
 	XEvent ev;
+#ifndef __linux__
 	Time lasttime = 0;
+#endif /* __linux__ */
 
 	if (!(c = selmon->sel))
 		return;
@@ -1321,21 +2389,38 @@ resizemouse(const Arg *arg)
 		None, cursor[CurResize]->cursor, CurrentTime) != GrabSuccess)
 		return;
 	XWarpPointer(dpy, None, c->win, 0, 0, 0, 0, c->w + c->bw - 1, c->h + c->bw - 1);
-	do {
-		XMaskEvent(dpy, MOUSEMASK|ExposureMask|SubstructureRedirectMask, &ev);
-		switch(ev.type) {
-		case ConfigureRequest:
-		case Expose:
-		case MapRequest:
-			handler[ev.type](&ev);
-			break;
-		case MotionNotify:
-			if ((ev.xmotion.time - lasttime) <= (1000 / refreshrate))
+	px = ocx + c->w + 2 * c->bw - 1;
+	py = ocy + c->h + 2 * c->bw - 1;
+	timer = frametimer(selmon);
+	while (!done) {
+		if (!nextevent(timer, &ev)) {
+			; /* apply the latest motion once per frame */
+		} else if (ev.type == MotionNotify) {
+			px = ev.xmotion.x;
+			py = ev.xmotion.y;
+			pending = 1;
+			if (timer != -1)
+				continue;
+#ifndef __linux__
+			if (refreshrate > 0 && (ev.xmotion.time - lasttime) <= (1000 / refreshrate))
 				continue;
 			lasttime = ev.xmotion.time;
-
-			nw = MAX(ev.xmotion.x - ocx - 2 * c->bw + 1, 1);
-			nh = MAX(ev.xmotion.y - ocy - 2 * c->bw + 1, 1);
+#endif /* __linux__ */
+		} else if (ev.type == ButtonRelease) {
+			/* always end up where the button was released */
+			pending |= ev.xbutton.x != px || ev.xbutton.y != py;
+			px = ev.xbutton.x;
+			py = ev.xbutton.y;
+			done = 1;
+		} else {
+			if (ev.type == ConfigureRequest || ev.type == Expose || ev.type == MapRequest)
+				handler[ev.type](&ev);
+			continue;
+		}
+		if (pending) {
+			pending = 0;
+			nw = MAX(px - ocx - 2 * c->bw + 1, 1);
+			nh = MAX(py - ocy - 2 * c->bw + 1, 1);
 			if (c->mon->wx + nw >= selmon->wx && c->mon->wx + nw <= selmon->wx + selmon->ww
 			&& c->mon->wy + nh >= selmon->wy && c->mon->wy + nh <= selmon->wy + selmon->wh)
 			{
@@ -1345,9 +2430,10 @@ resizemouse(const Arg *arg)
 			}
 			if (!selmon->lt[selmon->sellt]->arrange || c->isfloating)
 				resize(c, c->x, c->y, nw, nh, 1);
-			break;
 		}
-	} while (ev.type != ButtonRelease);
+	}
+	if (timer != -1)
+		close(timer);
 	XWarpPointer(dpy, None, c->win, 0, 0, 0, 0, c->w + c->bw - 1, c->h + c->bw - 1);
 	XUngrabPointer(dpy, CurrentTime);
 	while (XCheckMaskEvent(dpy, EnterWindowMask, &ev));
@@ -1362,20 +2448,33 @@ void
 restack(Monitor *m)
 {
 	Client *c;
+	int moved = 0;
 	XEvent ev;
 	XWindowChanges wc;
 
+	if (batching) {
+		m->batch |= BatchRestack;
+		return;
+	}
 	drawbar(m);
 	if (!m->sel)
 		return;
-	if (m->sel->isfloating || !m->lt[m->sellt]->arrange)
+	if (m->sel->isfloating || !m->lt[m->sellt]->arrange) {
 		XRaiseWindow(dpy, m->sel->win);
+		m->sel->stacked = None;
+	}
 	if (m->lt[m->sellt]->arrange) {
+		/* clients still below the one they were stacked below are in
+		 * place, until one has to move and takes those after it along */
 		wc.stack_mode = Below;
 		wc.sibling = m->barwin;
 		for (c = m->stack; c; c = c->snext)
 			if (!c->isfloating && ISVISIBLE(c)) {
-				XConfigureWindow(dpy, c->win, CWSibling|CWStackMode, &wc);
+				if (moved || c->stacked != wc.sibling) {
+					XConfigureWindow(dpy, c->win, CWSibling|CWStackMode, &wc);
+					c->stacked = wc.sibling;
+					moved = 1;
+				}
 				wc.sibling = c->win;
 			}
 	}
@@ -1383,15 +2482,190 @@ restack(Monitor *m)
 	while (XCheckMaskEvent(dpy, EnterWindowMask, &ev));
 }
 
+void
+restart(const Arg *arg)
+{
+	restarting = 1;
+	running = 0;
+}
+
+/* manages the clients savesession() left on root before restart() in their
+ * old state, without asking the server about them or applying the rules
+ * again. the windows it manages are cleared in wins for scan() */
+void
+restoresession(Window *wins, unsigned int num)
+{
+	int format;
+	unsigned long i, j, n, nmons, nsaved, extra;
+	unsigned char *p = NULL;
+	long *data;
+	Atom type;
+	Client *c, **stack;
+	Monitor *m;
+	Session saved;
+	XWindowAttributes wa;
+
+	if (XGetWindowProperty(dpy, root, wmatom[WMSession], 0L, 1L << 20, True, XA_CARDINAL,
+		&type, &format, &n, &extra, &p) != Success || !p)
+		return;
+	data = (long *)p;
+	if (format != 32 || n < 3 || data[0] != SESSIONVERSION
+	|| (nmons = data[2]) > n - 3 || (n - 3 - nmons) % (sizeof(Session) / sizeof(long))) {
+		XFree(p);
+		return;
+	}
+	nsaved = (n - 3 - nmons) / (sizeof(Session) / sizeof(long));
+	for (m = mons; m; m = m->next) {
+		if (m->num == data[1])
+			selmon = m;
+		if ((unsigned long)m->num < nmons && data[3 + m->num] & TAGMASK)
+			m->tagset[m->seltags] = data[3 + m->num] & TAGMASK;
+	}
+	stack = ecalloc(nsaved ? nsaved : 1, sizeof(Client *));
+	/* clients were saved in order, manage() attaches them in front */
+	for (i = nsaved; i-- > 0;) {
+		memcpy(&saved, data + 3 + nmons + i * (sizeof(Session) / sizeof(long)), sizeof(saved));
+		for (j = 0; j < num && wins[j] != (Window)saved.win; j++);
+		if (j == num) /* gone during the restart */
+			continue;
+		/* withdrawn during the restart, like scan() leaves them */
+		if (!XGetWindowAttributes(dpy, wins[j], &wa) || wa.override_redirect
+		|| (wa.map_state != IsViewable && getstate(wins[j]) != IconicState)) {
+			wins[j] = None;
+			continue;
+		}
+		wa.x = saved.x;
+		wa.y = saved.y;
+		wa.width = saved.w;
+		wa.height = saved.h;
+		wa.border_width = saved.oldbw;
+		manage(wins[j], &wa, &saved);
+		if ((c = wintoclient(wins[j]))) {
+			if (saved.isfullscreen && !c->isfullscreen)
+				setfullscreen(c, 1);
+			if (saved.stack >= 0 && (unsigned long)saved.stack < nsaved)
+				stack[saved.stack] = c;
+		}
+		wins[j] = None;
+	}
+	for (i = nsaved; i-- > 0;)
+		if ((c = stack[i])) {
+			detachstack(c);
+			attachstack(c);
+		}
+	for (m = mons; m; m = m->next) {
+		for (c = m->stack; c && !ISVISIBLE(c); c = c->snext);
+		m->sel = c;
+	}
+	free(stack);
+	XFree(p);
+	focus(NULL);
+	arrange(NULL);
+}
+
 void
 run(void)
 {
-	XEvent ev;
+	struct pollfd fds[4 + IPCCLIENTS];
+	int timeout, fontwait, ipc;
+	size_t i;
+
+	fds[0].fd = ConnectionNumber(dpy);
+	fds[1].fd = config_watch(); /* ignored by poll() when -1 */
+	fds[2].fd = ipcfd;
+	fds[3].fd = sigpipe[0];
+	for (i = 0; i < LENGTH(fds); i++)
+		fds[i].events = POLLIN;
 	/* main event loop */
 	XSync(dpy, False);
-	while (running && !XNextEvent(dpy, &ev))
-		if (handler[ev.type])
-			handler[ev.type](&ev); /* call handler */
+	while (running) {
+		while (running && XPending(dpy))
+			dispatch();
+		if (!running)
+			break;
+		if ((timeout = flushstatus()) == 0)
+			continue;
+		if ((fontwait = flushfontcache()) != -1 && (timeout == -1 || fontwait < timeout))
+			timeout = fontwait;
+		for (i = 0; i < LENGTH(ipcclients); i++)
+			fds[4 + i].fd = ipcclients[i].fd;
+		if (poll(fds, LENGTH(fds), timeout) == -1) {
+			if (errno == EINTR)
+				continue;
+			die("poll:");
+		}
+		if ((fds[1].revents & POLLIN) && config_watch_triggered())
+			reloadconfig();
+		if (fds[3].revents & POLLIN)
+			dumplatency();
+		for (i = 0, ipc = 0; i < LENGTH(ipcclients) && running; i++)
+			if (fds[4 + i].fd != -1 && fds[4 + i].revents) {
+				ipcread(&ipcclients[i]);
+				ipc = 1;
+			}
+		if (fds[2].revents & POLLIN)
+			ipcaccept();
+		if (ipc) {
+			flushbatch();
+			for (i = 0; i < LENGTH(ipcclients); i++)
+				if (ipcclients[i].fd != -1)
+					ipcanswer(&ipcclients[i]);
+		}
+	}
+}
+
+void
+runbind(void (*func)(const Arg *), const Arg *arg)
+{
+	unsigned int i;
+	uint64_t start = gettime();
+
+	func(arg);
+	for (i = 0; i < LENGTH(FUNCTION_ALIAS_MAP) && FUNCTION_ALIAS_MAP[i].function != func; i++)
+		; /* NOP */
+	recordlatency(&funclatency[i], start);
+}
+
+/* leaves the clients' state on root for the process restart() executes,
+ * see restoresession() */
+void
+savesession(void)
+{
+	long *data;
+	unsigned long n, nmons = 0, nclients = 0, rank = 0;
+	Client *c, *t;
+	Monitor *m;
+	Session *saved;
+
+	for (m = mons; m; m = m->next, nmons++)
+		for (c = m->clients; c; c = c->next, nclients++);
+	n = 3 + nmons + nclients * (sizeof(Session) / sizeof(long));
+	data = ecalloc(n, sizeof(long));
+	data[0] = SESSIONVERSION;
+	data[1] = selmon->num;
+	data[2] = nmons;
+	saved = (Session *)(data + 3 + nmons);
+	for (m = mons; m; m = m->next) {
+		data[3 + m->num] = m->tagset[m->seltags];
+		for (c = m->clients; c; c = c->next, saved++) {
+			saved->win = c->win;
+			saved->mon = m->num;
+			saved->tags = c->tags;
+			saved->isfullscreen = c->isfullscreen;
+			/* fullscreen clients are restored to where they were before */
+			saved->isfloating = c->isfullscreen ? c->oldstate : c->isfloating;
+			saved->x = c->isfullscreen ? c->oldx : c->x;
+			saved->y = c->isfullscreen ? c->oldy : c->y;
+			saved->w = c->isfullscreen ? c->oldw : c->w;
+			saved->h = c->isfullscreen ? c->oldh : c->h;
+			saved->oldbw = c->oldbw;
+			for (saved->stack = rank, t = m->stack; t && t != c; t = t->snext, saved->stack++);
+		}
+		for (c = m->stack; c; c = c->snext, rank++);
+	}
+	XChangeProperty(dpy, root, wmatom[WMSession], XA_CARDINAL, 32,
+		PropModeReplace, (unsigned char *)data, n);
+	free(data);
 }
 
 void
@@ -1402,19 +2676,20 @@ scan(void)
 	XWindowAttributes wa;
 
 	if (XQueryTree(dpy, root, &d1, &d2, &wins, &num)) {
+		restoresession(wins, num);
 		for (i = 0; i < num; i++) {
-			if (!XGetWindowAttributes(dpy, wins[i], &wa)
+			if (!wins[i] || !XGetWindowAttributes(dpy, wins[i], &wa)
 			|| wa.override_redirect || XGetTransientForHint(dpy, wins[i], &d1))
 				continue;
 			if (wa.map_state == IsViewable || getstate(wins[i]) == IconicState)
-				manage(wins[i], &wa);
+				manage(wins[i], &wa, NULL);
 		}
 		for (i = 0; i < num; i++) { /* now the transients */
-			if (!XGetWindowAttributes(dpy, wins[i], &wa))
+			if (!wins[i] || !XGetWindowAttributes(dpy, wins[i], &wa))
 				continue;
 			if (XGetTransientForHint(dpy, wins[i], &d1)
 			&& (wa.map_state == IsViewable || getstate(wins[i]) == IconicState))
-				manage(wins[i], &wa);
+				manage(wins[i], &wa, NULL);
 		}
 		if (wins)
 			XFree(wins);
@@ -1494,8 +2769,10 @@ setfullscreen(Client *c, int fullscreen)
 		c->oldbw = c->bw;
 		c->bw = 0;
 		c->isfloating = 1;
+		refit(c);
 		resizeclient(c, c->mon->mx, c->mon->my, c->mon->mw, c->mon->mh);
 		XRaiseWindow(dpy, c->win);
+		c->stacked = None;
 	} else if (!fullscreen && c->isfullscreen){
 		XChangeProperty(dpy, c->win, netatom[NetWMState], XA_ATOM, 32,
 			PropModeReplace, (unsigned char*)0, 0);
@@ -1506,6 +2783,7 @@ setfullscreen(Client *c, int fullscreen)
 		c->y = c->oldy;
 		c->w = c->oldw;
 		c->h = c->oldh;
+		refit(c);
 		resizeclient(c, c->x, c->y, c->w, c->h);
 		arrange(c->mon);
 	}
@@ -1514,10 +2792,14 @@ setfullscreen(Client *c, int fullscreen)
 void
 setlayout(const Arg *arg)
 {
+	Client *c;
+
 	if (!arg || !arg->v || arg->v != selmon->lt[selmon->sellt])
 		selmon->sellt ^= 1;
 	if (arg && arg->v)
 		selmon->lt[selmon->sellt] = (Layout *)arg->v;
+	for (c = selmon->clients; c; c = c->next) /* floating layouts fit them all */
+		refit(c);
 	strncpy(selmon->ltsymbol, selmon->lt[selmon->sellt]->symbol, sizeof selmon->ltsymbol);
 	if (selmon->sel)
 		arrange(selmon);
@@ -1537,25 +2819,51 @@ setmfact(const Arg *arg)
 	if (f < 0.05 || f > 0.95)
 		return;
 	selmon->mfact = f;
+	selmon->dirty = 1;
 	arrange(selmon);
 }
 
+void
+settheme(const Arg *arg)
+{
+	Client *c;
+	Monitor *m;
+	int oldbh = bh;
+
+	if (arg->ui >= nlooks || arg->ui == sellook || !looks[arg->ui].fonts)
+		return;
+	uselook(arg->ui);
+	for (m = mons; m; m = m->next) {
+		for (c = m->clients; c; c = c->next)
+			XSetWindowBorder(dpy, c->win, scheme[c == selmon->sel ? SchemeSel : SchemeNorm][ColBorder].pixel);
+		if (bh != oldbh) {
+			updatebarpos(m);
+			XMoveResizeWindow(dpy, m->barwin, m->wx, m->by, m->ww, bh);
+		}
+		m->bar.valid = 0;
+	}
+	updatebarwidths();
+	if (bh != oldbh)
+		arrange(NULL);
+	drawbars();
+}
+
 void
 setup(void)
 {
-	int i;
 	XSetWindowAttributes wa;
 	Atom utf8string;
 	struct sigaction sa;
+	char *path;
 
-	/* do not transform children into zombies when they terminate */
+	/* dump latency histograms on SIGUSR1, whenever it arrives run() polls
+	 * the pipe sigusr1() writes to */
 	sigemptyset(&sa.sa_mask);
-	sa.sa_flags = SA_NOCLDSTOP | SA_NOCLDWAIT | SA_RESTART;
-	sa.sa_handler = SIG_IGN;
-	sigaction(SIGCHLD, &sa, NULL);
-
-	/* clean up any zombies (inherited from .xinitrc etc) immediately */
-	while (waitpid(-1, NULL, WNOHANG) > 0);
+	if (pipe2(sigpipe, O_CLOEXEC|O_NONBLOCK) == -1)
+		die("pipe2:");
+	sa.sa_flags = SA_RESTART;
+	sa.sa_handler = sigusr1;
+	sigaction(SIGUSR1, &sa, NULL);
 
 	/* init screen */
 	screen = DefaultScreen(dpy);
@@ -1563,11 +2871,25 @@ setup(void)
 	sh = DisplayHeight(dpy, screen);
 	root = RootWindow(dpy, screen);
 	drw = drw_create(dpy, screen, root, sw, sh);
-	parse_config();
-	if (!drw_fontset_create(drw, fonts, fonts_count))
-		die("no fonts could be loaded.");
-	lrpad = drw->fonts->h;
-	bh = drw->fonts->h + 2;
+	joinparse();
+
+	/* do not transform children into zombies when they terminate, only
+	 * now that the parser thread is done waiting for its backup writer */
+	sa.sa_flags = SA_NOCLDSTOP | SA_NOCLDWAIT | SA_RESTART;
+	sa.sa_handler = SIG_IGN;
+	sigaction(SIGCHLD, &sa, NULL);
+
+	/* clean up any zombies (inherited from .xinitrc etc) immediately */
+	while (waitpid(-1, NULL, WNOHANG) > 0);
+
+	if ((path = get_data_filepath(FONTCACHE, 0))) {
+		drw_fontcache_load(drw, path);
+		free(path);
+	}
+	if (!(looks = createlooks(&nlooks)))
+		die("cannot load the first theme.");
+	uselook(0);
+	updatebarwidths();
 	updategeom();
 	/* init atoms */
 	utf8string = XInternAtom(dpy, "UTF8_STRING", False);
@@ -1575,6 +2897,7 @@ setup(void)
 	wmatom[WMDelete] = XInternAtom(dpy, "WM_DELETE_WINDOW", False);
 	wmatom[WMState] = XInternAtom(dpy, "WM_STATE", False);
 	wmatom[WMTakeFocus] = XInternAtom(dpy, "WM_TAKE_FOCUS", False);
+	wmatom[WMSession] = XInternAtom(dpy, "_DWM_SESSION", False);
 	netatom[NetActiveWindow] = XInternAtom(dpy, "_NET_ACTIVE_WINDOW", False);
 	netatom[NetSupported] = XInternAtom(dpy, "_NET_SUPPORTED", False);
 	netatom[NetWMName] = XInternAtom(dpy, "_NET_WM_NAME", False);
@@ -1588,10 +2911,6 @@ setup(void)
 	cursor[CurNormal] = drw_cur_create(drw, XC_left_ptr);
 	cursor[CurResize] = drw_cur_create(drw, XC_sizing);
 	cursor[CurMove] = drw_cur_create(drw, XC_fleur);
-	/* init appearance */
-	scheme = ecalloc(LENGTH(colors), sizeof(Clr *));
-	for (i = 0; i < LENGTH(colors); i++)
-		scheme[i] = drw_scm_create(drw, colors[i], 3);
 	/* init bars */
 	updatebars();
 	updatestatus();
@@ -1616,6 +2935,81 @@ setup(void)
 	XSelectInput(dpy, root, wa.event_mask);
 	grabkeys();
 	focus(NULL);
+	setupipc();
+}
+
+/* listens for commands on ipcsocket, see ipcrun(), or by default on a
+ * socket per display in $XDG_RUNTIME_DIR or a directory only this user can
+ * enter. A socket already there is only replaced when it is this user's
+ * and nothing accepts on it anymore */
+void
+setupipc(void)
+{
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	struct stat st;
+	char dir[64];
+	const char *rundir, *disp;
+	mode_t mask;
+	int fd, n, inuse;
+	size_t i;
+
+	for (i = 0; i < LENGTH(ipcclients); i++)
+		ipcclients[i].fd = -1;
+	if (ipcsocket && !*ipcsocket)
+		return;
+	if (ipcsocket) {
+		n = snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", ipcsocket);
+	} else {
+		if (!(rundir = getenv("XDG_RUNTIME_DIR")) || !*rundir) {
+			snprintf(dir, sizeof(dir), "/tmp/dwm-%u", (unsigned int)getuid());
+			if ((mkdir(dir, 0700) == -1 && errno != EEXIST) || lstat(dir, &st) == -1
+			|| !S_ISDIR(st.st_mode) || st.st_uid != getuid() || (st.st_mode & 077)) {
+				fprintf(stderr, "dwm: '%s' is not a directory only this user can enter\n", dir);
+				return;
+			}
+			rundir = dir;
+		}
+		disp = (disp = strrchr(DisplayString(dpy), ':')) ? disp + 1 : "0";
+		n = snprintf(addr.sun_path, sizeof(addr.sun_path), "%s/dwm-%.*s.sock",
+		             rundir, (int)strcspn(disp, "."), disp);
+	}
+	if (n < 0 || (size_t)n >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "dwm: ipc socket path too long: %s\n", addr.sun_path);
+		return;
+	}
+	if (lstat(addr.sun_path, &st) == 0) {
+		if (!S_ISSOCK(st.st_mode) || st.st_uid != getuid()) {
+			fprintf(stderr, "dwm: not replacing '%s', it is not a socket of this user\n", addr.sun_path);
+			return;
+		}
+		if ((fd = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC|SOCK_NONBLOCK, 0)) == -1)
+			return;
+		inuse = connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 || errno != ECONNREFUSED;
+		close(fd);
+		if (inuse) {
+			fprintf(stderr, "dwm: '%s' is in use, by another dwm?\n", addr.sun_path);
+			return;
+		}
+		unlink(addr.sun_path); /* left behind by a dwm that did not exit cleanly */
+	}
+	if ((ipcfd = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC|SOCK_NONBLOCK, 0)) != -1) {
+		mask = umask(077); /* never connectable by others, not even briefly */
+		if (bind(ipcfd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+			close(ipcfd);
+			ipcfd = -1;
+		}
+		umask(mask);
+	}
+	if (ipcfd == -1 || listen(ipcfd, IPCCLIENTS) == -1) {
+		fprintf(stderr, "dwm: cannot listen on '%s': %s\n", addr.sun_path, strerror(errno));
+		if (ipcfd != -1) {
+			close(ipcfd);
+			unlink(addr.sun_path);
+		}
+		ipcfd = -1;
+		return;
+	}
+	ipcpath = estrdup(addr.sun_path); /* ipcsocket goes with its configuration */
 }
 
 void
@@ -1637,38 +3031,70 @@ showhide(Client *c)
 	if (!c)
 		return;
 	if (ISVISIBLE(c)) {
-		/* show clients top down */
-		XMoveWindow(dpy, c->win, c->x, c->y);
-		if ((!c->mon->lt[c->mon->sellt]->arrange || c->isfloating) && !c->isfullscreen)
-			resize(c, c->x, c->y, c->w, c->h, 0);
+		/* show clients top down, only those hidden or to be fit again */
+		if (!c->shown || c->refit) {
+			configurewin(c, c->x, c->y, c->cfgw, c->cfgh, c->cfgbw);
+			if ((!c->mon->lt[c->mon->sellt]->arrange || c->isfloating) && !c->isfullscreen)
+				resize(c, c->x, c->y, c->w, c->h, 0);
+			c->shown = 1;
+			c->refit = 0;
+		}
 		showhide(c->snext);
 	} else {
 		/* hide clients bottom up */
 		showhide(c->snext);
-		XMoveWindow(dpy, c->win, WIDTH(c) * -2, c->y);
+		if (c->shown)
+			configurewin(c, WIDTH(c) * -2, c->y, c->cfgw, c->cfgh, c->cfgbw);
+		c->shown = 0;
 	}
 }
 
+void
+sigusr1(int unused)
+{
+	int saved = errno;
+
+	/* a full pipe already has a dump pending */
+	while (write(sigpipe[1], "", 1) == -1 && errno == EINTR)
+		; /* NOP */
+	errno = saved;
+}
+
 void
 spawn(const Arg *arg)
 {
-	struct sigaction sa;
+	char **argv = (char **)arg->v;
+	posix_spawn_file_actions_t actions;
+	posix_spawnattr_t attr;
+	sigset_t sigdefault;
+	pid_t pid;
+	int err;
 
 	if (arg->v == dmenucmd)
 		dmenumon[0] = '0' + selmon->num;
-	if (fork() == 0) {
-		if (dpy)
-			close(ConnectionNumber(dpy));
-		setsid();
+	posix_spawn_file_actions_init(&actions);
+	if (dpy)
+		posix_spawn_file_actions_addclose(&actions, ConnectionNumber(dpy));
+	posix_spawnattr_init(&attr);
+	sigemptyset(&sigdefault);
+	sigaddset(&sigdefault, SIGCHLD);
+	posix_spawnattr_setsigdefault(&attr, &sigdefault);
+	posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGDEF | SPAWNSESSION);
 
-		sigemptyset(&sa.sa_mask);
-		sa.sa_flags = 0;
-		sa.sa_handler = SIG_DFL;
-		sigaction(SIGCHLD, &sa, NULL);
+	if ((err = posix_spawnp(&pid, argv[0], &actions, &attr, argv, environ)))
+		fprintf(stderr, "dwm: posix_spawnp '%s' failed: %s\n", argv[0], strerror(err));
+	posix_spawnattr_destroy(&attr);
+	posix_spawn_file_actions_destroy(&actions);
+}
 
-		execvp(((char **)arg->v)[0], (char **)arg->v);
-		die("dwm: execvp '%s' failed:", ((char **)arg->v)[0]);
-	}
+/* parses the configuration on its own thread while the X connection is set
+ * up, it needs none of it and nothing reads it before joinparse() */
+void
+startparse(void)
+{
+	parsing = 1;
+	if (pthread_create(&parsethread, NULL, parseworker, NULL))
+		parsing = 0;
 }
 
 void
@@ -1676,6 +3102,7 @@ tag(const Arg *arg)
 {
 	if (selmon->sel && arg->ui & TAGMASK) {
 		selmon->sel->tags = arg->ui & TAGMASK;
+		selmon->dirty = 1;
 		focus(NULL);
 		arrange(selmon);
 	}
@@ -1689,6 +3116,24 @@ tagmon(const Arg *arg)
 	sendmon(selmon->sel, dirtomon(arg->i));
 }
 
+int
+themediffers(const char **f, unsigned int nf, const char *c[][3],
+             const char **of, unsigned int onf, const char *oc[][3])
+{
+	unsigned int i, j;
+
+	if (nf != onf)
+		return 1;
+	for (i = 0; i < nf; i++)
+		if (strcmp(f[i], of[i]))
+			return 1;
+	for (i = 0; i < LENGTH(colors); i++)
+		for (j = 0; j < 3; j++)
+			if (strcmp(c[i][j], oc[i][j]))
+				return 1;
+	return 0;
+}
+
 void
 tile(Monitor *m)
 {
@@ -1734,6 +3179,7 @@ togglefloating(const Arg *arg)
 	if (selmon->sel->isfullscreen) /* no support for fullscreen windows */
 		return;
 	selmon->sel->isfloating = !selmon->sel->isfloating || selmon->sel->isfixed;
+	refit(selmon->sel);
 	if (selmon->sel->isfloating)
 		resize(selmon->sel, selmon->sel->x, selmon->sel->y,
 			selmon->sel->w, selmon->sel->h, 0);
@@ -1750,6 +3196,7 @@ toggletag(const Arg *arg)
 	newtags = selmon->sel->tags ^ (arg->ui & TAGMASK);
 	if (newtags) {
 		selmon->sel->tags = newtags;
+		selmon->dirty = 1;
 		focus(NULL);
 		arrange(selmon);
 	}
@@ -1762,6 +3209,7 @@ toggleview(const Arg *arg)
 
 	if (newtagset) {
 		selmon->tagset[selmon->seltags] = newtagset;
+		selmon->dirty = 1;
 		focus(NULL);
 		arrange(selmon);
 	}
@@ -1800,9 +3248,10 @@ unmanage(Client *c, int destroyed)
 		XSetErrorHandler(xerror);
 		XUngrabServer(dpy);
 	}
+	updateclientlist(c->win, 0);
+	winremove(c->win);
 	free(c);
 	focus(NULL);
-	updateclientlist();
 	arrange(m);
 }
 
@@ -1836,6 +3285,7 @@ updatebars(void)
 		m->barwin = XCreateWindow(dpy, root, m->wx, m->by, m->ww, bh, 0, DefaultDepth(dpy, screen),
 				CopyFromParent, DefaultVisual(dpy, screen),
 				CWOverrideRedirect|CWBackPixmap|CWEventMask, &wa);
+		wininsert(m->barwin, NULL, m);
 		XDefineCursor(dpy, m->barwin, cursor[CurNormal]->cursor);
 		XMapRaised(dpy, m->barwin);
 		XSetClassHint(dpy, m->barwin, &ch);
@@ -1845,6 +3295,10 @@ updatebars(void)
 void
 updatebarpos(Monitor *m)
 {
+	Client *c;
+
+	for (c = m->clients; c; c = c->next) /* floating ones stay inside it */
+		refit(c);
 	m->wy = m->my;
 	m->wh = m->mh;
 	if (m->showbar) {
@@ -1856,17 +3310,59 @@ updatebarpos(Monitor *m)
 }
 
 void
-updateclientlist(void)
+updatekeymap(void)
 {
-	Client *c;
-	Monitor *m;
+	int i, start, end, skip;
+	KeySym *syms;
 
-	XDeleteProperty(dpy, root, netatom[NetClientList]);
-	for (m = mons; m; m = m->next)
-		for (c = m->clients; c; c = c->next)
-			XChangeProperty(dpy, root, netatom[NetClientList],
-				XA_WINDOW, 32, PropModeAppend,
-				(unsigned char *) &(c->win), 1);
+	free(symcodes);
+	symcodes = NULL;
+	nsymcodes = 0;
+	XDisplayKeycodes(dpy, &start, &end);
+	if (!(syms = XGetKeyboardMapping(dpy, start, end - start + 1, &skip)))
+		return;
+	symcodes = ecalloc(end - start + 1, sizeof(SymCode));
+	/* only the first keysym of each keycode, like keypress() */
+	for (i = start; i <= end; i++)
+		if (syms[(i - start) * skip] != NoSymbol) {
+			symcodes[nsymcodes].keysym = syms[(i - start) * skip];
+			symcodes[nsymcodes++].keycode = i;
+		}
+	XFree(syms);
+	qsort(symcodes, nsymcodes, sizeof(SymCode), cmpsymcode);
+}
+
+void
+updatebarwidths(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < LENGTH(tags); i++)
+		tagw[i] = TEXTW(tags[i]);
+}
+
+void
+updateclientlist(Window w, int mapped)
+{
+	size_t i;
+
+	if (mapped) {
+		if (nclientlist == clientlistsz) {
+			clientlistsz = clientlistsz ? clientlistsz * 2 : 64;
+			if (!(clientlist = realloc(clientlist, clientlistsz * sizeof(Window))))
+				die("realloc:");
+		}
+		clientlist[nclientlist++] = w;
+		XChangeProperty(dpy, root, netatom[NetClientList], XA_WINDOW, 32,
+			PropModeAppend, (unsigned char *) &w, 1);
+		return;
+	}
+	for (i = 0; i < nclientlist && clientlist[i] != w; i++);
+	if (i == nclientlist)
+		return;
+	memmove(&clientlist[i], &clientlist[i + 1], (--nclientlist - i) * sizeof(Window));
+	XChangeProperty(dpy, root, netatom[NetClientList], XA_WINDOW, 32,
+		PropModeReplace, (unsigned char *) clientlist, nclientlist);
 }
 
 int
@@ -2010,7 +3506,9 @@ updatesizehints(Client *c)
 void
 updatestatus(void)
 {
-	if (!gettextprop(root, XA_WM_NAME, stext, sizeof(stext)))
+	statuspending = 0;
+	laststatus = gettime() / 1000;
+	if (!ipcstatus && !gettextprop(root, XA_WM_NAME, stext, sizeof(stext)))
 		strcpy(stext, "dwm-"VERSION);
 	drawbar(selmon);
 }
@@ -2032,8 +3530,10 @@ updatewindowtype(Client *c)
 
 	if (state == netatom[NetWMFullscreen])
 		setfullscreen(c, 1);
-	if (wtype == netatom[NetWMWindowTypeDialog])
+	if (wtype == netatom[NetWMWindowTypeDialog]) {
 		c->isfloating = 1;
+		refit(c);
+	}
 }
 
 void
@@ -2055,6 +3555,17 @@ updatewmhints(Client *c)
 	}
 }
 
+/* makes look i current without redrawing anything, see settheme() */
+void
+uselook(unsigned int i)
+{
+	sellook = i;
+	scheme = looks[i].scheme;
+	drw_setfontset(drw, looks[i].fonts);
+	lrpad = drw->fonts->h;
+	bh = drw->fonts->h + 2;
+}
+
 void
 view(const Arg *arg)
 {
@@ -2063,37 +3574,97 @@ view(const Arg *arg)
 	selmon->seltags ^= 1; /* toggle sel tagset */
 	if (arg->ui & TAGMASK)
 		selmon->tagset[selmon->seltags] = arg->ui & TAGMASK;
+	selmon->dirty = 1;
 	focus(NULL);
 	arrange(selmon);
 }
 
+void
+wininsert(Window w, Client *c, Monitor *m)
+{
+	size_t i, sz;
+	WinEntry *old;
+
+	if ((nwins + 1) * 2 > wintablesz) {
+		old = wintable;
+		sz = wintablesz;
+		wintablesz = MAX(wintablesz * 2, 64);
+		wintable = ecalloc(wintablesz, sizeof(WinEntry));
+		nwins = 0;
+		for (i = 0; i < sz; i++)
+			if (old[i].win)
+				wininsert(old[i].win, old[i].c, old[i].m);
+		free(old);
+	}
+	for (i = winslot(w); wintable[i].win && wintable[i].win != w;
+	     i = (i + 1) & (wintablesz - 1));
+	if (!wintable[i].win)
+		nwins++;
+	wintable[i].win = w;
+	wintable[i].c = c;
+	wintable[i].m = m;
+}
+
+WinEntry *
+winlookup(Window w)
+{
+	size_t i;
+
+	if (!wintablesz || !w)
+		return NULL;
+	for (i = winslot(w); wintable[i].win;
+	     i = (i + 1) & (wintablesz - 1))
+		if (wintable[i].win == w)
+			return &wintable[i];
+	return NULL;
+}
+
+void
+winremove(Window w)
+{
+	size_t i, j, k;
+	WinEntry *e;
+
+	if (!(e = winlookup(w)))
+		return;
+	/* shift the rest of the probe run back instead of leaving a tombstone */
+	for (i = e - wintable, j = (i + 1) & (wintablesz - 1); wintable[j].win;
+	     j = (j + 1) & (wintablesz - 1)) {
+		k = winslot(wintable[j].win);
+		if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j)) {
+			wintable[i] = wintable[j];
+			i = j;
+		}
+	}
+	wintable[i].win = 0;
+	nwins--;
+}
+
+size_t
+winslot(Window w)
+{
+	/* fold the client's resource id base into the low bits */
+	return (w ^ w >> 21) * 2654435761UL & (wintablesz - 1);
+}
+
 Client *
 wintoclient(Window w)
 {
-	Client *c;
-	Monitor *m;
+	WinEntry *e = winlookup(w);
 
-	for (m = mons; m; m = m->next)
-		for (c = m->clients; c; c = c->next)
-			if (c->win == w)
-				return c;
-	return NULL;
+	return e ? e->c : NULL;
 }
 
 Monitor *
 wintomon(Window w)
 {
 	int x, y;
-	Client *c;
-	Monitor *m;
+	WinEntry *e;
 
 	if (w == root && getrootptr(&x, &y))
 		return recttomon(x, y, 1, 1);
-	for (m = mons; m; m = m->next)
-		if (w == m->barwin)
-			return m;
-	if ((c = wintoclient(w)))
-		return c->mon;
+	if ((e = winlookup(w)))
+		return e->c ? e->c->mon : e->m;
 	return selmon;
 }
 
@@ -2154,19 +3725,27 @@ main(int argc, char *argv[])
 	        config_filepath = argv[2];
 	else if (argc != 1)
 		die("usage: dwm [-v] [-c PATH]");
+	XInitThreads();
 	if (!setlocale(LC_CTYPE, "") || !XSupportsLocale())
 		fputs("warning: no locale support\n", stderr);
+	startparse(); /* after setlocale(), which races with the parser's ctype and strto*() */
 	if (!(dpy = XOpenDisplay(NULL)))
 		die("dwm: cannot open display");
 	checkotherwm();
 	setup();
 #ifdef __OpenBSD__
-	if (pledge("stdio rpath proc exec", NULL) == -1)
+	if (pledge("stdio rpath wpath cpath unix proc exec", NULL) == -1)
 		die("pledge");
 #endif /* __OpenBSD__ */
 	scan();
 	run();
+	if (restarting)
+		savesession();
 	cleanup();
 	XCloseDisplay(dpy);
+	if (restarting) {
+		execvp(argv[0], argv);
+		die("dwm: execvp '%s' failed:", argv[0]);
+	}
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,69 @@
+/* See LICENSE file for copyright and license details.
+ *
+ * libdwmconf: dwm's configuration parser built on its own, without an X
+ * server, for profiling, benchmarking and testing it. The types below
+ * must be kept in sync with the ones in dwm.c and drw.h.
+ */
+
+enum { ColFg, ColBg, ColBorder }; /* Clr scheme index, see drw.h */
+enum { SchemeNorm, SchemeSel }; /* color schemes */
+enum { ClkTagBar, ClkLtSymbol, ClkStatusText, ClkWinTitle,
+       ClkClientWin, ClkRootWin, ClkLast }; /* clicks */
+
+typedef union {
+	int i;
+	unsigned int ui;
+	float f;
+	const void *v;
+} Arg;
+
+typedef struct {
+	unsigned int click;
+	unsigned int mask;
+	unsigned int button;
+	void (*func)(const Arg *arg);
+	Arg arg;
+} Button;
+
+typedef struct Monitor Monitor;
+
+typedef struct {
+	unsigned int mod;
+	KeySym keysym;
+	void (*func)(const Arg *);
+	Arg arg;
+} Key;
+
+typedef struct {
+	const char *symbol;
+	void (*arrange)(Monitor *);
+} Layout;
+
+typedef struct {
+	const char *class;
+	const char *instance;
+	const char *title;
+	unsigned int tags;
+	int isfloating;
+	int monitor;
+} Rule;
+
+typedef void (*DwmconfFunc)(const Arg *arg);
+
+typedef struct {
+	/* status text the parser would have shown in the bar, may be NULL */
+	void (*status)(const char *text);
+	/* implementation of the dwm function called name (e.g. "spawn"),
+	 * looked up every time a bind's function is called, may be NULL */
+	DwmconfFunc (*resolve)(const char *name);
+} DwmconfCallbacks;
+
+void dwmconf_init(const DwmconfCallbacks *callbacks);
+int dwmconf_parse(const char *path);
+void dwmconf_cleanup(void);
+const char *dwmconf_path(void);
+const Key *dwmconf_keys(unsigned int *n);
+const Button *dwmconf_buttons(unsigned int *n);
+const Rule *dwmconf_rules(unsigned int *n);
+const char **dwmconf_fonts(unsigned int *n);
+const char *dwmconf_tag(unsigned int i);
@@ -0,0 +1,149 @@
+/* See LICENSE file for copyright and license details.
+ *
+ * libdwmconf builds parser.c without the rest of dwm, so the configuration
+ * parser can be run, profiled and tested without an X server.
+ *
+ * parser.c is normally included into dwm.c, where it uses dwm's types,
+ * config.h and the functions binds can call. This file provides the same
+ * from dwmconf.h instead. Every dwm function is replaced by a stub that
+ * asks the host for the real implementation through the resolve callback
+ * when called, and the status text goes to the status callback instead of
+ * the root window's name.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <X11/keysym.h>
+#include <X11/Xlib.h>
+
+#include "dwmconf.h"
+#include "util.h"
+
+/* macros */
+#define CLEANMASK(mask)         (mask & ~(numlockmask|LockMask) & (ShiftMask|ControlMask|Mod1Mask|Mod2Mask|Mod3Mask|Mod4Mask|Mod5Mask))
+#define TAGMASK                 ((1 << LENGTH(tags)) - 1)
+#define STUB(F) \
+	static void F(const Arg *arg) { DwmconfFunc f = cb.resolve ? cb.resolve(#F) : NULL; if (f) f(arg); }
+#define SET_STATUS_TEXT(...) \
+	do { \
+		snprintf(stext, sizeof(stext), "" __VA_ARGS__); \
+		if (cb.status) \
+			cb.status(stext); \
+	} while (0)
+
+/* variables */
+static DwmconfCallbacks cb;
+static char stext[256];
+static unsigned int numlockmask = 0;
+
+/* dwm functions referenced by config.h and parser.c */
+STUB(cycletheme)
+STUB(focusmon)
+STUB(focusstack)
+STUB(incnmaster)
+STUB(killclient)
+STUB(movemouse)
+STUB(quit)
+STUB(resizemouse)
+STUB(restart)
+STUB(setlayout)
+STUB(setmfact)
+STUB(settheme)
+STUB(spawn)
+STUB(tag)
+STUB(tagmon)
+STUB(togglebar)
+STUB(togglefloating)
+STUB(toggletag)
+STUB(toggleview)
+STUB(view)
+STUB(zoom)
+
+/* layouts only need distinct addresses, there is nothing to arrange */
+static void tile(Monitor *m) {}
+static void monocle(Monitor *m) {}
+
+/* configuration, allows nested code to access above variables */
+#include "config.h"
+
+/* compile-time check if all tags fit into an unsigned int bit array. */
+struct NumTags { char limitexceeded[LENGTH(tags) > 31 ? -1 : 1]; };
+
+/* parser */
+#include "parser.c"
+
+void
+dwmconf_init(const DwmconfCallbacks *callbacks)
+{
+	if (callbacks)
+		cb = *callbacks;
+	else
+		memset(&cb, 0, sizeof(cb));
+}
+
+/* parses path, or searches for a configuration like dwm does if NULL.
+ * returns the number of errors, or -1 if no configuration was loaded */
+int
+dwmconf_parse(const char *path)
+{
+	Errors_t errors;
+
+	dwmconf_cleanup();
+	config_filepath = (char *)path;
+	errors = parse_config();
+	if (!config_filepath)
+		return -1;
+	return errors_failure_count(&errors);
+}
+
+void
+dwmconf_cleanup(void)
+{
+	/* nothing to clean up before a configuration has been loaded */
+	if (config_filepath)
+		config_cleanup();
+}
+
+const char *
+dwmconf_path(void)
+{
+	return config_filepath;
+}
+
+const Key *
+dwmconf_keys(unsigned int *n)
+{
+	if (n)
+		*n = keys_count;
+	return keys;
+}
+
+const Button *
+dwmconf_buttons(unsigned int *n)
+{
+	if (n)
+		*n = buttons_count;
+	return buttons;
+}
+
+const Rule *
+dwmconf_rules(unsigned int *n)
+{
+	if (n)
+		*n = rules_count;
+	return rules;
+}
+
+const char **
+dwmconf_fonts(unsigned int *n)
+{
+	if (n)
+		*n = fonts_count;
+	return fonts;
+}
+
+const char *
+dwmconf_tag(unsigned int i)
+{
+	return i < LENGTH(tags) ? tags[i] : NULL;
+}
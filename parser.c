@@ -20,7 +20,7 @@
  * @see https://github.com/yshui/picom
  * @see https://github.com/mihirlad55/dwm-ipc
  *
- * @warning This file must be included in dwm.c after these:
+ * @warning This file must be included in dwm.c (or libdwmconf.c) after these:
  * 	-# The inclusion of config.h
  * 	-# The structs Arg, Rule, Button, Key
  * 	-# The enums for clicks and color schemes
@@ -37,12 +37,22 @@
 #include <errno.h>
 #include <libconfig.h>
 #include <libgen.h>
+#include <limits.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif /* __linux__ */
 #include <X11/X.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
@@ -117,6 +127,19 @@
 		return value;\
 	}
 
+/**
+ * @brief Time a statement as a phase of the parse in @ref _parser_report.
+ *
+ * @param[in] phase @ref Parse_Phase_t the time spent in @p statement is added to.
+ * @param[in] statement Statement to be timed.
+ */
+#define TIME_PHASE( phase, statement )\
+	do {\
+		const uint64_t phase_start = _parser_time_now();\
+		statement;\
+		_parser_report.phase_nanoseconds[ phase ] += _parser_time_now() - phase_start;\
+	} while ( 0 )
+
 /**
  * @brief Return function if variable is NULL.
  *
@@ -131,14 +154,145 @@
 
 /**
  * @brief Macro to easily set status text before first bar draw.
+ *
+ * Can be defined before including this file to send the status text somewhere
+ * else, like libdwmconf.c does, as it has no X server to send it to.
+ *
  * @param[in] ... Format and variables to be printed to the status text.
  */
+#ifndef SET_STATUS_TEXT
 #define SET_STATUS_TEXT( ... )\
 	do{\
 		snprintf( stext, sizeof( stext ), "" __VA_ARGS__ );\
 		XStoreName(dpy, root, stext);\
 		XSync(dpy, False);\
 	} while ( false )
+#endif
+
+/**
+ * @brief Macro to declare the @ref Alias_Index_t of an alias map.
+ * @param[in] map Alias map to index. Must be an array, not a pointer.
+ */
+#define ALIAS_INDEX( map ) { map, sizeof( map[ 0 ] ), LENGTH( map ), ( unsigned int[ LENGTH( map ) ] ){ 0 }, false }
+
+/**
+ * @brief Macro to get the alias of an element of an alias map through its @ref Alias_Index_t.
+ * @param[in] index Pointer to the index of the alias map.
+ * @param[in] element Index of the element in the alias map.
+ */
+#define ALIAS_AT( index, element ) ( *(const char *const *) ( (const char *) ( index )->map + (size_t) ( element ) * ( index )->element_size ) )
+
+/**
+ * @brief Macro to declare the @ref Member_Index_t of a member schema or alias map.
+ * @param[in] map Map to index. Must be an array, not a pointer, of at most half @ref MEMBER_INDEX_SIZE elements.
+ */
+#define MEMBER_INDEX( map ) { map, sizeof( map[ 0 ] ), LENGTH( map ), { 0 }, false }
+
+/**
+ * @brief Macro to locate the color of a @ref THEME_ALIAS_MAP element in a @ref Theme_t instead of in the global @ref colors.
+ * @param[in] theme Pointer to the theme.
+ * @param[in] i Index into @ref THEME_ALIAS_MAP.
+ */
+#define THEME_COLOR( theme, i ) ( &( theme )->colors[ 0 ][ 0 ] + ( THEME_ALIAS_MAP[ i ].color - &colors[ 0 ][ 0 ] ) )
+
+/** @brief Number of slots in the hash table of a @ref Member_Index_t. Must be a power of two. */
+#define MEMBER_INDEX_SIZE 32
+
+/** @brief Minimum size in bytes of an @ref Arena_Block_t's data, see @ref _parser_arena_alloc(). */
+#define ARENA_BLOCK_SIZE 4096
+
+/** @brief Alignment in bytes of every allocation made with @ref _parser_arena_alloc(). */
+#define ARENA_ALIGNMENT 16
+
+/** @brief FNV-1a 64 bit offset basis, the initial value of @ref _parser_fnv1a_hash(). */
+#define FNV1A_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/** @brief FNV-1a 64 bit prime. */
+#define FNV1A_PRIME 0x100000001b3ULL
+
+/** @brief Name of the configuration backup file, stored in dwm's XDG data directory. */
+#define BACKUP_FILENAME "dwm_last.conf"
+
+/** @brief Environment variable naming a file to write the report of every parse to, see @ref _parser_log_report(). */
+#define REPORT_ENVIRONMENT_VARIABLE "DWM_PARSE_REPORT"
+
+/** @brief Name of the configuration snapshot file, stored next to the configuration backup. */
+#define SNAPSHOT_FILENAME "dwm_last.snapshot"
+
+/** @brief Magic bytes identifying a configuration snapshot file. */
+#define SNAPSHOT_MAGIC "DWMSNAP"
+
+/**
+ * @brief Struct containing a case insensitively sorted index over an alias map.
+ *
+ * Every alias map struct starts with its `const char *alias`, so one index type works
+ * for all of them. The index is sorted the first time it is searched, so aliases added
+ * to a map are indexed without any further changes. See @ref _parser_find_alias().
+ *
+ * The maps searched once per bind, @ref FUNCTION_ALIAS_MAP, @ref MODIFIER_ALIAS_MAP,
+ * @ref BUTTON_ALIAS_MAP and @ref CLICK_ALIAS_MAP, are indexed this way. The colors of
+ * @ref THEME_ALIAS_MAP are matched to a theme's members through a @ref Member_Index_t
+ * instead, like the bind and rule members, and @ref SETTING_ALIAS_MAP is only walked
+ * once per parse, so it has no index.
+ */
+typedef struct {
+	const void *map;     ///< Alias map the index is over.
+	size_t element_size; ///< Size in bytes of every element of @p map.
+	unsigned int length; ///< Number of elements in @p map.
+	unsigned int *order; ///< Indexes into @p map, sorted by alias once @p sorted is set.
+	bool sorted;         ///< Boolean tracking whether @p order has been sorted yet.
+} Alias_Index_t;
+
+/** @brief Struct containing one block of memory of an @ref Arena_t. */
+typedef struct Arena_Block_t {
+	struct Arena_Block_t *next; ///< Previously filled block, or NULL.
+	size_t size;                ///< Size in bytes of @p data.
+	size_t used;                ///< Number of bytes of @p data handed out so far.
+	unsigned char data[ ];      ///< Memory handed out by @ref _parser_arena_alloc().
+} Arena_Block_t;
+
+/**
+ * @brief Struct containing the memory backing everything a configuration generation parsed.
+ *
+ * Bind, rule, and font arrays are bump allocated out of a chain of blocks, and every string
+ * stored in the configuration is copied in once, de-duplicated through @p strings. The
+ * arena owns all of it, so a whole generation is released with a single @ref _parser_free_arena().
+ * @p strings is only needed while parsing, and is freed early by @ref _parser_arena_finish().
+ */
+typedef struct {
+	Arena_Block_t *blocks;         ///< Block currently being filled, chained to the previous ones.
+	const char **strings;          ///< Open addressed hash table of interned strings, or NULL.
+	unsigned int strings_count;    ///< Number of strings in @p strings.
+	unsigned int strings_capacity; ///< Number of slots in @p strings, always zero or a power of two.
+} Arena_t;
+
+/**
+ * @brief Struct containing a hash index over a bind array.
+ *
+ * Binds are chained into buckets by the hash of their cleaned chord, in the same
+ * order they appear in the bind array, so several binds on the same chord still
+ * run in configuration order. See @ref first_keybind() and @ref first_buttonbind().
+ */
+typedef struct {
+	const void *binds;        ///< Bind array the index was built over, used to detect a stale index.
+	unsigned int binds_count; ///< Number of elements in @p binds.
+	unsigned int numlockmask; ///< Value of numlockmask when the index was built, as it changes what CLEANMASK() removes.
+	unsigned int bucket_mask; ///< Number of elements in @p buckets minus one, which is always a power of two.
+	unsigned int *buckets;    ///< Index of the first bind in each bucket, or @p binds_count if the bucket is empty.
+	unsigned int *next;       ///< Index of the next bind in the same bucket as each bind, or @p binds_count.
+} Bind_Index_t;
+
+/**
+ * @brief Configuration snapshot format version.
+ *
+ * Bump this whenever the snapshot layout changes, or whenever the parser changes
+ * how it resolves a value in a way @ref _parser_snapshot_schema_hash() can't see,
+ * so that snapshots written by older builds are discarded instead of being trusted.
+ */
+#define SNAPSHOT_VERSION 2
+
+/** @brief Snapshot string offset or function index used to represent NULL. */
+#define SNAPSHOT_NULL_INDEX UINT32_MAX
 
 ///////////////////////////
 ///// Structs & Enums /////
@@ -156,6 +310,43 @@ typedef struct {
 	const int click;   ///< Click enum relating to @p alias.
 } Click_Alias_Map_t;
 
+/** @brief Struct containing the fonts and colors of one of the configuration's themes. */
+typedef struct {
+	const char **fonts;                          ///< Array of fonts.
+	unsigned int fonts_count;                    ///< Number of elements in @p fonts.
+	const char *colors[ LENGTH( colors ) ][ 3 ]; ///< Color scheme strings.
+} Theme_t;
+
+/**
+ * @brief Struct containing everything a loaded configuration consists of, and the memory backing it.
+ *
+ * A generation is captured from the parser's global configuration variables with
+ * @ref _parser_capture_generation(), and can be made live again with @ref _parser_apply_generation().
+ * Every array and string the generation parsed lives in @p arena, so they stay valid exactly
+ * as long as the generation does. See @ref reload_config().
+ */
+typedef struct {
+	Key *keys;                                   ///< Array of keybinds.
+	Button *buttons;                             ///< Array of buttons.
+	Rule *rules;                                 ///< Array of rules.
+	const char **fonts;                          ///< Array of fonts.
+	Theme_t *themes;                             ///< Array of themes.
+	unsigned int keys_count;                     ///< Number of elements in @p keys.
+	unsigned int buttons_count;                  ///< Number of elements in @p buttons.
+	unsigned int rules_count;                    ///< Number of elements in @p rules.
+	unsigned int fonts_count;                    ///< Number of elements in @p fonts.
+	unsigned int themes_count;                   ///< Number of elements in @p themes.
+	bool keys_malloced;                          ///< Boolean tracking whether @p keys has been dynamically allocated.
+	bool buttons_malloced;                       ///< Boolean tracking whether @p buttons has been dynamically allocated.
+	bool rules_malloced;                         ///< Boolean tracking whether @p rules has been dynamically allocated.
+	bool fonts_malloced;                         ///< Boolean tracking whether @p fonts has been dynamically allocated.
+	bool themes_malloced;                        ///< Boolean tracking whether @p themes has been dynamically allocated.
+	const char *tags[ LENGTH( tags ) ];          ///< Tag names.
+	const char *colors[ LENGTH( colors ) ][ 3 ]; ///< Color scheme strings.
+	uint64_t *settings;                          ///< Dynamically allocated copy of the value of every setting in @ref SETTING_ALIAS_MAP, one slot each.
+	Arena_t *arena;                              ///< Arena holding the parsed arrays and strings of this generation, or NULL.
+} Config_Generation_t;
+
 /** @brief Enum used to keep track of what kind of data is to be stored in an Arg struct */
 typedef enum {
 	TYPE_NONE = 0, ///< No data stored/required.
@@ -164,8 +355,67 @@ typedef enum {
 	TYPE_UINT,     ///< Unsigned Integer data.
 	TYPE_FLOAT,    ///< Float data.
 	TYPE_STRING,   ///< String data.
+	TYPE_COMMAND,  ///< Command to spawn, stored as a pointer to a @ref Spawn_Command_t.
 } Data_Type_t;
 
+/** @brief Struct of a spawn bind's command, split into its arguments when parsed so it doesn't need a shell to run. */
+typedef struct {
+	const char *command; ///< Command as written in the configuration, interned in @ref config_arena.
+	char **argv;         ///< NULL terminated arguments to execute, `/bin/sh -c` @ref command if it uses any shell syntax.
+} Spawn_Command_t;
+
+/** @brief Enum of the @ref Rule fields matched by a @ref Rule_Matcher_t, one automaton each. */
+typedef enum {
+	RULE_FIELD_CLASS = 0, ///< Matched against the window's class.
+	RULE_FIELD_INSTANCE,  ///< Matched against the window's instance.
+	RULE_FIELD_TITLE,     ///< Matched against the window's title.
+	RULE_FIELD_LENGTH     ///< Count of possible enum values. Always must be last.
+} Rule_Field_t;
+
+/** @brief Struct for a single node of a @ref Rule_Automaton_t trie. */
+typedef struct {
+	unsigned int first_child;  ///< First child node, or 0 for none, as the root is never a child.
+	unsigned int next_sibling; ///< Next node with the same parent, or 0 for none.
+	unsigned int fail;         ///< Node of the longest proper suffix of this node's string that is also in the trie.
+	unsigned int dictionary;   ///< Nearest node along @p fail with rules ending on it, or 0 for none.
+	unsigned int first_rule;   ///< First rule whose pattern ends on this node, or the rule count for none.
+	unsigned int seen;         ///< Last scan this node was reached in, so its rules are only counted once per scan.
+	unsigned char byte;        ///< Byte of the edge from the parent node to this node.
+} Rule_Automaton_Node_t;
+
+/**
+ * @brief Struct containing an Aho-Corasick automaton over one field of every rule.
+ *
+ * Scanning a string through the automaton finds every rule pattern contained in it in a
+ * single pass, however many rules there are. Rules sharing a pattern share its node.
+ */
+typedef struct {
+	Rule_Automaton_Node_t *nodes; ///< Trie nodes, the root always being node 0.
+	unsigned int nodes_count;     ///< Number of elements in @p nodes.
+	unsigned int *next_rule;      ///< Next rule with the same pattern as each rule, or the rule count.
+} Rule_Automaton_t;
+
+/**
+ * @brief Struct containing every rule compiled into a matcher.
+ *
+ * A rule matches a window when each of its non NULL fields is found in the window's
+ * matching string, the same as dwm's strstr() based matching. See @ref first_rule().
+ */
+typedef struct {
+	const Rule *rules;                              ///< Rule array the matcher was compiled from, used to detect a stale matcher.
+	unsigned int rules_count;                       ///< Number of elements in @p rules.
+	Rule_Automaton_t automata[ RULE_FIELD_LENGTH ]; ///< Automaton over each field of @p rules.
+	unsigned char *required;                        ///< Number of fields each rule needs found to match.
+	unsigned int *always;                           ///< Rules without any required field, which match every window, in ascending order.
+	unsigned int always_count;                      ///< Number of elements in @p always.
+	unsigned char *found;                           ///< Number of fields found for each rule in the current match.
+	unsigned int *found_stamp;                      ///< Match @p found was last reset in for each rule.
+	unsigned int stamp;                             ///< Current match, incremented on every @ref first_rule().
+	unsigned int *matches;                          ///< Rules matched by the current match, in ascending order.
+	unsigned int matches_count;                     ///< Number of elements in @p matches.
+	const char *strings[ RULE_FIELD_LENGTH ];       ///< Strings of the current match, only kept for matching linearly.
+} Rule_Matcher_t;
+
 /**
  * @brief Enum to categorize the types of errors that can occur during parsing.
  * @todo Maybe look at adding ERROR_ARGUMENT, as we check function arguments a ton.
@@ -199,6 +449,71 @@ typedef struct {
 	const long double range_max;       ///< If @ref argument_type is numeric, maximum permissible value.
 } Function_Alias_Map_t;
 
+/** @brief Enum of the phases of parsing a configuration timed in @ref Parse_Report_t. */
+typedef enum {
+	PHASE_DISCOVERY,      ///< Searching for a configuration file in @ref _parser_open_config_file(), excluding the phases below.
+	PHASE_SNAPSHOT_LOAD,  ///< Loading it from its snapshot in @ref _parser_load_snapshot().
+	PHASE_READ,           ///< Reading it with config_read().
+	PHASE_SETTINGS,       ///< @ref _parse_generic_settings().
+	PHASE_KEYBINDS,       ///< @ref _parse_keybinds_config().
+	PHASE_BUTTONBINDS,    ///< @ref _parse_buttonbinds_config().
+	PHASE_RULES,          ///< @ref _parse_rules_config().
+	PHASE_TAGS,           ///< @ref _parse_tags_config().
+	PHASE_THEME,          ///< @ref _parse_theme_config().
+	PHASE_BACKUP,         ///< @ref _parser_backup_config(), handing the backup and snapshot off to their writer.
+	PHASE_INDEX,          ///< @ref index_binds() and @ref compile_rules().
+	PHASE_ENUM_LENGTH,    ///< Length of enum, must be the last element.
+} Parse_Phase_t;
+
+/** @brief Struct with the time spent in every phase of the last parse, and the memory it allocated. */
+typedef struct {
+	uint64_t start_nanoseconds;                      ///< Time the parse started at, see @ref _parser_time_now().
+	uint64_t phase_nanoseconds[ PHASE_ENUM_LENGTH ]; ///< Time spent in each @ref Parse_Phase_t.
+	size_t array_bytes;                              ///< Bytes allocated for arrays by @ref _parse_setting_array().
+	unsigned int array_count;                        ///< Number of arrays allocated by @ref _parse_setting_array().
+	size_t estrdup_bytes;                            ///< Bytes allocated by @ref estrdup().
+	unsigned int estrdup_count;                      ///< Number of strings allocated by @ref estrdup().
+	size_t interned_bytes;                           ///< Bytes allocated for strings by @ref _parser_intern_string().
+	unsigned int interned_count;                     ///< Number of strings allocated by @ref _parser_intern_string().
+} Parse_Report_t;
+
+/** @brief Enum of the kinds of value a @ref Member_Schema_t can parse. */
+typedef enum {
+	MEMBER_STRING = 0, ///< Interned string, NULL if set to "NULL".
+	MEMBER_INT,        ///< Range checked integer.
+	MEMBER_UINT,       ///< Range checked unsigned integer.
+	MEMBER_MODIFIER,   ///< Bind modifier mask, see @ref _parse_bind_modifier().
+	MEMBER_KEYSYM,     ///< Keybind keysym, see @ref _parse_keybind_keysym().
+	MEMBER_BUTTON,     ///< Buttonbind button, see @ref _parse_buttonbind_button().
+	MEMBER_CLICK,      ///< Buttonbind click, see @ref _parse_buttonbind_click().
+	MEMBER_FUNCTION,   ///< Bind function, see @ref _parse_bind_function().
+	MEMBER_ARGUMENT,   ///< Bind argument, typed by the element's @ref MEMBER_FUNCTION which must come first, see @ref _parse_bind_argument().
+} Member_Type_t;
+
+/** @brief Struct describing one member of a group setting, like a keybind's "key", and where its parsed value is stored. */
+typedef struct {
+	const char *name;            ///< Name of the member's setting in the group.
+	const Member_Type_t type;    ///< Kind of value the member holds.
+	const size_t offset;         ///< Offset in bytes of the parsed value in the element's struct.
+	const long double range_min; ///< If @ref type is numeric, minimum permissible value.
+	const long double range_max; ///< If @ref type is numeric, maximum permissible value.
+} Member_Schema_t;
+
+/**
+ * @brief Struct containing a hash table over the names of a member schema or alias map.
+ *
+ * Like @ref Alias_Index_t, every map it indexes starts with its `const char *` name, and
+ * the table is only filled the first time it is searched. Names are matched case sensitively,
+ * just like libconfig matches setting names. See @ref _parser_find_member().
+ */
+typedef struct {
+	const void *map;                          ///< Map the index is over.
+	size_t element_size;                      ///< Size in bytes of every element of @p map.
+	unsigned int length;                      ///< Number of elements in @p map.
+	unsigned char slots[ MEMBER_INDEX_SIZE ]; ///< One more than the index into @p map of the name in each slot, or 0 if empty.
+	bool hashed;                              ///< Boolean tracking whether @p slots has been filled yet.
+} Member_Index_t;
+
 /** @brief Struct to map a string alias to a matching X11 modifier. */
 typedef struct {
 	const char *alias;           ///< String alias to search for in configuration.
@@ -215,6 +530,96 @@ typedef struct {
 	const long double range_max; ///< If @ref type is numeric, maximum permissible value.
 } Setting_Alias_Map_t;
 
+/**
+ * @brief Header found at the start of a configuration snapshot file.
+ *
+ * A snapshot is a flat image of the resolved configuration, written after a clean parse and
+ * memory mapped on the next start instead of parsing the configuration file again. The header
+ * is followed by, in order, @p keys_count @ref Snapshot_Key_t, @p buttons_count @ref Snapshot_Button_t,
+ * @p rules_count @ref Snapshot_Rule_t, @p settings_count 64 bit setting slots, and @p fonts_count,
+ * @p tags_count and @p colors_count 32 bit string offsets, and finally the string table itself.
+ * If @p themes_count is not 0, the fonts are those of every theme in turn, each theme's ended by
+ * @ref SNAPSHOT_NULL_INDEX, and the colors are those of every theme in turn.
+ * All values are stored in host byte order, a snapshot is only ever read by the machine that wrote it.
+ */
+typedef struct {
+	char magic[ 8 ];                  ///< @ref SNAPSHOT_MAGIC, NULL terminated.
+	uint32_t version;                 ///< @ref SNAPSHOT_VERSION the snapshot was written with.
+	uint32_t header_size;             ///< Size of this header, guards against layout changes.
+	uint64_t schema_hash;             ///< Value of @ref _parser_snapshot_schema_hash() when written.
+	uint64_t source_hash;             ///< FNV-1a hash of the source configuration file's contents.
+	uint64_t source_size;             ///< Size in bytes of the source configuration file.
+	int64_t source_mtime_seconds;     ///< Modification time of the source configuration file, seconds part.
+	int64_t source_mtime_nanoseconds; ///< Modification time of the source configuration file, nanoseconds part.
+	uint32_t source_filepath;         ///< String offset of the source configuration file's path.
+	uint32_t keys_count;              ///< Number of keybind records.
+	uint32_t buttons_count;           ///< Number of buttonbind records.
+	uint32_t rules_count;             ///< Number of rule records, 0 if the default rules were in use.
+	uint32_t fonts_count;             ///< Number of font string offsets, 0 if the default fonts were in use.
+	uint32_t themes_count;            ///< Number of themes, 0 if the configuration's themes were not parsed.
+	uint32_t tags_count;              ///< Number of tag string offsets, always `LENGTH( tags )`.
+	uint32_t colors_count;            ///< Number of color string offsets, `LENGTH( THEME_ALIAS_MAP )` for every theme, or just once.
+	uint32_t settings_count;          ///< Number of setting slots, always `LENGTH( SETTING_ALIAS_MAP )`.
+	uint32_t strings_size;            ///< Size in bytes of the string table.
+} Snapshot_Header_t;
+
+/** @brief Snapshot record of a parsed Key struct. */
+typedef struct {
+	uint32_t modifier; ///< Key modifier mask.
+	uint32_t function; ///< Index into @ref FUNCTION_ALIAS_MAP, or @ref SNAPSHOT_NULL_INDEX.
+	uint64_t keysym;   ///< Keysym of the bind.
+	uint64_t argument; ///< Packed argument, see @ref _parser_snapshot_pack_argument().
+} Snapshot_Key_t;
+
+/** @brief Snapshot record of a parsed Button struct. */
+typedef struct {
+	uint32_t click;    ///< Click enum of the bind.
+	uint32_t modifier; ///< Button modifier mask.
+	uint32_t button;   ///< X11 button of the bind.
+	uint32_t function; ///< Index into @ref FUNCTION_ALIAS_MAP, or @ref SNAPSHOT_NULL_INDEX.
+	uint64_t argument; ///< Packed argument, see @ref _parser_snapshot_pack_argument().
+} Snapshot_Button_t;
+
+/** @brief Snapshot record of a parsed Rule struct. */
+typedef struct {
+	uint32_t class;     ///< String offset of the rule's class, or @ref SNAPSHOT_NULL_INDEX.
+	uint32_t instance;  ///< String offset of the rule's instance, or @ref SNAPSHOT_NULL_INDEX.
+	uint32_t title;     ///< String offset of the rule's title, or @ref SNAPSHOT_NULL_INDEX.
+	uint32_t tags;      ///< Tag mask of the rule.
+	int32_t isfloating; ///< Floating state of the rule.
+	int32_t monitor;    ///< Monitor of the rule.
+} Snapshot_Rule_t;
+
+/** @brief Pointers to each section of a snapshot image, see @ref _parser_snapshot_layout(). */
+typedef struct {
+	Snapshot_Header_t *header;  ///< Snapshot header, at the start of the image.
+	Snapshot_Key_t *keys;       ///< Keybind records.
+	Snapshot_Button_t *buttons; ///< Buttonbind records.
+	Snapshot_Rule_t *rules;     ///< Rule records.
+	uint64_t *settings;         ///< Setting slots, in @ref SETTING_ALIAS_MAP order.
+	uint32_t *fonts;            ///< Font string offsets.
+	uint32_t *tags;             ///< Tag string offsets.
+	uint32_t *colors;           ///< Color string offsets, in @ref THEME_ALIAS_MAP order, theme after theme.
+	char *strings;              ///< String table.
+	uint64_t fixed_size;        ///< Size in bytes of everything before @p strings.
+} Snapshot_Layout_t;
+
+/** @brief Growable string table used while writing a snapshot. */
+typedef struct {
+	char *data;      ///< String table contents.
+	size_t size;     ///< Bytes of @p data in use.
+	size_t capacity; ///< Bytes allocated for @p data.
+} Snapshot_Strings_t;
+
+/** @brief Identity of a configuration file's contents, used to tell if a snapshot is still valid. */
+typedef struct {
+	bool valid;                ///< Whether the rest of the fields were successfully collected.
+	uint64_t hash;             ///< FNV-1a hash of the file's contents.
+	uint64_t size;             ///< Size in bytes of the file.
+	int64_t mtime_seconds;     ///< Modification time of the file, seconds part.
+	int64_t mtime_nanoseconds; ///< Modification time of the file, nanoseconds part.
+} Source_Info_t;
+
 /** @brief Struct to map a string alias to a matching color string pointer. */
 typedef struct {
 	const char *alias;  ///< String alias to search for in configuration.
@@ -225,23 +630,41 @@ typedef struct {
 ///// Global Variables /////
 ////////////////////////////
 
-config_t libconfig_config;    ///< Master libconfig configuration context used for parsing.
-char *config_filepath = NULL; ///< Path to the currently loaded configuration's file.
+config_t *libconfig_config = NULL; ///< libconfig configuration context, only alive while a configuration file is being parsed.
+char *config_filepath = NULL;      ///< Path to the currently loaded configuration's file.
 
 Key *keys = default_keys;           ///< Array of current keybinds.
 Button *buttons = default_buttons;  ///< Array of current buttons.
 Rule *rules = default_rules;        ///< Array of current rules.
 const char **fonts = default_fonts; ///< Array of current fonts.
+Theme_t *themes = NULL;             ///< Array of every parsed theme, the first of which is also in @ref fonts and @ref colors.
 
 unsigned int keys_count = LENGTH( default_keys );       ///< Number of elements in @ref keys.
 unsigned int buttons_count = LENGTH( default_buttons ); ///< Number of elements in @ref buttons.
 unsigned int rules_count = LENGTH( default_rules );     ///< Number of elements in @ref rules.
 unsigned int fonts_count = LENGTH( default_fonts );     ///< Number of elements in @ref fonts_count.
+unsigned int themes_count = 0;                          ///< Number of elements in @ref themes.
 
 bool keys_malloced = false;    ///< Boolean tracking whether @ref keys has been dynamically allocated.
 bool buttons_malloced = false; ///< Boolean tracking whether @ref buttons has been dynamically allocated.
 bool rules_malloced = false;   ///< Boolean tracking whether @ref rules has been dynamically allocated.
 bool fonts_malloced = false;   ///< Boolean tracking whether @ref fonts has been dynamically allocated.
+bool themes_malloced = false;  ///< Boolean tracking whether @ref themes has been dynamically allocated.
+
+Arena_t *config_arena = NULL; ///< Arena holding the current configuration's parsed arrays and strings, if any.
+
+static Config_Generation_t _parser_default_generation = { 0 }; ///< Hardcoded default configuration, captured before the first parse. Every reload starts from it.
+static bool _parser_fallback_config_loaded = false;             ///< Boolean tracking whether @ref config_filepath is a fallback configuration.
+
+static int _parser_watch_fd = -1;           ///< inotify file descriptor returned by @ref config_watch(), or -1.
+static int _parser_watch_descriptor = -1;   ///< inotify watch on the directory containing @ref config_filepath, or -1.
+static char *_parser_watch_filename = NULL; ///< Filename of @ref config_filepath within the watched directory.
+
+static Bind_Index_t _parser_key_index = { 0 };      ///< Dispatch index over @ref keys, see @ref first_keybind().
+static Bind_Index_t _parser_button_index = { 0 };   ///< Dispatch index over @ref buttons, see @ref first_buttonbind().
+static Rule_Matcher_t _parser_rule_matcher = { 0 }; ///< Matcher compiled from @ref rules, see @ref first_rule().
+
+static Parse_Report_t _parser_report = { 0 }; ///< Timing and allocations of the last parse, see @ref _parser_log_report().
 
 /**
  * @brief Parser filepath string.
@@ -255,6 +678,9 @@ static const char *_parser_filepath = __FILE__;
 /** @brief String name pairs to @ref Error_t. */
 const char *ERROR_ENUM_STRINGS[ ] = { "None", "Not found", "Invalid type", "Out of range", "Null value", "Failed to allocate memory", "I/O exception" };
 
+/** @brief String names of @ref Parse_Phase_t, as used in the parse report. */
+const char *PHASE_ENUM_STRINGS[ ] = { "discovery", "snapshot_load", "read", "settings", "keybinds", "buttonbinds", "rules", "tags", "theme", "backup", "index" };
+
 /** @brief Common string used for logging memory allocation issues. */
 const char *FAILED_ALLOC_PRINT_STRING = "Failed to allocate memory";
 
@@ -265,8 +691,22 @@ const char *POINTER_NULL_PRINT_STRING = "Cannot continue, pointer NULL";
 ///// Public parser functions /////
 ///////////////////////////////////
 
+void compile_rules( void );
 void config_cleanup( void );
+int config_watch( void );
+bool config_watch_triggered( void );
+unsigned int first_buttonbind( unsigned int click, unsigned int button, unsigned int modifier );
+unsigned int first_keybind( KeySym keysym, unsigned int modifier );
+unsigned int first_rule( const char *class, const char *instance, const char *title );
+void free_config_generation( Config_Generation_t *generation );
+void index_binds( void );
+unsigned int next_buttonbind( unsigned int index, unsigned int click, unsigned int button, unsigned int modifier );
+unsigned int next_keybind( unsigned int index, KeySym keysym, unsigned int modifier );
+unsigned int next_rule( unsigned int index );
+Error_t parse_command( char *command, void ( **function )( const Arg * ), Arg *argument );
 Errors_t parse_config( void );
+Error_t reload_config( Config_Generation_t *previous );
+void revert_config( Config_Generation_t *previous );
 
 ////////////////////////////////////
 ///// Public utility functions /////
@@ -277,6 +717,7 @@ void copy_errors( Errors_t *destination, Errors_t source );
 int errors_failure_count( const Errors_t *errors );
 char *estrdup( const char *string );
 void extend_string( char **source_string, const char *addition );
+char *get_data_filepath( const char *filename, bool create_directory );
 const Layout *get_layout( void ( *arrange )( Monitor * ) );
 char *get_xdg_config_home( void );
 char *get_xdg_data_home( void );
@@ -292,9 +733,9 @@ void spawn_string( const Arg *arg );
 ///// Parser internal functions /////
 /////////////////////////////////////
 
-static Error_t _parser_backup_config( config_t *config );
+static void _parser_apply_generation( const Config_Generation_t *generation );
+static Error_t _parser_backup_config( config_t *config, const Source_Info_t *source_info );
 static Error_t _parse_bind_argument( config_setting_t *setting, Data_Type_t argument_type, long double range_min, long double range_max, Arg *argument );
-static Errors_t _parse_bind_core( config_setting_t *setting, unsigned int bind_index, unsigned int *modifier, void ( **function )( const Arg * ), Arg *argument );
 static Error_t _parse_bind_function( config_setting_t *setting, void ( **function )( const Arg * ), Data_Type_t *argument_type, long double *range_min, long double *range_max );
 static Error_t _parse_bind_modifier( config_setting_t *setting, unsigned int *modifier );
 static Errors_t _parse_buttonbind( config_setting_t *setting, unsigned int index, Button *buttonbind );
@@ -302,6 +743,8 @@ static Errors_t _parse_buttonbind_adapter( config_setting_t *setting, unsigned i
 static Error_t _parse_buttonbind_button( config_setting_t *setting, unsigned int *button );
 static Error_t _parse_buttonbind_click( config_setting_t *setting, unsigned int *click );
 static Errors_t _parse_buttonbinds_config( const config_t *config, Button **array, unsigned int *count, bool *malloced );
+static Errors_t _parse_element( config_setting_t *setting, unsigned int index, const char *element_name, Member_Index_t *schema, void *element, size_t element_size );
+static Error_t _parser_capture_generation( Config_Generation_t *generation );
 static Errors_t _parse_font( config_setting_t *setting, unsigned int index, const char **font );
 static Errors_t _parse_font_adapter( config_setting_t *setting, unsigned int index, void *font );
 static Errors_t _parse_generic_settings( const config_t *config );
@@ -309,7 +752,11 @@ static Errors_t _parse_keybind( config_setting_t *setting, unsigned int index, K
 static Errors_t _parse_keybind_adapter( config_setting_t *setting, unsigned int index, void *keybind );
 static Error_t _parse_keybind_keysym( config_setting_t *setting, KeySym *keysym );
 static Errors_t _parse_keybinds_config( const config_t *config, Key **array, unsigned int *count, bool *malloced );
-static Errors_t _parser_open_config_file( config_t *config, const char *custom_config_filepath, char **found_config_filepath, bool *fallback_config_loaded );
+static Error_t _parser_load_snapshot( const char *source_filepath, const Source_Info_t *source_info );
+static Errors_t _parse_loaded_config( const Source_Info_t *source_info );
+static Errors_t _parser_open_config_file( config_t *config, const char *custom_config_filepath, char **found_config_filepath, bool *fallback_config_loaded, Source_Info_t *source_info,
+                                          bool *snapshot_loaded );
+static Error_t _parser_read_config_file( config_t *config, const char *filepath, bool is_fallback_config, Source_Info_t *source_info, bool *snapshot_loaded );
 static Errors_t _parse_rule( config_setting_t *setting, unsigned int index, Rule *rule );
 static Errors_t _parse_rule_adapter( config_setting_t *setting, unsigned int index, void *rule );
 static Errors_t _parse_rules_config( const config_t *config, Rule **array, unsigned int *count, bool *malloced );
@@ -318,20 +765,63 @@ static Errors_t _parse_setting_array( const config_setting_t *setting, size_t el
 static Errors_t _parse_tag( config_setting_t *setting, unsigned int index );
 static Errors_t _parse_tags_adapter( config_setting_t *setting, unsigned int index, void *unused );
 static Errors_t _parse_tags_config( const config_t *config );
-static Errors_t _parse_theme( config_setting_t *setting, unsigned int index );
-static Errors_t _parse_theme_adapter( config_setting_t *setting, unsigned int index, void *unused );
+static Errors_t _parse_theme( config_setting_t *setting, unsigned int index, Theme_t *theme );
+static Errors_t _parse_theme_adapter( config_setting_t *setting, unsigned int index, void *theme );
 static Errors_t _parse_theme_config( const config_t *config );
+static Error_t _parser_validate_snapshot( void *image, uint64_t image_size, const char *source_filepath, const Source_Info_t *source_info, Snapshot_Layout_t *layout );
+static Error_t _parser_write_backup( const config_t *config );
+static Error_t _parser_write_snapshot( const char *source_filepath, const Source_Info_t *source_info );
 
 /////////////////////////////////////////////
 ///// Parser internal utility functions /////
 /////////////////////////////////////////////
 
 static Error_t _libconfig_generic_lookup( config_setting_t *parent_setting, const char *path, int expected_type, void *parsed_value );
+static Error_t _libconfig_get_float( const config_setting_t *setting, float range_min, float range_max, float *parsed_value );
+static Error_t _libconfig_get_int( const config_setting_t *setting, int range_min, int range_max, int *parsed_value );
 static Error_t _libconfig_get_setting_name( const config_setting_t *setting, const char **found_name );
+static Error_t _libconfig_get_string( const config_setting_t *setting, const char **parsed_value );
+static Error_t _libconfig_get_uint( const config_setting_t *setting, unsigned int range_min, unsigned int range_max, unsigned int *parsed_value );
+static Error_t _libconfig_get_value( const config_setting_t *setting, int expected_type, void *parsed_value );
 static Error_t _libconfig_lookup_float( config_setting_t *parent_setting, const char *path, float range_min, float range_max, float *parsed_value );
 static Error_t _libconfig_lookup_int( config_setting_t *parent_setting, const char *path, int range_min, int range_max, int *parsed_value );
 static Error_t _libconfig_lookup_string( config_setting_t *parent_setting, const char *path, const char **parsed_value );
 static Error_t _libconfig_lookup_uint( config_setting_t *parent_setting, const char *path, unsigned int range_min, unsigned int range_max, unsigned int *parsed_value );
+static void *_parser_arena_alloc( Arena_t *arena, size_t count, size_t size );
+static void _parser_arena_finish( Arena_t *arena );
+static void _parser_build_bind_index( Bind_Index_t *index, const void *binds, unsigned int binds_count, uint64_t ( *bind_hash )( unsigned int bind_index ) );
+static Error_t _parser_build_rule_automaton( Rule_Automaton_t *automaton, Rule_Field_t field );
+static uint64_t _parser_buttonbind_hash( unsigned int click, unsigned int button, unsigned int modifier );
+static uint64_t _parser_buttonbind_index_hash( unsigned int bind_index );
+static int _parser_compare_uint( const void *a, const void *b );
+static size_t _parser_data_type_size( Data_Type_t type );
+static void _parser_destroy_config( void );
+static int _parser_find_alias( Alias_Index_t *index, const char *alias );
+static int _parser_find_member( Member_Index_t *index, const char *name );
+static uint64_t _parser_fnv1a_hash( const void *data, size_t length, uint64_t hash );
+static void _parser_free_arena( Arena_t *arena );
+static void _parser_free_bind_index( Bind_Index_t *index );
+static void _parser_free_rule_matcher( Rule_Matcher_t *matcher );
+static Error_t _parser_intern_string( const char **string );
+static uint64_t _parser_keybind_hash( KeySym keysym, unsigned int modifier );
+static uint64_t _parser_keybind_index_hash( unsigned int bind_index );
+static void _parser_log_report( const char *action, const Errors_t *errors, bool snapshot_loaded );
+static Arena_t *_parser_new_arena( void );
+static config_t *_parser_new_config( void );
+static Error_t _parser_read_source_info( FILE *file, Source_Info_t *source_info );
+static void _parser_reset_report( void );
+static unsigned int _parser_rule_automaton_child( const Rule_Automaton_t *automaton, unsigned int node, unsigned char byte );
+static const char *_parser_rule_field( const Rule *rule, Rule_Field_t field );
+static void _parser_scan_rule_automaton( Rule_Matcher_t *matcher, Rule_Automaton_t *automaton, const char *string );
+static Error_t _parser_snapshot_add_string( Snapshot_Strings_t *strings, const char *string, uint32_t *offset );
+static uint64_t _parser_snapshot_fixed_size( const Snapshot_Header_t *header );
+static Error_t _parser_snapshot_layout( void *image, uint64_t image_size, Snapshot_Layout_t *layout );
+static Error_t _parser_snapshot_pack_argument( Snapshot_Strings_t *strings, void ( *function )( const Arg * ), const Arg *argument, uint32_t *function_index, uint64_t *packed_argument );
+static uint64_t _parser_snapshot_schema_hash( void );
+static Error_t _parser_snapshot_string( const Snapshot_Layout_t *layout, uint64_t offset, const char **string );
+static Error_t _parser_snapshot_unpack_argument( const Snapshot_Layout_t *layout, uint32_t function_index, uint64_t packed_argument, void ( **function )( const Arg * ), Arg *argument );
+static uint64_t _parser_time_now( void );
+static Error_t _parser_tokenize_command( const char *command, const Spawn_Command_t **tokenized );
 
 /////////////////////////////
 ///// Parser alias maps /////
@@ -363,6 +853,7 @@ static const Button_Alias_Map_t BUTTON_ALIAS_MAP[ ] = {
 
 /** @brief Default alias map for dwm's arg functions. */
 static const Function_Alias_Map_t FUNCTION_ALIAS_MAP[ ] = {
+	{ "cycletheme", cycletheme, TYPE_INT, -99, 99 },
 	{ "focusmon", focusmon, TYPE_INT, -99, 99 },
 	{ "focusstack", focusstack, TYPE_INT, -99, 99 },
 	{ "incnmaster", incnmaster, TYPE_INT, -99, 99 },
@@ -370,12 +861,14 @@ static const Function_Alias_Map_t FUNCTION_ALIAS_MAP[ ] = {
 	{ "movemouse", movemouse, TYPE_NONE },
 	{ "quit", quit, TYPE_NONE },
 	{ "resizemouse", resizemouse, TYPE_NONE },
+	{ "restart", restart, TYPE_NONE },
 	{ "setlayout-tiled", setlayout_tiled, TYPE_NONE },
 	{ "setlayout-floating", setlayout_floating, TYPE_NONE },
 	{ "setlayout-monocle", setlayout_monocle, TYPE_NONE },
 	{ "setlayout-toggle", setlayout, TYPE_NONE },
 	{ "setmfact", setmfact, TYPE_FLOAT, -0.95f, 1.95f },
-	{ "spawn", spawn_string, TYPE_STRING },
+	{ "settheme", settheme, TYPE_UINT, 0, 99 },
+	{ "spawn", spawn_string, TYPE_COMMAND },
 	{ "tag", tag, TYPE_INT, -1, TAGMASK },
 	{ "tagmon", tagmon, TYPE_INT, -99, 99 },
 	{ "togglebar", togglebar, TYPE_NONE },
@@ -412,6 +905,8 @@ static const Setting_Alias_Map_t SETTING_ALIAS_MAP[ ] = {
 	{ "snap", &snap, TYPE_UINT, true, 0, 9999 },
 	{ "nmaster", &nmaster, TYPE_UINT, true, 0, 99 },
 	{ "refreshrate", &refreshrate, TYPE_UINT, true, 0, 999 },
+	{ "statusrate", &statusrate, TYPE_UINT, true, 0, 999 },
+	{ "ipcsocket", &ipcsocket, TYPE_STRING, true },
 	{ "mfact", &mfact, TYPE_FLOAT, true, 0.05f, 0.95f },
 };
 
@@ -425,2000 +920,4768 @@ static const Theme_Alias_Map_t THEME_ALIAS_MAP[ ] = {
 	{ "selected-border", &colors[ SchemeSel ][ ColBorder ] },
 };
 
+/** @brief Schema of a keybind's members, see @ref _parse_keybind(). */
+static const Member_Schema_t KEYBIND_SCHEMA[ ] = {
+	{ "modifier", MEMBER_MODIFIER, offsetof( Key, mod ) },
+	{ "key", MEMBER_KEYSYM, offsetof( Key, keysym ) },
+	{ "function", MEMBER_FUNCTION, offsetof( Key, func ) },
+	{ "argument", MEMBER_ARGUMENT, offsetof( Key, arg ) },
+};
+
+/** @brief Schema of a buttonbind's members, see @ref _parse_buttonbind(). */
+static const Member_Schema_t BUTTONBIND_SCHEMA[ ] = {
+	{ "modifier", MEMBER_MODIFIER, offsetof( Button, mask ) },
+	{ "button", MEMBER_BUTTON, offsetof( Button, button ) },
+	{ "click", MEMBER_CLICK, offsetof( Button, click ) },
+	{ "function", MEMBER_FUNCTION, offsetof( Button, func ) },
+	{ "argument", MEMBER_ARGUMENT, offsetof( Button, arg ) },
+};
+
+// "floating" logically should be a boolean value, but I didn't want to
+// deviate from the coded type, so I kept it an int and range check it.
+/** @brief Schema of a rule's members, see @ref _parse_rule(). */
+static const Member_Schema_t RULE_SCHEMA[ ] = {
+	{ "class", MEMBER_STRING, offsetof( Rule, class ) },
+	{ "instance", MEMBER_STRING, offsetof( Rule, instance ) },
+	{ "title", MEMBER_STRING, offsetof( Rule, title ) },
+	{ "tag-mask", MEMBER_UINT, offsetof( Rule, tags ), 0, TAGMASK },
+	{ "monitor", MEMBER_INT, offsetof( Rule, monitor ), -1, 99 },
+	{ "floating", MEMBER_INT, offsetof( Rule, isfloating ), 0, 1 },
+};
+
+static Alias_Index_t BUTTON_ALIAS_INDEX = ALIAS_INDEX( BUTTON_ALIAS_MAP );     ///< Sorted index over @ref BUTTON_ALIAS_MAP.
+static Alias_Index_t CLICK_ALIAS_INDEX = ALIAS_INDEX( CLICK_ALIAS_MAP );       ///< Sorted index over @ref CLICK_ALIAS_MAP.
+static Alias_Index_t FUNCTION_ALIAS_INDEX = ALIAS_INDEX( FUNCTION_ALIAS_MAP ); ///< Sorted index over @ref FUNCTION_ALIAS_MAP.
+static Alias_Index_t MODIFIER_ALIAS_INDEX = ALIAS_INDEX( MODIFIER_ALIAS_MAP ); ///< Sorted index over @ref MODIFIER_ALIAS_MAP.
+
+static Member_Index_t BUTTONBIND_SCHEMA_INDEX = MEMBER_INDEX( BUTTONBIND_SCHEMA ); ///< Hashed index over @ref BUTTONBIND_SCHEMA.
+static Member_Index_t KEYBIND_SCHEMA_INDEX = MEMBER_INDEX( KEYBIND_SCHEMA );       ///< Hashed index over @ref KEYBIND_SCHEMA.
+static Member_Index_t RULE_SCHEMA_INDEX = MEMBER_INDEX( RULE_SCHEMA );             ///< Hashed index over @ref RULE_SCHEMA.
+static Member_Index_t THEME_MEMBER_INDEX = MEMBER_INDEX( THEME_ALIAS_MAP );        ///< Hashed index over the colors of @ref THEME_ALIAS_MAP.
+
 ///////////////////////////////////
 ///// Public parser functions /////
 ///////////////////////////////////
 
+/**
+ * @brief Compile @ref rules into the matcher used by @ref first_rule().
+ *
+ * Builds an automaton over the class, instance, and title of every rule. This is done every
+ * time the configuration is parsed, reloaded, or reverted, and lazily whenever the matcher
+ * turns out to be stale. If memory for the matcher fails to be allocated, matching falls
+ * back to comparing every rule.
+ */
+void compile_rules( void ) {
+
+	Rule_Matcher_t *matcher = &_parser_rule_matcher;
+
+	_parser_free_rule_matcher( matcher );
+
+	matcher->rules = rules;
+	matcher->rules_count = rules_count;
+
+	errno = 0;
+	matcher->required = calloc( rules_count + 1, sizeof( unsigned char ) );
+	matcher->found = calloc( rules_count + 1, sizeof( unsigned char ) );
+	matcher->found_stamp = calloc( rules_count + 1, sizeof( unsigned int ) );
+	matcher->matches = calloc( rules_count + 1, sizeof( unsigned int ) );
+	matcher->always = calloc( rules_count + 1, sizeof( unsigned int ) );
+
+	bool compiled = matcher->required != NULL && matcher->found != NULL && matcher->found_stamp != NULL && matcher->matches != NULL && matcher->always != NULL;
+
+	for ( unsigned int i = 0; compiled && i < RULE_FIELD_LENGTH; i++ ) {
+		compiled = _parser_build_rule_automaton( &matcher->automata[ i ], i ) == ERROR_NONE;
+	}
+
+	if ( compiled == false ) {
+		LOG_WARN( "%s using calloc(), rules will be matched linearly: %s\n", FAILED_ALLOC_PRINT_STRING, strerror( errno ) );
+		_parser_free_rule_matcher( matcher );
+		matcher->rules = rules;
+		matcher->rules_count = rules_count;
+		return;
+	}
+
+	for ( unsigned int i = 0; i < rules_count; i++ ) {
+		for ( unsigned int j = 0; j < RULE_FIELD_LENGTH; j++ ) {
+			const char *pattern = _parser_rule_field( &rules[ i ], j );
+
+			// An empty pattern is found in every string, so it is never required
+			if ( pattern != NULL && pattern[ 0 ] != '\0' ) matcher->required[ i ]++;
+		}
+
+		if ( matcher->required[ i ] == 0 ) matcher->always[ matcher->always_count++ ] = i;
+	}
+}
+
 /**
  * @brief Frees dynamically allocated parser data.
  *
  * Frees all dynamically allocated data allocated
  * during the parsing process. Intended for use
  * before program exit and after @ref parse_config().
+ * The hardcoded default configuration is made live
+ * again afterward.
  */
 void config_cleanup( void ) {
 
 	if ( config_filepath != NULL ) free( config_filepath );
+	config_filepath = NULL;
 
-	if ( rules_malloced == false ) free( rules );
-	if ( keys_malloced == false ) free( keys );
-	if ( buttons_malloced == false ) free( buttons );
-	if ( fonts_malloced == false ) free( fonts );
+	// Capturing only fails to copy the settings, which is fine as they are not freed anyway
+	Config_Generation_t live_generation = { 0 };
+	_parser_capture_generation( &live_generation );
+	free_config_generation( &live_generation );
 
-	config_destroy( &libconfig_config );
+	_parser_apply_generation( &_parser_default_generation );
+	free( _parser_default_generation.settings );
+	_parser_default_generation.settings = NULL;
+
+	_parser_free_bind_index( &_parser_key_index );
+	_parser_free_bind_index( &_parser_button_index );
+	_parser_free_rule_matcher( &_parser_rule_matcher );
+
+	free( _parser_watch_filename );
+	_parser_watch_filename = NULL;
+
+	if ( _parser_watch_fd != -1 ) close( _parser_watch_fd );
+	_parser_watch_fd = -1;
+	_parser_watch_descriptor = -1;
 }
 
 /**
- * @brief Parse program configuration from a configuration file.
- *
- * This function serves as the entry point into the configuration parser of the
- * [dwm-libconfig patch](https://github.com/JeffofBread/dwm-libconfig). This function
- * serves as a high level entry to the configuration parser. It largely calls helper
- * functions to handle the actual parsing of the configuration file in various segmented
- * and modular steps.
- *
- * For more information on the specific details on what actions the parser performs,
- * please reference the helper function related to the functionality you want to learn
- * more about, they all have their own documentation and comments.
+ * @brief Start watching the loaded configuration file for changes.
  *
- * @return An @ref Errors_t struct containing all collected errors (including @ref ERROR_NONE)
- * while parsing the configuration. See @ref Error_t for a list of possible error types.
+ * This function sets up an inotify watch on the directory containing @ref config_filepath
+ * (after resolving symlinks), rather than on the file itself. Most editors save by writing
+ * a new file and renaming it over the old one, which would silently end a watch on the file.
+ * The returned file descriptor becomes readable when the directory changes, at which point
+ * @ref config_watch_triggered() tells whether it was the configuration file that changed.
  *
- * @todo Polish the status texts a little. I like the idea but could be refined.
- * @todo Backup config file logic is clumsily structured, it should be improved. It also probably should include rules_malloced
+ * @return A non-blocking file descriptor to poll for readability, or -1 if the configuration
+ * file can't be watched. Watching is only supported on Linux.
  */
-Errors_t parse_config( void ) {
-
-	Errors_t returned_errors = { 0 };
+int config_watch( void ) {
 
-	config_init( &libconfig_config );
+	#ifdef __linux__
+	RETURN_VALUE_IF_NULL( config_filepath, -1, "No config file was loaded, nothing to watch\n" );
 
-	bool fallback_config_loaded = false;
-	const char *custom_config_filepath = config_filepath;
-	config_filepath = NULL;
-	copy_errors( &returned_errors, _parser_open_config_file( &libconfig_config, custom_config_filepath, &config_filepath, &fallback_config_loaded ) );
+	if ( _parser_watch_fd == -1 ) {
+		errno = 0;
+		_parser_watch_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
 
-	// Exit the parser if we haven't acquired a configuration file.
-	// Without a configuration file, there isn't a reason to continue parsing.
-	// The program will have to rely on the hardcoded default values instead.
-	if ( config_filepath == NULL ) {
-		LOG_ERROR( "Unable to load any configs. Hardcoded default config values will be used. Exiting parsing\n" );
-		SET_STATUS_TEXT( "Failed to load config file" );
-		config_destroy( &libconfig_config );
-		return returned_errors;
+		if ( _parser_watch_fd == -1 ) {
+			LOG_WARN( "Failed to initialize inotify, config file will not be watched for changes: %s\n", strerror( errno ) );
+			return -1;
+		}
 	}
 
-	LOG_INFO( "Path to config file: \"%s\"\n", config_filepath );
+	errno = 0;
+	char *resolved_filepath = realpath( config_filepath, NULL );
 
-	config_set_options( &libconfig_config, CONFIG_OPTION_AUTOCONVERT | CONFIG_OPTION_SEMICOLON_SEPARATORS );
+	RETURN_VALUE_IF_NULL( resolved_filepath, -1, "Failed to resolve config file path \"%s\": %s\n", config_filepath, strerror( errno ) );
 
-	Errors_t parsing_errors = { 0 };
+	// realpath() always returns an absolute path, so there is always a slash
+	char *last_slash = strrchr( resolved_filepath, '/' );
+	free( _parser_watch_filename );
+	_parser_watch_filename = estrdup( last_slash + 1 );
+	*last_slash = '\0';
 
-	copy_errors( &parsing_errors, _parse_generic_settings( &libconfig_config ) );
-	copy_errors( &parsing_errors, _parse_keybinds_config( &libconfig_config, &keys, &keys_count, &keys_malloced ) );
-	copy_errors( &parsing_errors, _parse_buttonbinds_config( &libconfig_config, &buttons, &buttons_count, &buttons_malloced ) );
-	copy_errors( &parsing_errors, _parse_rules_config( &libconfig_config, &rules, &rules_count, &rules_malloced ) );
-	copy_errors( &parsing_errors, _parse_tags_config( &libconfig_config ) );
-	copy_errors( &parsing_errors, _parse_theme_config( &libconfig_config ) );
+	const char *directory = last_slash == resolved_filepath ? "/" : resolved_filepath;
 
-	// The error requirement being 0 may be a bit strict, I am not sure. May need
-	// some relaxing or possibly come up with a better way of calculating if a config
-	// passes, or is valid enough to warrant backing up.
-	if ( errors_failure_count( &parsing_errors ) == 0 && keys_malloced && buttons_malloced && !fallback_config_loaded ) {
-		const Error_t backup_error = _parser_backup_config( &libconfig_config );
-		add_error( &parsing_errors, backup_error );
-	} else {
-		if ( keys_malloced == false || buttons_malloced == false ) {
-			LOG_WARN( "Not saving config as backup, as hardcoded default bind values were used, not the user's\n" );
-		}
-		if ( fallback_config_loaded == true ) {
-			LOG_WARN( "Not saving config as backup, as the parsed configuration file is a system fallback configuration\n" );
-		}
-		if ( errors_failure_count( &parsing_errors ) != 0 ) {
-			LOG_WARN( "Not saving config as backup, as the parsed config had too many (%d) errors\n", errors_failure_count( &parsing_errors ) );
-		}
-	}
+	if ( _parser_watch_descriptor != -1 ) inotify_rm_watch( _parser_watch_fd, _parser_watch_descriptor );
 
-	copy_errors( &returned_errors, parsing_errors );
-	LOG_DEBUG( "Parsing errors: %d, Total errors: %d\n", errors_failure_count( &parsing_errors ), errors_failure_count( &returned_errors ) );
+	errno = 0;
+	_parser_watch_descriptor = inotify_add_watch( _parser_watch_fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO );
 
-	SET_STATUS_TEXT( "%s | Errors: %u", config_filepath, errors_failure_count( &returned_errors ) );
+	if ( _parser_watch_descriptor == -1 || _parser_watch_filename == NULL ) {
+		LOG_WARN( "Failed to watch \"%s\" for changes: %s\n", directory, strerror( errno ) );
+		free( resolved_filepath );
+		return -1;
+	}
 
-	return returned_errors;
-}
+	LOG_INFO( "Watching config file \"%s\" for changes\n", config_filepath );
+	free( resolved_filepath );
 
-////////////////////////////////////
-///// Public utility functions /////
-////////////////////////////////////
+	return _parser_watch_fd;
+	#else
+	LOG_INFO( "Config file watching is only supported on Linux\n" );
+	return -1;
+	#endif
+}
 
 /**
- * @brief Adds an error to an @ref Errors_t struct.
+ * @brief Checks whether the watched configuration file changed.
  *
- * This function acts as a simple way to increment the error
- * count of an @ref Errors_t struct at the correct error index.
+ * This function drains every pending event from the watch set up by @ref config_watch(),
+ * so one burst of writes from an editor only results in a single reload.
  *
- * @param[out] errors Pointer to an @ref Errors_t struct to add @p error to.
- * @param[in] error Error to be added to the error count in @p errors.
+ * @return `true` if the configuration file was written or replaced since the last call, else `false`.
  */
-void add_error( Errors_t *errors, const Error_t error ) {
+bool config_watch_triggered( void ) {
 
-	RETURN_IF_NULL( errors, "%s:\"errors\"\n", POINTER_NULL_PRINT_STRING );
+	bool triggered = false;
 
-	if ( error < ERROR_ENUM_LENGTH ) {
-		errors->errors_count[ error ]++;
+	#ifdef __linux__
+	if ( _parser_watch_fd == -1 || _parser_watch_filename == NULL ) return false;
+
+	union {
+		struct inotify_event event;
+		char buffer[ 4096 ];
+	} events;
+
+	ssize_t length = 0;
+	while ( ( length = read( _parser_watch_fd, events.buffer, sizeof( events.buffer ) ) ) > 0 ) {
+		for ( const char *walk = events.buffer; walk < events.buffer + length; ) {
+			const struct inotify_event *event = (const struct inotify_event *) walk;
+
+			if ( event->wd == _parser_watch_descriptor && event->len > 0 && strcmp( event->name, _parser_watch_filename ) == 0 ) {
+				triggered = true;
+			}
+
+			walk += sizeof( struct inotify_event ) + event->len;
+		}
 	}
+	#endif
+
+	return triggered;
 }
 
 /**
- * @brief Copy errors from @p source to @p destination.
+ * @brief Find the first buttonbind bound to a click.
  *
- * This function copies the errors in @p source to the @ref Errors_t
- * struct pointed to by @p destination. It does not alter the errors
- * in @p source. If the pointer to @p destination is NULL, an error
- * will be logged and the function will return.
+ * Looks up the buttonbinds bound to @p click, @p button and @p modifier in the index built
+ * by @ref index_binds(), comparing modifiers the same way dwm does, through CLEANMASK().
+ * Together with @ref next_buttonbind(), every matching buttonbind is visited in the order
+ * it was configured:
  *
- * @param[out] destination Pointer to where to copy errors to.
- * @param[in] source Errors to copy.
+ * @code
+ * for ( i = first_buttonbind( click, button, state ); i < buttons_count; i = next_buttonbind( i, click, button, state ) )
+ * @endcode
+ *
+ * @param[in] click Click enum of the clicked element.
+ * @param[in] button X11 button that was pressed.
+ * @param[in] modifier X11 modifier state at the time of the press.
+ *
+ * @return The index of the first matching element of @ref buttons, or @ref buttons_count if none match.
  */
-void copy_errors( Errors_t *destination, const Errors_t source ) {
+unsigned int first_buttonbind( const unsigned int click, const unsigned int button, const unsigned int modifier ) {
 
-	RETURN_IF_NULL( destination, "%s:\"destination\"\n", POINTER_NULL_PRINT_STRING );
+	if ( _parser_button_index.binds != buttons || _parser_button_index.binds_count != buttons_count || _parser_button_index.numlockmask != numlockmask ) index_binds();
 
-	for ( unsigned int i = 0; i < ERROR_ENUM_LENGTH; i++ ) {
-		destination->errors_count[ i ] += source.errors_count[ i ];
-	}
+	if ( _parser_button_index.buckets == NULL ) return next_buttonbind( UINT_MAX, click, button, modifier ); // Wraps around to the first buttonbind
+
+	const unsigned int first = _parser_button_index.buckets[ _parser_buttonbind_hash( click, button, CLEANMASK( modifier ) ) & _parser_button_index.bucket_mask ];
+
+	if ( first >= buttons_count ) return buttons_count;
+
+	if ( buttons[ first ].click == click && buttons[ first ].button == button && CLEANMASK( buttons[ first ].mask ) == CLEANMASK( modifier ) ) return first;
+
+	return next_buttonbind( first, click, button, modifier );
 }
 
 /**
- * @brief Counts the number of failure errors present in an @ref Errors_t struct.
+ * @brief Find the first keybind bound to a chord.
  *
- * This function acts as a simple way to count the number of failure errors
- * present in an @ref Errors_t struct.
+ * Looks up the keybinds bound to @p keysym and @p modifier in the index built by
+ * @ref index_binds(), comparing modifiers the same way dwm does, through CLEANMASK().
+ * Together with @ref next_keybind(), every matching keybind is visited in the order
+ * it was configured:
  *
- * @param[in] errors Pointer to an @ref Errors_t struct to count errors from.
+ * @code
+ * for ( i = first_keybind( keysym, state ); i < keys_count; i = next_keybind( i, keysym, state ) )
+ * @endcode
  *
- * @return -1 if @p errors is NULL, else the total of the number of failure
- * errors present in @p errors.
+ * @param[in] keysym X11 keysym of the pressed key.
+ * @param[in] modifier X11 modifier state at the time of the press.
+ *
+ * @return The index of the first matching element of @ref keys, or @ref keys_count if none match.
  */
-int errors_failure_count( const Errors_t *errors ) {
+unsigned int first_keybind( const KeySym keysym, const unsigned int modifier ) {
 
-	RETURN_VALUE_IF_NULL( errors, -1, "%s:\"errors\"\n", POINTER_NULL_PRINT_STRING );
+	if ( _parser_key_index.binds != keys || _parser_key_index.binds_count != keys_count || _parser_key_index.numlockmask != numlockmask ) index_binds();
 
-	int count = 0;
+	if ( _parser_key_index.buckets == NULL ) return next_keybind( UINT_MAX, keysym, modifier ); // Wraps around to the first keybind
 
-	for ( unsigned int i = ERROR_NONE + 1; i < ERROR_ENUM_LENGTH; i++ ) {
-		count += (int) errors->errors_count[ i ];
-	}
+	const unsigned int first = _parser_key_index.buckets[ _parser_keybind_hash( keysym, CLEANMASK( modifier ) ) & _parser_key_index.bucket_mask ];
 
-	return count;
+	if ( first >= keys_count ) return keys_count;
+
+	if ( keys[ first ].keysym == keysym && CLEANMASK( keys[ first ].mod ) == CLEANMASK( modifier ) ) return first;
+
+	return next_keybind( first, keysym, modifier );
 }
 
 /**
- * @brief Simple wrapper around `strdup()` to provide error logging.
+ * @brief Find the first rule matching a window.
  *
- * This function acts as a simple wrapper around `strdup()` that provides
- * some NULL safety as well as error logging around `strdup()`. It can
- * be used as a drop in replacement for `strdup()` safely.
+ * Matches the window against the matcher built by @ref compile_rules(), with the same result
+ * as checking whether each non NULL field of every rule is a substring of the window's matching
+ * string. Together with @ref next_rule(), every matching rule is visited in configuration order,
+ * so later rules still override earlier ones:
  *
- * @param[in] string String to be copied.
+ * @code
+ * for ( i = first_rule( class, instance, title ); i < rules_count; i = next_rule( i ) )
+ * @endcode
  *
- * @return NULL if allocation failed or @p string was NULL, or the pointer
- * to a dynamically allocated duplicate of @p string.
+ * @param[in] class Class of the window.
+ * @param[in] instance Instance of the window.
+ * @param[in] title Title of the window.
  *
- * @note Returned string is dynamically allocated and will need to be manually freed.
+ * @return The index of the first matching element of @ref rules, or @ref rules_count if none match.
+ *
+ * @warning Only one match can be iterated at a time, calling this again restarts @ref next_rule().
  */
-char *estrdup( const char *string ) {
+unsigned int first_rule( const char *class, const char *instance, const char *title ) {
 
-	RETURN_VALUE_IF_NULL( string, NULL, "%s:\"string\"\n", POINTER_NULL_PRINT_STRING );
+	Rule_Matcher_t *matcher = &_parser_rule_matcher;
 
-	errno = 0;
-	char *return_string = strdup( string );
+	if ( matcher->rules != rules || matcher->rules_count != rules_count ) compile_rules();
 
-	RETURN_VALUE_IF_NULL( return_string, NULL, "%s using strdup(): %s\n", FAILED_ALLOC_PRINT_STRING, strerror(errno) );
+	matcher->strings[ RULE_FIELD_CLASS ] = class;
+	matcher->strings[ RULE_FIELD_INSTANCE ] = instance;
+	matcher->strings[ RULE_FIELD_TITLE ] = title;
 
-	return return_string;
+	if ( matcher->matches == NULL ) return next_rule( UINT_MAX ); // Wraps around to the first rule
+
+	if ( ++matcher->stamp == 0 ) {
+		// Start over once the stamp wraps, so no stale stamp can ever match
+		memset( matcher->found_stamp, 0, rules_count * sizeof( unsigned int ) );
+		for ( unsigned int i = 0; i < RULE_FIELD_LENGTH; i++ ) {
+			for ( unsigned int j = 0; j < matcher->automata[ i ].nodes_count; j++ ) matcher->automata[ i ].nodes[ j ].seen = 0;
+		}
+		matcher->stamp = 1;
+	}
+
+	memcpy( matcher->matches, matcher->always, matcher->always_count * sizeof( unsigned int ) );
+	matcher->matches_count = matcher->always_count;
+
+	for ( unsigned int i = 0; i < RULE_FIELD_LENGTH; i++ ) {
+		_parser_scan_rule_automaton( matcher, &matcher->automata[ i ], matcher->strings[ i ] );
+	}
+
+	qsort( matcher->matches, matcher->matches_count, sizeof( unsigned int ), _parser_compare_uint );
+
+	return matcher->matches_count > 0 ? matcher->matches[ 0 ] : rules_count;
 }
 
 /**
- * @brief Extend one string with another.
- *
- * This function reallocates and extends the string pointed to by @p source_string with the string @p addition.
- * If either the pointer to @p source_string or @p addition are NULL, the function will log an error and return.
- * If the string at @p source_string is NULL, @p addition will be copied into it's place using dynamic allocation.
- * If all succeeds, then the string pointed to by @p source_string will be dynamically reallocated to contain both
- * the source string and @p addition, and will need to be freed manually.
- *
- * @param[in,out] source_string Pointer to the string to be extended with @p addition. Must point to a NULL or heap allocated string.
- * @param[in] addition Additional string to be appended to the string pointed to by @p source_string.
- *
- * @warning String at @p source_string must be NULL or heap allocated. If it points to a string literal,
- * `realloc()` will crash the program. See @ref join_strings() if you wish to append a string literal.
+ * @brief Frees a configuration generation.
  *
- * @note
- * 	-# @p source_string is or will be dynamically allocated and must be manually freed.
- * 	-# This function is derived from [picom's](https://github.com/yshui/picom/) `mstrextend()`.
- * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ * Frees the arena holding every array and string owned by @p generation, along
+ * with its copy of the settings. The generation is zeroed afterward, so freeing
+ * it again does nothing.
  *
- * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ * @param[in,out] generation Pointer to the configuration generation to free.
  *
- * @see https://github.com/yshui/picom
- * @see https://github.com/yshui/picom/blob/69539edc0638019e3dd88c67007e90ce7f51174e/src/utils/str.c#L54
+ * @warning @p generation must not be the live configuration, see @ref reload_config().
  */
-void extend_string( char **source_string, const char *addition ) {
+void free_config_generation( Config_Generation_t *generation ) {
 
-	RETURN_IF_NULL( source_string, "%s:\"source_string\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_IF_NULL( addition, "%s:\"addition\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_IF_NULL( generation, "%s:\"generation\"\n", POINTER_NULL_PRINT_STRING );
 
-	if ( *source_string == NULL ) {
-		*source_string = estrdup( addition );
-		LOG_DEBUG( "Source string was NULL, addition was copied into its place\n" );
-		return;
-	}
+	_parser_free_arena( generation->arena );
 
-	const size_t source_length = strlen( *source_string );
-	const size_t addition_length = strlen( addition );
-	const size_t total_length = source_length + addition_length + 1; // +1 for NULL termination
+	free( generation->settings );
 
-	errno = 0;
-	*source_string = realloc( *source_string, total_length * sizeof( char ) );
+	memset( generation, 0, sizeof( *generation ) );
+}
 
-	RETURN_IF_NULL( *source_string, "%s (%lu bytes) using realloc(): %s\n", FAILED_ALLOC_PRINT_STRING, total_length * sizeof( char ), strerror(errno) );
+/**
+ * @brief Build the dispatch indexes over @ref keys and @ref buttons.
+ *
+ * Rebuilds the indexes used by @ref first_keybind() and @ref first_buttonbind(). This is
+ * done every time the configuration is parsed, reloaded, or reverted, and lazily whenever
+ * the indexes turn out to be stale, like after numlockmask changes. If memory for an index
+ * fails to be allocated, lookups on it fall back to a linear scan.
+ */
+void index_binds( void ) {
 
-	strncpy( *source_string + source_length, addition, addition_length );
-	( *source_string )[ total_length - 1 ] = '\0';
+	_parser_build_bind_index( &_parser_key_index, keys, keys_count, _parser_keybind_index_hash );
+	_parser_build_bind_index( &_parser_button_index, buttons, buttons_count, _parser_buttonbind_index_hash );
 }
 
 /**
- * @brief Find and return a layout that uses a specific arrange function.
- *
- * This function searches the global array `layouts` for a layout struct that contains
- * @p arrange. If it is found, a pointer to it is returned, else NULL is returned.
+ * @brief Find the next buttonbind bound to a click.
  *
- * @param[in] arrange Arrange function used by the layout to be found and returned.
+ * See @ref first_buttonbind().
  *
- * @return Pointer to the found layout or NULL if no layout containing @p arrange was found.
+ * @param[in] index Index of the previous matching element of @ref buttons.
+ * @param[in] click Click enum of the clicked element.
+ * @param[in] button X11 button that was pressed.
+ * @param[in] modifier X11 modifier state at the time of the press.
  *
- * @note This function assumes that only one layout uses the given arrange
- * function. If multiple layouts use the same arrange function, then this
- * function will simply return the first one in the array using that arrange
- * function.
+ * @return The index of the next matching element of @ref buttons, or @ref buttons_count if there is none.
  */
-const Layout *get_layout( void ( *arrange )( Monitor * ) ) {
+unsigned int next_buttonbind( unsigned int index, const unsigned int click, const unsigned int button, const unsigned int modifier ) {
 
-	for ( unsigned int i = 0; i < LENGTH( layouts ); i++ ) {
-		if ( layouts[ i ].arrange == arrange ) {
-			return &layouts[ i ];
-		}
-	}
+	do {
+		// Without an index, the bucket is every buttonbind
+		index = _parser_button_index.buckets != NULL ? _parser_button_index.next[ index ] : index + 1;
+	} while ( index < buttons_count && ( buttons[ index ].click != click || buttons[ index ].button != button || CLEANMASK( buttons[ index ].mask ) != CLEANMASK( modifier ) ) );
 
-	return NULL;
+	return index < buttons_count ? index : buttons_count;
 }
 
 /**
- * @brief Get the user's XDG configuration directory path.
+ * @brief Find the next keybind bound to a chord.
  *
- * TODO
+ * See @ref first_keybind().
  *
- * @return Pointer of a dynamically allocated string containing the complete path to the user's XDG
- * configuration directory, or NULL if no directory was able to be found.
+ * @param[in] index Index of the previous matching element of @ref keys.
+ * @param[in] keysym X11 keysym of the pressed key.
+ * @param[in] modifier X11 modifier state at the time of the press.
  *
- * @note
- * 	-# If the function is successful, the returned string will have been dynamically allocated
- * and will need to be manually freed.
- * 	-# This function is derived from [picom's](https://github.com/yshui/picom/) `xdg_config_home()`.
- * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ * @return The index of the next matching element of @ref keys, or @ref keys_count if there is none.
+ */
+unsigned int next_keybind( unsigned int index, const KeySym keysym, const unsigned int modifier ) {
+
+	do {
+		// Without an index, the bucket is every keybind
+		index = _parser_key_index.buckets != NULL ? _parser_key_index.next[ index ] : index + 1;
+	} while ( index < keys_count && ( keys[ index ].keysym != keysym || CLEANMASK( keys[ index ].mod ) != CLEANMASK( modifier ) ) );
+
+	return index < keys_count ? index : keys_count;
+}
+
+/**
+ * @brief Find the next rule matching the window passed to @ref first_rule().
  *
- * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ * @param[in] index Index of the previous matching element of @ref rules.
  *
- * @see https://github.com/yshui/picom
- * @see https://github.com/yshui/picom/blob/69539edc0638019e3dd88c67007e90ce7f51174e/src/config.c#L33
+ * @return The index of the next matching element of @ref rules, or @ref rules_count if there is none.
  */
-char *get_xdg_config_home( void ) {
+unsigned int next_rule( unsigned int index ) {
 
-	char *xdg_config_home = getenv( "XDG_CONFIG_HOME" );
-	const char *user_home = getenv( "HOME" );
+	const Rule_Matcher_t *matcher = &_parser_rule_matcher;
 
-	LOG_DEBUG( "XDG_CONFIG_HOME: \"%s\", HOME: \"%s\"\n", xdg_config_home, user_home );
+	if ( matcher->matches == NULL ) {
+		const char *class = matcher->strings[ RULE_FIELD_CLASS ], *instance = matcher->strings[ RULE_FIELD_INSTANCE ], *title = matcher->strings[ RULE_FIELD_TITLE ];
 
-	if ( xdg_config_home == NULL ) {
-		const char *default_config_directory = "/.config";
+		while ( ++index < rules_count ) {
+			const Rule *rule = &rules[ index ];
 
-		RETURN_VALUE_IF_NULL( user_home, NULL, "XDG_CONFIG_HOME and HOME are not set\n" );
+			if ( ( !rule->title || strstr( title, rule->title ) ) && ( !rule->class || strstr( class, rule->class ) ) && ( !rule->instance || strstr( instance, rule->instance ) ) ) {
+				return index;
+			}
+		}
 
-		xdg_config_home = join_strings( user_home, default_config_directory );
-	} else {
-		xdg_config_home = estrdup( xdg_config_home );
+		return rules_count;
 	}
 
-	return xdg_config_home;
+	const unsigned int *found = bsearch( &index, matcher->matches, matcher->matches_count, sizeof( unsigned int ), _parser_compare_uint );
+
+	if ( found == NULL || found + 1 >= matcher->matches + matcher->matches_count ) return rules_count;
+
+	return *( found + 1 );
 }
 
 /**
- * @brief Get the user's XDG data directory path.
- *
- * TODO
- *
- * @return Pointer of a dynamically allocated string containing the complete path to the user's XDG
- * data directory, or NULL if no directory was able to be found.
+ * @brief Parse a single command into the bind function and argument it calls.
  *
- * @note This function is derived from [picom's](https://github.com/yshui/picom/) `xdg_config_home()`.
- * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ * Commands are written as a function alias from @ref FUNCTION_ALIAS_MAP, then
+ * its argument if it takes one, e.g. "view 4" or "setmfact +0.05". Arguments are
+ * range checked like they are in binds, but never stored in @ref config_arena,
+ * so commands can be parsed as often as needed without growing it. String
+ * arguments point into @p command, and spawn commands, which are always run
+ * through `/bin/sh -c`, are only valid until the next call.
  *
- * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ * @param[in,out] command Null terminated command to parse, split in place.
+ * @param[out] function Pointer to where to store the function to call.
+ * @param[out] argument Pointer to where to store the argument to call @p function with.
  *
- * @see https://github.com/yshui/picom
- * @see https://github.com/yshui/picom/blob/69539edc0638019e3dd88c67007e90ce7f51174e/src/config.c#L33
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if the function is not in @ref FUNCTION_ALIAS_MAP, or it is missing its argument.
+ * @return @ref ERROR_TYPE if the argument is not of the type the function takes.
+ * @return @ref ERROR_RANGE if the argument is out of the function's range.
  */
-char *get_xdg_data_home( void ) {
+Error_t parse_command( char *command, void ( **function )( const Arg * ), Arg *argument ) {
 
-	char *xdg_data_home = getenv( "XDG_DATA_HOME" );
-	const char *user_home = getenv( "HOME" );
+	static char *shell_argv[ ] = { "/bin/sh", "-c", NULL, NULL };
+	static Spawn_Command_t shell_command = { NULL, shell_argv };
 
-	LOG_DEBUG( "XDG_DATA_HOME: \"%s\", HOME: \"%s\"\n", xdg_data_home, user_home );
+	RETURN_VALUE_IF_NULL( command, ERROR_NULL_VALUE, "%s:\"command\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( function, ERROR_NULL_VALUE, "%s:\"function\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( argument, ERROR_NULL_VALUE, "%s:\"argument\"\n", POINTER_NULL_PRINT_STRING );
 
-	if ( xdg_data_home == NULL ) {
-		const char *default_data_directory = "/.local/share";
+	char *name = command + strspn( command, " \t" );
+	char *value = name + strcspn( name, " \t" );
 
-		RETURN_VALUE_IF_NULL( user_home, NULL, "XDG_DATA_HOME and HOME are not set\n" );
+	if ( *value != '\0' ) *value++ = '\0';
+	value += strspn( value, " \t" );
 
-		xdg_data_home = join_strings( user_home, default_data_directory );
-	} else {
-		xdg_data_home = estrdup( xdg_data_home );
+	const int i = _parser_find_alias( &FUNCTION_ALIAS_INDEX, name );
+
+	if ( i < 0 ) {
+		LOG_WARN( "Command function \"%s\" does not exist\n", name );
+		return ERROR_NOT_FOUND;
 	}
 
-	return xdg_data_home;
-}
+	const Function_Alias_Map_t *alias = &FUNCTION_ALIAS_MAP[ i ];
 
-/**
- * @brief Join two strings into one.
- *
- * TODO
- *
- * @param[in] string_1 String for @p string_2 to be appended to.
- * @param[in] string_2 String to be appended to @p string_1.
- *
- * @return Pointer of a dynamically allocated string containing the now joined
- * strings, or NULL on failure.
- *
- * @note
- * 	-# Returned string is dynamically allocated and will need to be manually freed.
- * 	-# This function is derived from [picom's](https://github.com/yshui/picom/) `mstrjoin()`.
- * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
- * 	-# gcc warns about legitimate truncation worries in `strncpy()`.
- * `strncpy( joined_string, string_1, length_1 )` intentionally truncates the null byte
- * from @p string_1, however. `strncpy( joined_string + length_1, string_2, length_2 )`
- * uses bounds depending on the source argument, but `joined_string` is allocated with
- * `length_1 + length_2 + 1`, so this `strncpy()` can't overflow.
- *
- * @author Yuxuan Shui - <yshuiv7@gmail.com>
- *
- * @see https://github.com/yshui/picom
- * @see https://github.com/yshui/picom/blob/69961987e1238f9bc3af53fa0774fc19fdec44a4/src/utils/str.c#L24
- */
-char *join_strings( const char *string_1, const char *string_2 ) {
+	*function = alias->function;
+	memset( argument, 0, sizeof( Arg ) );
 
-	RETURN_VALUE_IF_NULL( string_1, NULL, "%s:\"string_1\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( string_2, NULL, "%s:\"string_2\"\n", POINTER_NULL_PRINT_STRING );
+	if ( alias->argument_type == TYPE_NONE ) return ERROR_NONE;
 
-	const size_t length_1 = strlen( string_1 );
-	const size_t length_2 = strlen( string_2 );
-	const size_t total_length = length_1 + length_2 + 1;
+	if ( *value == '\0' ) {
+		LOG_WARN( "Command function \"%s\" is missing its argument\n", name );
+		return ERROR_NOT_FOUND;
+	}
 
+	char *end = NULL;
+	long double number = 0;
 	errno = 0;
-	char *joined_string = calloc( total_length, sizeof( char ) );
 
-	RETURN_VALUE_IF_NULL( joined_string, NULL, "%s (%lu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, total_length * sizeof( char ), strerror(errno) )
+	switch ( alias->argument_type ) {
 
-	#ifndef __clang__
-	#pragma GCC diagnostic push
-	#pragma GCC diagnostic ignored "-Wpragmas"
-	#pragma GCC diagnostic ignored "-Wstringop-truncation"
-	#pragma GCC diagnostic ignored "-Wstringop-overflow"
-	#endif
+		case TYPE_BOOLEAN: {
+			if ( strcasecmp( value, "true" ) != 0 && strcasecmp( value, "false" ) != 0 ) {
+				LOG_WARN( "Command argument \"%s\" of \"%s\" is not a boolean\n", value, name );
+				return ERROR_TYPE;
+			}
+			argument->ui = strcasecmp( value, "true" ) == 0;
+			return ERROR_NONE;
+		}
 
-	strncpy( joined_string, string_1, length_1 );
-	strncpy( joined_string + length_1, string_2, length_2 );
+		case TYPE_INT:
+		case TYPE_UINT: {
+			number = strtoll( value, &end, 0 );
+			break;
+		}
 
-	#ifndef __clang__
-	#pragma GCC diagnostic pop
-	#endif
+		case TYPE_FLOAT: {
+			number = strtold( value, &end );
+			break;
+		}
 
-	joined_string[ total_length - 1 ] = '\0';
+		case TYPE_STRING: {
+			argument->v = value;
+			return ERROR_NONE;
+		}
 
-	return joined_string;
+		case TYPE_COMMAND: {
+			shell_command.command = value;
+			shell_argv[ 2 ] = value;
+			argument->v = &shell_command;
+			return ERROR_NONE;
+		}
+
+		default: {
+			LOG_WARN( "Unknown argument type during command parsing: %d. Please reprogram to a valid type\n", alias->argument_type );
+			return ERROR_TYPE;
+		}
+	}
+
+	if ( end == value || end[ strspn( end, " \t" ) ] != '\0' || errno == ERANGE ) {
+		LOG_WARN( "Command argument \"%s\" of \"%s\" is not a number\n", value, name );
+		return ERROR_TYPE;
+	}
+
+	if ( number < alias->range_min || number > alias->range_max ) {
+		LOG_WARN( "Command argument \"%s\" of \"%s\" is out of range [%Lg, %Lg]\n", value, name, alias->range_min, alias->range_max );
+		return ERROR_RANGE;
+	}
+
+	if ( alias->argument_type == TYPE_INT ) argument->i = (int) number;
+	else if ( alias->argument_type == TYPE_UINT ) argument->ui = (unsigned int) number;
+	else argument->f = (float) number;
+
+	return ERROR_NONE;
 }
 
 /**
- * @brief Creates all directories in a given path if they don't exist.
- *
- * TODO
- *
- * @param[in] path String containing the directory path to attempt to create.
+ * @brief Parse program configuration from a configuration file.
  *
- * @return 0 on success, -1 on failure.
+ * This function serves as the entry point into the configuration parser of the
+ * [dwm-libconfig patch](https://github.com/JeffofBread/dwm-libconfig). This function
+ * serves as a high level entry to the configuration parser. It largely calls helper
+ * functions to handle the actual parsing of the configuration file in various segmented
+ * and modular steps.
  *
- * @note This function is derived from [dwm-ipc's](https://github.com/mihirlad55/dwm-ipc) `mkdirp()`.
- * Credit more or less goes to [Mihir Lad](mihirlad55@gmail.com), I just made some minor adjustments.
+ * For more information on the specific details on what actions the parser performs,
+ * please reference the helper function related to the functionality you want to learn
+ * more about, they all have their own documentation and comments.
  *
- * @author Mihir Lad - <mihirlad55@gmail.com>
+ * @return An @ref Errors_t struct containing all collected errors (including @ref ERROR_NONE)
+ * while parsing the configuration. See @ref Error_t for a list of possible error types.
  *
- * @see https://github.com/mihirlad55/dwm-ipc
- * @see https://github.com/mihirlad55/dwm-ipc/blob/b3eebba7c043482d454afc5c882f513fc1b157ad/util.c#L103
+ * @todo Polish the status texts a little. I like the idea but could be refined.
  */
-int make_directory_path( const char *path ) {
+Errors_t parse_config( void ) {
 
-	RETURN_VALUE_IF_NULL( path, -1, "%s:\"path\"\n", POINTER_NULL_PRINT_STRING );
+	Errors_t returned_errors = { 0 };
 
-	char *normalized_path = NULL;
+	// Remember the hardcoded defaults before anything is parsed over them,
+	// every reload starts back from them.
+	if ( _parser_default_generation.settings == NULL ) _parser_capture_generation( &_parser_default_generation );
 
-	if ( normalize_path( path, &normalized_path ) != 0 ) {
-		LOG_ERROR( "Unable to make directory path because path normalization failed" );
-		return -1;
-	}
+	_parser_reset_report();
 
-	const char *walk = normalized_path;
-	const size_t normalized_path_length = strlen( normalized_path );
+	libconfig_config = _parser_new_config();
+	config_arena = _parser_new_arena();
 
-	while ( walk < normalized_path + normalized_path_length + 1 ) {
+	if ( libconfig_config == NULL || config_arena == NULL ) {
+		_parser_destroy_config();
+		_parser_free_arena( config_arena );
+		config_arena = NULL;
+		add_error( &returned_errors, ERROR_ALLOCATION );
+		SET_STATUS_TEXT( "Failed to load config file" );
+		return returned_errors;
+	}
 
-		// Get length from walk to next '/'
-		const size_t distance_to_slash = strcspn( walk, "/" );
+	bool fallback_config_loaded = false;
+	bool snapshot_loaded = false;
+	Source_Info_t source_info = { 0 };
+	const char *custom_config_filepath = config_filepath;
+	config_filepath = NULL;
+	TIME_PHASE( PHASE_DISCOVERY, copy_errors( &returned_errors, _parser_open_config_file( libconfig_config, custom_config_filepath, &config_filepath, &fallback_config_loaded, &source_info,
+	                                                                                   &snapshot_loaded ) ) );
 
-		// Skip path /
-		if ( distance_to_slash == 0 ) {
-			walk++;
-			continue;
-		}
+	// Reading and loading the snapshot are timed as their own phases
+	_parser_report.phase_nanoseconds[ PHASE_DISCOVERY ] -= _parser_report.phase_nanoseconds[ PHASE_READ ] + _parser_report.phase_nanoseconds[ PHASE_SNAPSHOT_LOAD ];
 
-		// Length of current path segment
-		const size_t current_path_length = walk - normalized_path + distance_to_slash;
+	// Exit the parser if we haven't acquired a configuration file.
+	// Without a configuration file, there isn't a reason to continue parsing.
+	// The program will have to rely on the hardcoded default values instead.
+	if ( config_filepath == NULL ) {
+		LOG_ERROR( "Unable to load any configs. Hardcoded default config values will be used. Exiting parsing\n" );
+		SET_STATUS_TEXT( "Failed to load config file" );
+		_parser_destroy_config();
+		_parser_free_arena( config_arena );
+		config_arena = NULL;
+		return returned_errors;
+	}
+
+	_parser_fallback_config_loaded = fallback_config_loaded;
+
+	LOG_INFO( "Path to config file: \"%s\"\n", config_filepath );
+
+	// The snapshot already holds the fully resolved configuration, and is only
+	// ever written after a clean parse, so there is nothing left to parse or back up.
+	if ( snapshot_loaded == false ) {
+		copy_errors( &returned_errors, _parse_loaded_config( &source_info ) );
+	}
+
+	// Everything parsed has been copied into the arena by now
+	_parser_destroy_config();
+	_parser_arena_finish( config_arena );
+
+	TIME_PHASE( PHASE_INDEX, index_binds(); compile_rules() );
+
+	LOG_DEBUG( "Total errors: %d\n", errors_failure_count( &returned_errors ) );
+
+	_parser_log_report( "Parsed", &returned_errors, snapshot_loaded );
+
+	SET_STATUS_TEXT( "%s | Errors: %u", config_filepath, errors_failure_count( &returned_errors ) );
+
+	return returned_errors;
+}
+
+/**
+ * @brief Reload the configuration from the currently loaded configuration file.
+ *
+ * This function re-reads @ref config_filepath, and only that file, into a fresh libconfig
+ * configuration and arena, and parses it over the hardcoded defaults, exactly like @ref parse_config()
+ * does at startup, so anything removed from the file reverts to its default value. The
+ * configuration that was live beforehand is handed to the caller through @p previous rather
+ * than freed, so the caller can compare it against the new one and only update what actually
+ * changed. The caller must then either free it with @ref free_config_generation() or reject
+ * the new configuration with @ref revert_config().
+ *
+ * If the file can't be read, or has syntax errors, nothing changes and the current
+ * configuration stays live.
+ *
+ * @param[out] previous Pointer to where to store the previously live configuration.
+ * Left zeroed if the reload fails.
+ *
+ * @return @ref ERROR_NONE if a new configuration was loaded. It may still have had
+ * errors in individual elements, which are reported through the status text.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if no configuration file was loaded, or it can no longer be opened.
+ * @return @ref ERROR_ALLOCATION if memory for the new configuration failed to be allocated.
+ * @return Any other error returned from @ref _parser_read_config_file().
+ */
+Error_t reload_config( Config_Generation_t *previous ) {
+
+	RETURN_VALUE_IF_NULL( previous, ERROR_NULL_VALUE, "%s:\"previous\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( config_filepath, ERROR_NOT_FOUND, "No config file was loaded, nothing to reload\n" );
+
+	memset( previous, 0, sizeof( *previous ) );
+
+	config_t *config = _parser_new_config();
+	Arena_t *arena = _parser_new_arena();
+
+	if ( config == NULL || arena == NULL ) {
+		if ( config != NULL ) config_destroy( config );
+		free( config );
+		_parser_free_arena( arena );
+		return ERROR_ALLOCATION;
+	}
+
+	const Error_t capture_error = _parser_capture_generation( previous );
+
+	if ( capture_error != ERROR_NONE ) {
+		config_destroy( config );
+		free( config );
+		_parser_free_arena( arena );
+		memset( previous, 0, sizeof( *previous ) );
+		return capture_error;
+	}
+
+	_parser_reset_report();
+	_parser_apply_generation( &_parser_default_generation );
+	libconfig_config = config;
+	config_arena = arena;
+
+	bool snapshot_loaded = false;
+	Source_Info_t source_info = { 0 };
+	const Error_t read_error = _parser_read_config_file( libconfig_config, config_filepath, _parser_fallback_config_loaded, &source_info, &snapshot_loaded );
+
+	if ( read_error != ERROR_NONE ) {
+		LOG_WARN( "Unable to reload config file \"%s\", keeping the current configuration\n", config_filepath );
+		_parser_destroy_config();
+		_parser_free_arena( arena );
+		_parser_apply_generation( previous );
+		free( previous->settings );
+		memset( previous, 0, sizeof( *previous ) );
+		SET_STATUS_TEXT( "%s | Failed to reload", config_filepath );
+		return read_error;
+	}
+
+	Errors_t returned_errors = { 0 };
+
+	if ( snapshot_loaded == false ) {
+		copy_errors( &returned_errors, _parse_loaded_config( &source_info ) );
+	}
+
+	_parser_destroy_config();
+	_parser_arena_finish( config_arena );
+
+	TIME_PHASE( PHASE_INDEX, index_binds(); compile_rules() );
+
+	LOG_INFO( "Reloaded config file \"%s\"\n", config_filepath );
+
+	_parser_log_report( "Reloaded", &returned_errors, snapshot_loaded );
+
+	SET_STATUS_TEXT( "%s | Errors: %u", config_filepath, errors_failure_count( &returned_errors ) );
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Reject a configuration loaded by @ref reload_config() and make the previous one live again.
+ *
+ * This function frees the configuration loaded by @ref reload_config() and restores
+ * @p previous in its place. @p previous is zeroed afterward, as the live configuration
+ * owns its memory again, so freeing it with @ref free_config_generation() does nothing.
+ *
+ * @param[in,out] previous Pointer to the configuration returned by @ref reload_config().
+ */
+void revert_config( Config_Generation_t *previous ) {
+
+	RETURN_IF_NULL( previous, "%s:\"previous\"\n", POINTER_NULL_PRINT_STRING );
+
+	// Capturing only fails to copy the settings, which is fine as they are not freed anyway
+	Config_Generation_t rejected_generation = { 0 };
+	_parser_capture_generation( &rejected_generation );
+
+	_parser_apply_generation( previous );
+	free( previous->settings );
+	memset( previous, 0, sizeof( *previous ) );
+
+	free_config_generation( &rejected_generation );
+
+	index_binds();
+	compile_rules();
+
+	LOG_WARN( "Reloaded config file \"%s\" was rejected, reverted to the previous configuration\n", config_filepath );
+	SET_STATUS_TEXT( "%s | Reload rejected", config_filepath );
+}
+
+////////////////////////////////////
+///// Public utility functions /////
+////////////////////////////////////
+
+/**
+ * @brief Adds an error to an @ref Errors_t struct.
+ *
+ * This function acts as a simple way to increment the error
+ * count of an @ref Errors_t struct at the correct error index.
+ *
+ * @param[out] errors Pointer to an @ref Errors_t struct to add @p error to.
+ * @param[in] error Error to be added to the error count in @p errors.
+ */
+void add_error( Errors_t *errors, const Error_t error ) {
+
+	RETURN_IF_NULL( errors, "%s:\"errors\"\n", POINTER_NULL_PRINT_STRING );
+
+	if ( error < ERROR_ENUM_LENGTH ) {
+		errors->errors_count[ error ]++;
+	}
+}
+
+/**
+ * @brief Copy errors from @p source to @p destination.
+ *
+ * This function copies the errors in @p source to the @ref Errors_t
+ * struct pointed to by @p destination. It does not alter the errors
+ * in @p source. If the pointer to @p destination is NULL, an error
+ * will be logged and the function will return.
+ *
+ * @param[out] destination Pointer to where to copy errors to.
+ * @param[in] source Errors to copy.
+ */
+void copy_errors( Errors_t *destination, const Errors_t source ) {
+
+	RETURN_IF_NULL( destination, "%s:\"destination\"\n", POINTER_NULL_PRINT_STRING );
+
+	for ( unsigned int i = 0; i < ERROR_ENUM_LENGTH; i++ ) {
+		destination->errors_count[ i ] += source.errors_count[ i ];
+	}
+}
+
+/**
+ * @brief Counts the number of failure errors present in an @ref Errors_t struct.
+ *
+ * This function acts as a simple way to count the number of failure errors
+ * present in an @ref Errors_t struct.
+ *
+ * @param[in] errors Pointer to an @ref Errors_t struct to count errors from.
+ *
+ * @return -1 if @p errors is NULL, else the total of the number of failure
+ * errors present in @p errors.
+ */
+int errors_failure_count( const Errors_t *errors ) {
+
+	RETURN_VALUE_IF_NULL( errors, -1, "%s:\"errors\"\n", POINTER_NULL_PRINT_STRING );
+
+	int count = 0;
+
+	for ( unsigned int i = ERROR_NONE + 1; i < ERROR_ENUM_LENGTH; i++ ) {
+		count += (int) errors->errors_count[ i ];
+	}
+
+	return count;
+}
+
+/**
+ * @brief Simple wrapper around `strdup()` to provide error logging.
+ *
+ * This function acts as a simple wrapper around `strdup()` that provides
+ * some NULL safety as well as error logging around `strdup()`. It can
+ * be used as a drop in replacement for `strdup()` safely.
+ *
+ * @param[in] string String to be copied.
+ *
+ * @return NULL if allocation failed or @p string was NULL, or the pointer
+ * to a dynamically allocated duplicate of @p string.
+ *
+ * @note Returned string is dynamically allocated and will need to be manually freed.
+ */
+char *estrdup( const char *string ) {
+
+	RETURN_VALUE_IF_NULL( string, NULL, "%s:\"string\"\n", POINTER_NULL_PRINT_STRING );
+
+	errno = 0;
+	char *return_string = strdup( string );
+
+	RETURN_VALUE_IF_NULL( return_string, NULL, "%s using strdup(): %s\n", FAILED_ALLOC_PRINT_STRING, strerror(errno) );
+
+	_parser_report.estrdup_bytes += strlen( return_string ) + 1;
+	_parser_report.estrdup_count++;
+
+	return return_string;
+}
+
+/**
+ * @brief Extend one string with another.
+ *
+ * This function reallocates and extends the string pointed to by @p source_string with the string @p addition.
+ * If either the pointer to @p source_string or @p addition are NULL, the function will log an error and return.
+ * If the string at @p source_string is NULL, @p addition will be copied into it's place using dynamic allocation.
+ * If all succeeds, then the string pointed to by @p source_string will be dynamically reallocated to contain both
+ * the source string and @p addition, and will need to be freed manually.
+ *
+ * @param[in,out] source_string Pointer to the string to be extended with @p addition. Must point to a NULL or heap allocated string.
+ * @param[in] addition Additional string to be appended to the string pointed to by @p source_string.
+ *
+ * @warning String at @p source_string must be NULL or heap allocated. If it points to a string literal,
+ * `realloc()` will crash the program. See @ref join_strings() if you wish to append a string literal.
+ *
+ * @note
+ * 	-# @p source_string is or will be dynamically allocated and must be manually freed.
+ * 	-# This function is derived from [picom's](https://github.com/yshui/picom/) `mstrextend()`.
+ * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ *
+ * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ *
+ * @see https://github.com/yshui/picom
+ * @see https://github.com/yshui/picom/blob/69539edc0638019e3dd88c67007e90ce7f51174e/src/utils/str.c#L54
+ */
+void extend_string( char **source_string, const char *addition ) {
+
+	RETURN_IF_NULL( source_string, "%s:\"source_string\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_IF_NULL( addition, "%s:\"addition\"\n", POINTER_NULL_PRINT_STRING );
+
+	if ( *source_string == NULL ) {
+		*source_string = estrdup( addition );
+		LOG_DEBUG( "Source string was NULL, addition was copied into its place\n" );
+		return;
+	}
+
+	const size_t source_length = strlen( *source_string );
+	const size_t addition_length = strlen( addition );
+	const size_t total_length = source_length + addition_length + 1; // +1 for NULL termination
+
+	errno = 0;
+	*source_string = realloc( *source_string, total_length * sizeof( char ) );
+
+	RETURN_IF_NULL( *source_string, "%s (%zu bytes) using realloc(): %s\n", FAILED_ALLOC_PRINT_STRING, total_length * sizeof( char ), strerror(errno) );
+
+	strncpy( *source_string + source_length, addition, addition_length );
+	( *source_string )[ total_length - 1 ] = '\0';
+}
+
+/**
+ * @brief Construct the path to a file in dwm's XDG data directory.
+ *
+ * This function returns "/dwm/" and @p filename appended to the path returned by
+ * @ref get_xdg_data_home(), the same directory @ref _parser_backup_config() backs
+ * the configuration up to.
+ *
+ * @param[in] filename Name of the file inside dwm's data directory.
+ * @param[in] create_directory Whether to create dwm's data directory if it doesn't exist yet.
+ *
+ * @return Pointer to a dynamically allocated string containing the complete path, or NULL on failure.
+ *
+ * @note Returned string is dynamically allocated and will need to be manually freed.
+ */
+char *get_data_filepath( const char *filename, const bool create_directory ) {
+
+	RETURN_VALUE_IF_NULL( filename, NULL, "%s:\"filename\"\n", POINTER_NULL_PRINT_STRING );
+
+	char *filepath = get_xdg_data_home();
+
+	RETURN_VALUE_IF_NULL( filepath, NULL, "Failed to get dwm's data directory path\n" );
+
+	extend_string( &filepath, "/dwm/" );
+	RETURN_VALUE_IF_NULL( filepath, NULL, "%s for data directory path\n", FAILED_ALLOC_PRINT_STRING );
+
+	if ( create_directory && make_directory_path( filepath ) != 0 ) {
+		free( filepath );
+		return NULL;
+	}
+
+	extend_string( &filepath, filename );
+	RETURN_VALUE_IF_NULL( filepath, NULL, "%s for data file path\n", FAILED_ALLOC_PRINT_STRING );
+
+	return filepath;
+}
+
+/**
+ * @brief Find and return a layout that uses a specific arrange function.
+ *
+ * This function searches the global array `layouts` for a layout struct that contains
+ * @p arrange. If it is found, a pointer to it is returned, else NULL is returned.
+ *
+ * @param[in] arrange Arrange function used by the layout to be found and returned.
+ *
+ * @return Pointer to the found layout or NULL if no layout containing @p arrange was found.
+ *
+ * @note This function assumes that only one layout uses the given arrange
+ * function. If multiple layouts use the same arrange function, then this
+ * function will simply return the first one in the array using that arrange
+ * function.
+ */
+const Layout *get_layout( void ( *arrange )( Monitor * ) ) {
+
+	for ( unsigned int i = 0; i < LENGTH( layouts ); i++ ) {
+		if ( layouts[ i ].arrange == arrange ) {
+			return &layouts[ i ];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Get the user's XDG configuration directory path.
+ *
+ * TODO
+ *
+ * @return Pointer of a dynamically allocated string containing the complete path to the user's XDG
+ * configuration directory, or NULL if no directory was able to be found.
+ *
+ * @note
+ * 	-# If the function is successful, the returned string will have been dynamically allocated
+ * and will need to be manually freed.
+ * 	-# This function is derived from [picom's](https://github.com/yshui/picom/) `xdg_config_home()`.
+ * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ *
+ * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ *
+ * @see https://github.com/yshui/picom
+ * @see https://github.com/yshui/picom/blob/69539edc0638019e3dd88c67007e90ce7f51174e/src/config.c#L33
+ */
+char *get_xdg_config_home( void ) {
+
+	char *xdg_config_home = getenv( "XDG_CONFIG_HOME" );
+	const char *user_home = getenv( "HOME" );
+
+	LOG_DEBUG( "XDG_CONFIG_HOME: \"%s\", HOME: \"%s\"\n", xdg_config_home, user_home );
+
+	if ( xdg_config_home == NULL ) {
+		const char *default_config_directory = "/.config";
+
+		RETURN_VALUE_IF_NULL( user_home, NULL, "XDG_CONFIG_HOME and HOME are not set\n" );
+
+		xdg_config_home = join_strings( user_home, default_config_directory );
+	} else {
+		xdg_config_home = estrdup( xdg_config_home );
+	}
+
+	return xdg_config_home;
+}
+
+/**
+ * @brief Get the user's XDG data directory path.
+ *
+ * TODO
+ *
+ * @return Pointer of a dynamically allocated string containing the complete path to the user's XDG
+ * data directory, or NULL if no directory was able to be found.
+ *
+ * @note This function is derived from [picom's](https://github.com/yshui/picom/) `xdg_config_home()`.
+ * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ *
+ * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ *
+ * @see https://github.com/yshui/picom
+ * @see https://github.com/yshui/picom/blob/69539edc0638019e3dd88c67007e90ce7f51174e/src/config.c#L33
+ */
+char *get_xdg_data_home( void ) {
+
+	char *xdg_data_home = getenv( "XDG_DATA_HOME" );
+	const char *user_home = getenv( "HOME" );
+
+	LOG_DEBUG( "XDG_DATA_HOME: \"%s\", HOME: \"%s\"\n", xdg_data_home, user_home );
+
+	if ( xdg_data_home == NULL ) {
+		const char *default_data_directory = "/.local/share";
+
+		RETURN_VALUE_IF_NULL( user_home, NULL, "XDG_DATA_HOME and HOME are not set\n" );
+
+		xdg_data_home = join_strings( user_home, default_data_directory );
+	} else {
+		xdg_data_home = estrdup( xdg_data_home );
+	}
+
+	return xdg_data_home;
+}
+
+/**
+ * @brief Join two strings into one.
+ *
+ * TODO
+ *
+ * @param[in] string_1 String for @p string_2 to be appended to.
+ * @param[in] string_2 String to be appended to @p string_1.
+ *
+ * @return Pointer of a dynamically allocated string containing the now joined
+ * strings, or NULL on failure.
+ *
+ * @note
+ * 	-# Returned string is dynamically allocated and will need to be manually freed.
+ * 	-# This function is derived from [picom's](https://github.com/yshui/picom/) `mstrjoin()`.
+ * Credit more or less goes to [Yuxuan Shui](yshuiv7@gmail.com), I just made some minor adjustments.
+ * 	-# gcc warns about legitimate truncation worries in `strncpy()`.
+ * `strncpy( joined_string, string_1, length_1 )` intentionally truncates the null byte
+ * from @p string_1, however. `strncpy( joined_string + length_1, string_2, length_2 )`
+ * uses bounds depending on the source argument, but `joined_string` is allocated with
+ * `length_1 + length_2 + 1`, so this `strncpy()` can't overflow.
+ *
+ * @author Yuxuan Shui - <yshuiv7@gmail.com>
+ *
+ * @see https://github.com/yshui/picom
+ * @see https://github.com/yshui/picom/blob/69961987e1238f9bc3af53fa0774fc19fdec44a4/src/utils/str.c#L24
+ */
+char *join_strings( const char *string_1, const char *string_2 ) {
+
+	RETURN_VALUE_IF_NULL( string_1, NULL, "%s:\"string_1\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( string_2, NULL, "%s:\"string_2\"\n", POINTER_NULL_PRINT_STRING );
+
+	const size_t length_1 = strlen( string_1 );
+	const size_t length_2 = strlen( string_2 );
+	const size_t total_length = length_1 + length_2 + 1;
+
+	errno = 0;
+	char *joined_string = calloc( total_length, sizeof( char ) );
+
+	RETURN_VALUE_IF_NULL( joined_string, NULL, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, total_length * sizeof( char ), strerror(errno) )
+
+	#ifndef __clang__
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wpragmas"
+	#pragma GCC diagnostic ignored "-Wstringop-truncation"
+	#pragma GCC diagnostic ignored "-Wstringop-overflow"
+	#endif
+
+	strncpy( joined_string, string_1, length_1 );
+	strncpy( joined_string + length_1, string_2, length_2 );
+
+	#ifndef __clang__
+	#pragma GCC diagnostic pop
+	#endif
+
+	joined_string[ total_length - 1 ] = '\0';
+
+	return joined_string;
+}
+
+/**
+ * @brief Creates all directories in a given path if they don't exist.
+ *
+ * TODO
+ *
+ * @param[in] path String containing the directory path to attempt to create.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @note This function is derived from [dwm-ipc's](https://github.com/mihirlad55/dwm-ipc) `mkdirp()`.
+ * Credit more or less goes to [Mihir Lad](mihirlad55@gmail.com), I just made some minor adjustments.
+ *
+ * @author Mihir Lad - <mihirlad55@gmail.com>
+ *
+ * @see https://github.com/mihirlad55/dwm-ipc
+ * @see https://github.com/mihirlad55/dwm-ipc/blob/b3eebba7c043482d454afc5c882f513fc1b157ad/util.c#L103
+ */
+int make_directory_path( const char *path ) {
+
+	RETURN_VALUE_IF_NULL( path, -1, "%s:\"path\"\n", POINTER_NULL_PRINT_STRING );
+
+	char *normalized_path = NULL;
+
+	if ( normalize_path( path, &normalized_path ) != 0 ) {
+		LOG_ERROR( "Unable to make directory path because path normalization failed" );
+		return -1;
+	}
+
+	const char *walk = normalized_path;
+	const size_t normalized_path_length = strlen( normalized_path );
+
+	while ( walk < normalized_path + normalized_path_length + 1 ) {
+
+		// Get length from walk to next '/'
+		const size_t distance_to_slash = strcspn( walk, "/" );
+
+		// Skip path /
+		if ( distance_to_slash == 0 ) {
+			walk++;
+			continue;
+		}
+
+		// Length of current path segment
+		const size_t current_path_length = walk - normalized_path + distance_to_slash;
 		char current_path[ current_path_length + 1 ];
 
-		struct stat stat_variable;
+		struct stat stat_variable;
+
+		// Copy path segment to stat
+		strncpy( current_path, normalized_path, current_path_length );
+		strcpy( current_path + current_path_length, "" );
+
+		errno = 0;
+		if ( stat( current_path, &stat_variable ) < 0 ) {
+			if ( errno == ENOENT ) {
+				LOG_DEBUG( "Making directory %s\n", current_path );
+				if ( mkdir( current_path, 0700 ) < 0 ) {
+					LOG_ERROR( "Failed to make directory \"%s\": %s\n", current_path, strerror( errno ) );
+					free( normalized_path );
+					return -1;
+				}
+			} else {
+				LOG_ERROR( "Error stat-ing directory \"%s\": %s\n", current_path, strerror( errno ) );
+				free( normalized_path );
+				return -1;
+			}
+		}
+
+		// Continue to next path segment
+		walk += distance_to_slash;
+	}
+
+	free( normalized_path );
+	return 0;
+}
+
+/**
+ * @brief Normalize a file or folder path to remove repeat forward slash characters.
+ *
+ * TODO
+ *
+ * @param[in] original_path String containing the path to be normalized.
+ * @param[out] normalized_path Pointer to where to store the normalized path. It is dynamically
+ * allocated and will need to be manually freed.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @note
+ * 	-# @p normalized_path can be dynamically allocated and will need to be manually freed.
+ * 	-# This function is derived from [dwm-ipc's](https://github.com/mihirlad55/dwm-ipc) `normalizepath()`.
+ * Credit more or less goes to [Mihir Lad](mihirlad55@gmail.com), I just made some minor adjustments.
+ *
+ * @author Mihir Lad - <mihirlad55@gmail.com>
+ *
+ * @see https://github.com/mihirlad55/dwm-ipc
+ * @see https://github.com/mihirlad55/dwm-ipc/blob/b3eebba7c043482d454afc5c882f513fc1b157ad/util.c#L40
+ */
+int normalize_path( const char *original_path, char **normalized_path ) {
+
+	RETURN_VALUE_IF_NULL( original_path, -1, "%s:\"original_path\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( normalized_path, -1, "%s:\"normalized_path\"\n", POINTER_NULL_PRINT_STRING );
+
+	const size_t original_length = strlen( original_path );
+
+	errno = 0;
+	*normalized_path = calloc( ( original_length + 1 ), sizeof( char ) );
+
+	RETURN_VALUE_IF_NULL( *normalized_path, -1, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, ( original_length + 1 ) * sizeof( char ), strerror(errno) );
+
+	size_t new_length = 0;
+	const char *match, *walk = original_path;
+	while ( ( match = strchr( walk, '/' ) ) ) {
+
+		// Copy everything between match and walk
+		strncpy( *normalized_path + new_length, walk, match - walk );
+		new_length += match - walk;
+		walk += match - walk;
+
+		// Skip all repeating slashes
+		while ( *walk == '/' ) walk++;
+
+		// If not last character in path
+		if ( walk != original_path + original_length ) ( *normalized_path )[ new_length++ ] = '/';
+	}
+
+	( *normalized_path )[ new_length++ ] = '\0';
+
+	// Copy remaining path
+	strcat( *normalized_path, walk );
+	new_length += strlen( walk );
+
+	errno = 0;
+	*normalized_path = realloc( *normalized_path, new_length * sizeof( char ) );
+
+	RETURN_VALUE_IF_NULL( *normalized_path, -1, "%s (%zu bytes) using realloc(): %s\n", FAILED_ALLOC_PRINT_STRING, new_length * sizeof( char ), strerror(errno) );
+
+	return 0;
+}
+
+/**
+ * @brief Set current layout to floating.
+ *
+ * This is a wrapper for the `setlayout()` function. It sets the
+ * currently focused monitor's layout to the floating layout found
+ * in the layouts array.
+ *
+ * @param arg Unused.
+ */
+void setlayout_floating( const Arg *arg ) {
+
+	const Layout *layout = get_layout( NULL ); // NULL is floating layout's arrange function
+
+	RETURN_IF_NULL( layout, "Failed to get floating layout" );
+
+	setlayout( &(Arg){ .v = layout } );
+}
+
+/**
+ * @brief Set current layout to monocle.
+ *
+ * This is a wrapper for the `setlayout()` function. It sets the
+ * currently focused monitor's layout to the monocle layout found in
+ * the layouts array.
+ *
+ * @param arg Unused.
+ */
+void setlayout_monocle( const Arg *arg ) {
+
+	const Layout *layout = get_layout( monocle );
+
+	RETURN_IF_NULL( layout, "Failed to get monocle layout" );
+
+	setlayout( &(Arg){ .v = layout } );
+}
+
+/**
+ * @brief Set current layout to tile.
+ *
+ * This is a wrapper for the `setlayout()` function. It sets the
+ * currently focused monitor's layout to the tile layout found in the
+ * layouts array.
+ *
+ * @param arg Unused.
+ */
+void setlayout_tiled( const Arg *arg ) {
+
+	const Layout *layout = get_layout( tile );
+
+	RETURN_IF_NULL( layout, "Failed to get tile layout" );
+
+	setlayout( &(Arg){ .v = layout } );
+}
+
+/**
+ * @brief Wrapper around `spawn()` for simpler program spawning.
+ *
+ * This wrapper is to simplify the parsers interaction with the
+ * `spawn()` function. It takes in the command split into its
+ * arguments when the configuration was parsed, see
+ * @ref _parser_tokenize_command(), and passes them to `spawn()`.
+ *
+ * @param[in] arg Pointer to the Arg struct containing a pointer to
+ * the @ref Spawn_Command_t of the program to spawn.
+ */
+void spawn_string( const Arg *arg ) {
+
+	RETURN_IF_NULL( arg, "%s:\"arg\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_IF_NULL( arg->v, "%s:\"arg->v\"\n", POINTER_NULL_PRINT_STRING );
+
+	const Spawn_Command_t *command = arg->v;
+	const Arg tmp = { .v = command->argv };
+
+	LOG_DEBUG( "Attempting to spawn \"%s\"\n", command->command );
+	spawn( &tmp );
+}
+
+/////////////////////////////////////
+///// Parser internal functions /////
+/////////////////////////////////////
+
+/**
+ * @brief Make a configuration generation live.
+ *
+ * Copies every value held in @p generation back into the parser's global configuration
+ * variables, including the settings in @ref SETTING_ALIAS_MAP if @p generation holds any.
+ * Ownership of the memory backing @p generation is handed back to the globals, so
+ * @p generation must not be freed with @ref free_config_generation() afterward.
+ *
+ * @param[in] generation Pointer to the configuration generation to make live.
+ */
+static void _parser_apply_generation( const Config_Generation_t *generation ) {
+
+	RETURN_IF_NULL( generation, "%s:\"generation\"\n", POINTER_NULL_PRINT_STRING );
+
+	keys = generation->keys;
+	buttons = generation->buttons;
+	rules = generation->rules;
+	fonts = generation->fonts;
+	themes = generation->themes;
+
+	keys_count = generation->keys_count;
+	buttons_count = generation->buttons_count;
+	rules_count = generation->rules_count;
+	fonts_count = generation->fonts_count;
+	themes_count = generation->themes_count;
+
+	keys_malloced = generation->keys_malloced;
+	buttons_malloced = generation->buttons_malloced;
+	rules_malloced = generation->rules_malloced;
+	fonts_malloced = generation->fonts_malloced;
+	themes_malloced = generation->themes_malloced;
+
+	memcpy( tags, generation->tags, sizeof( tags ) );
+	memcpy( colors, generation->colors, sizeof( colors ) );
+
+	if ( generation->settings != NULL ) {
+		for ( unsigned int i = 0; i < LENGTH( SETTING_ALIAS_MAP ); i++ ) {
+			memcpy( SETTING_ALIAS_MAP[ i ].setting, &generation->settings[ i ], _parser_data_type_size( SETTING_ALIAS_MAP[ i ].type ) );
+		}
+	}
+
+	config_arena = generation->arena;
+}
+
+/**
+ * @brief Backs up a libconfig configuration and snapshots its parsed result, off the startup path.
+ *
+ * This function backs up the given libconfig config_t, @p config, to "dwm_last.conf"
+ * in dwm's XDG data directory (see @ref get_data_filepath()), usually
+ * "~/.local/share/dwm/dwm_last.conf", and writes the snapshot of what was parsed from it
+ * next to it. As that directory may be slow to reach, both are written by a forked writer
+ * process, with @ref _parser_write_backup() and @ref _parser_write_snapshot(), which works
+ * on its own copy of @p config and of the parsed configuration, so parsing carries on
+ * immediately and @p config can be destroyed right away. The writer is forked twice over,
+ * so it is reparented to init and never left as a zombie, whatever the caller's `SIGCHLD`
+ * handling is. Its intermediate parent is waited for here, which only this thread may do:
+ * dwm changes its `SIGCHLD` handling and reaps stray children only after joining the parser
+ * thread. If the writer can't be forked, both are written here instead.
+ *
+ * @param[in] config Pointer to the libconfig configuration to be backed up.
+ * @param[in] source_info Pointer to the identity of the configuration file's contents, used
+ * to write the snapshot. No snapshot is written if it is NULL or isn't valid.
+ *
+ * @return @ref ERROR_NONE if the backup and snapshot were handed off to the writer process, or written.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return Any error returned from @ref _parser_write_backup() or @ref _parser_write_snapshot() if
+ * they had to be written here.
+ */
+static Error_t _parser_backup_config( config_t *config, const Source_Info_t *source_info ) {
+
+	RETURN_VALUE_IF_NULL( config, ERROR_NULL_VALUE, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+
+	// Anything still buffered would otherwise be written out again by the writer
+	fflush( stdout );
+	fflush( stderr );
+
+	const bool write_snapshot = source_info != NULL && source_info->valid;
+
+	errno = 0;
+	const pid_t pid = fork();
+
+	if ( pid < 0 ) {
+		LOG_WARN( "Failed to fork the configuration backup writer, backing up now instead: %s\n", strerror( errno ) );
+		const Error_t backup_error = _parser_write_backup( config );
+		const Error_t snapshot_error = write_snapshot ? _parser_write_snapshot( config_filepath, source_info ) : ERROR_NONE;
+		return backup_error != ERROR_NONE ? backup_error : snapshot_error;
+	}
+
+	if ( pid == 0 ) {
+		if ( fork() == 0 ) {
+			const Error_t backup_error = _parser_write_backup( config );
+			const Error_t snapshot_error = write_snapshot ? _parser_write_snapshot( config_filepath, source_info ) : ERROR_NONE;
+			fflush( stdout );
+			_exit( backup_error == ERROR_NONE && snapshot_error == ERROR_NONE ? EXIT_SUCCESS : EXIT_FAILURE );
+		}
+		_exit( EXIT_SUCCESS );
+	}
+
+	// A caller ignoring SIGCHLD, like dwm once running, has the writer's parent reaped for it, so
+	// waitpid() fails with ECHILD once it exited, which is just as good as reaping it here
+	int wait_errno;
+	while ( ( wait_errno = waitpid( pid, NULL, 0 ) < 0 ? errno : 0 ) == EINTR );
+	if ( wait_errno != 0 && wait_errno != ECHILD ) {
+		LOG_WARN( "Failed to wait for the configuration backup writer: %s\n", strerror( wait_errno ) );
+	}
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Parse a bind's argument, of the type its function takes.
+ *
+ * @param[in] setting Pointer to the bind's "argument" setting, only used if @p argument_type is not @ref TYPE_NONE.
+ * @param[in] argument_type Enum describing the type of data stored in @p parsed_argument.
+ * @param[in] range_min Minimum value @p parsed_argument can have. Only applies to numerical types.
+ * @param[in] range_max Maximum value @p parsed_argument can have. Only applies to numerical types.
+ * @param[out] argument Pointer to an Arg struct where the parsed value of type @p argument_type
+ * in range @p range_min to @p range_max will be stored.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_TYPE if @p argument_type does not match any case in the switch statement.
+ * @return Any error returned from any of the `_libconfig_get_TYPE()` functions.
+ */
+static Error_t _parse_bind_argument( config_setting_t *setting, const Data_Type_t argument_type, const long double range_min, const long double range_max, Arg *argument ) {
+
+	RETURN_VALUE_IF_NULL( argument, ERROR_NULL_VALUE, "%s:\"argument\"\n", POINTER_NULL_PRINT_STRING );
+
+	if ( argument_type == TYPE_NONE ) return ERROR_NONE;
+
+	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+
+	Error_t lookup_error = ERROR_NONE;
+	switch ( argument_type ) {
+
+		case TYPE_BOOLEAN: {
+			lookup_error = _libconfig_get_value( setting, CONFIG_TYPE_BOOL, (bool *) &argument->ui );
+			break;
+		}
+
+		case TYPE_INT: {
+			lookup_error = _libconfig_get_int( setting, range_min, range_max, &argument->i );
+			break;
+		}
+
+		case TYPE_UINT: {
+			lookup_error = _libconfig_get_uint( setting, range_min, range_max, &argument->ui );
+			break;
+		}
+
+		case TYPE_FLOAT: {
+			lookup_error = _libconfig_get_float( setting, range_min, range_max, &argument->f );
+			break;
+		}
+
+		case TYPE_STRING: {
+			lookup_error = _libconfig_get_string( setting, (const char **) &argument->v );
+			if ( lookup_error == ERROR_NONE ) lookup_error = _parser_intern_string( (const char **) &argument->v );
+			break;
+		}
+
+		case TYPE_COMMAND: {
+			const char *command = NULL;
+			lookup_error = _libconfig_get_string( setting, &command );
+			if ( lookup_error == ERROR_NONE ) lookup_error = _parser_tokenize_command( command, (const Spawn_Command_t **) &argument->v );
+			break;
+		}
+
+		default: {
+			LOG_WARN( "Unknown argument type during bind parsing: %d. Please reprogram to a valid type\n", argument_type );
+			return ERROR_TYPE;
+		}
+	}
+
+	return lookup_error;
+}
+
+/**
+ * @brief TODO
+ *
+ * TODO
+ *
+ * @param[in] setting Pointer to the bind's "function" setting.
+ * @param[out] function TODO
+ * @param[out] argument_type Pointer to where to store the data type of the Arg that can be passed to @p function.
+ * @param[out] range_min Pointer to where to store the minimum value of the Arg that can be passed to @p function.
+ * @param[out] range_max Pointer to where to store the maximum value of the Arg that can be passed to @p function.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if parsed intermediate function string does not match any alias found in @ref FUNCTION_ALIAS_MAP.
+ * @return Any error returned from @ref _libconfig_get_string().
+ */
+static Error_t _parse_bind_function( config_setting_t *setting, void ( **function )( const Arg * ), Data_Type_t *argument_type, long double *range_min, long double *range_max ) {
+
+	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( function, ERROR_NULL_VALUE, "%s:\"function\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( argument_type, ERROR_NULL_VALUE, "%s:\"argument_type\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( range_min, ERROR_NULL_VALUE, "%s:\"range_min\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( range_max, ERROR_NULL_VALUE, "%s:\"range_max\"\n", POINTER_NULL_PRINT_STRING );
+
+	const char *function_string = NULL;
+	const Error_t lookup_error = _libconfig_get_string( setting, &function_string );
+
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
+
+	const int i = _parser_find_alias( &FUNCTION_ALIAS_INDEX, function_string );
+
+	if ( i < 0 ) return ERROR_NOT_FOUND;
+
+	*function = FUNCTION_ALIAS_MAP[ i ].function;
+	*argument_type = FUNCTION_ALIAS_MAP[ i ].argument_type;
+	*range_min = FUNCTION_ALIAS_MAP[ i ].range_min;
+	*range_max = FUNCTION_ALIAS_MAP[ i ].range_max;
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief TODO
+ *
+ * TODO
+ *
+ * @param[in] setting Pointer to the bind's "modifier" setting.
+ * @param[out] modifier TODO
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_ALLOCATION if @ref estrdup() fails to allocate memory.
+ * @return @ref ERROR_NOT_FOUND if parsed intermediate modifier string does not
+ * match any alias found in @ref MODIFIER_ALIAS_MAP.
+ * @return Any error returned from @ref _libconfig_get_string().
+ *
+ * @see https://gitlab.freedesktop.org/xorg/proto/xorgproto/-/blob/master/include/X11/X.h
+ */
+static Error_t _parse_bind_modifier( config_setting_t *setting, unsigned int *modifier ) {
+
+	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( modifier, ERROR_NULL_VALUE, "%s:\"modifier\"\n", POINTER_NULL_PRINT_STRING );
+
+	const char *modifier_string = NULL;
+	const Error_t lookup_error = _libconfig_get_string( setting, &modifier_string );
+
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
+
+	char *buffer = estrdup( modifier_string );
+
+	if ( buffer == NULL ) return ERROR_ALLOCATION;
+
+	char *modifier_token = strtok( buffer, "+" );
+	while ( modifier_token != NULL ) {
+
+		while ( *modifier_token == ' ' || *modifier_token == '\t' ) modifier_token++;
+
+		char *end = modifier_token + strlen( modifier_token ) - 1;
+		while ( end > modifier_token && ( *end == ' ' || *end == '\t' ) ) {
+			*end = '\0';
+			end--;
+		}
+
+		const int i = _parser_find_alias( &MODIFIER_ALIAS_INDEX, modifier_token );
+
+		if ( i >= 0 ) {
+			*modifier |= MODIFIER_ALIAS_MAP[ i ].modifier;
+		} else {
+			LOG_WARN( "Invalid modifier: \"%s\"\n", modifier_token );
+			free( buffer );
+			return ERROR_NOT_FOUND;
+		}
+
+		modifier_token = strtok( NULL, "+" );
+	}
+
+	free( buffer );
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Parse a buttonbind from a libconfig configuration setting.
+ *
+ * See @ref BUTTONBIND_SCHEMA for its members and @ref _parse_element() for how they are parsed.
+ *
+ * @param[in] setting Pointer to the libconfig setting containing the buttonbind to be parsed into @p buttonbind.
+ * @param[in] index Index of the current buttonbind in the larger array. Used purely for debug printing.
+ * @param[out] buttonbind Pointer to the Button struct where the values parsed from @p setting are stored.
+ *
+ * @return Any errors returned from @ref _parse_element().
+ */
+static Errors_t _parse_buttonbind( config_setting_t *setting, const unsigned int index, Button *buttonbind ) {
+	return _parse_element( setting, index, "Buttonbind", &BUTTONBIND_SCHEMA_INDEX, buttonbind, sizeof( Button ) );
+}
+
+/**
+ * @brief Thin adapter function to allow for buttonbind parsing inside a generic array parsing function.
+ *
+ * See @ref _parse_buttonbind() for function documentation.
+ */
+static Errors_t _parse_buttonbind_adapter( config_setting_t *setting, const unsigned int index, void *buttonbind ) {
+	return _parse_buttonbind( setting, index, (Button *) buttonbind );
+}
+
+/**
+ * @brief TODO
+ *
+ * TODO
+ *
+ * @param[in] setting Pointer to the buttonbind's "button" setting.
+ * @param[out] button TODO
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided or if `strtoul()`
+ * failed to properly convert parsed intermediate button string to a number.
+ * @return @ref ERROR_RANGE If parsed button value exceeds 8 bit mask value limit (255,
+ * 8 bit maximum value minus 1) or is 0, an empty/no button.
+ *
+ * @see https://gitlab.freedesktop.org/xorg/proto/xorgproto/-/blob/master/include/X11/X.h
+ */
+static Error_t _parse_buttonbind_button( config_setting_t *setting, unsigned int *button ) {
+
+	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( button, ERROR_NULL_VALUE, "%s:\"button\"\n", POINTER_NULL_PRINT_STRING );
+
+	const char *button_string = NULL;
+	const Error_t lookup_error = _libconfig_get_string( setting, &button_string );
+
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
+
+	const int alias_index = _parser_find_alias( &BUTTON_ALIAS_INDEX, button_string );
+
+	if ( alias_index >= 0 ) {
+		*button = BUTTON_ALIAS_MAP[ alias_index ].button;
+		return ERROR_NONE;
+	}
+
+	errno = 0;
+	char *end_pointer = NULL;
+	const unsigned long parsed_value = strtoul( button_string, &end_pointer, 10 );
+
+	if ( errno != 0 || end_pointer == button_string || *end_pointer != '\0' ) return ERROR_NULL_VALUE;
+
+	// X11 button mask is only 8 bits, ensure it fits
+	if ( parsed_value == 0 || parsed_value >= Button1Mask ) return ERROR_RANGE;
+
+	*button = (unsigned int) parsed_value;
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief TODO
+ *
+ * TODO
+ *
+ * @param[in] setting Pointer to the buttonbind's "click" setting.
+ * @param[out] click TODO
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if parsed intermediate click string does not
+ * match any alias found in @ref CLICK_ALIAS_MAP.
+ * @return Any error returned from @ref _libconfig_get_string().
+ */
+static Error_t _parse_buttonbind_click( config_setting_t *setting, unsigned int *click ) {
+
+	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( click, ERROR_NULL_VALUE, "%s:\"click\"\n", POINTER_NULL_PRINT_STRING );
+
+	const char *click_string = NULL;
+	const Error_t lookup_error = _libconfig_get_string( setting, &click_string );
+
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
+
+	const int i = _parser_find_alias( &CLICK_ALIAS_INDEX, click_string );
+
+	if ( i < 0 ) return ERROR_NOT_FOUND;
+
+	*click = CLICK_ALIAS_MAP[ i ].click;
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Parse a list of buttonbinds from a libconfig configuration into a list of Button structs.
+ *
+ * TODO
+ *
+ * @param[in] config Pointer to the libconfig configuration containing the buttonbinds to be parsed into @p array.
+ * @param[out] array Pointer to where to dynamically allocate and store all the parsed buttonbinds.
+ * @param[out] count Pointer to where to store the number of buttonbinds to be parsed. This value does not take into
+ * account any failures during parsing the buttonbinds.
+ * @param[out] malloced Boolean to track if @p array has been dynamically allocated yet or not, analogous to if the
+ * default buttonbinds are being used or not. Value is set to `false` after allocation.
+ *
+ * @return TODO
+ *
+ * @note TODO Maybe mention dynamic allocation in _parse_binds_config()?
+ */
+static Errors_t _parse_buttonbinds_config( const config_t *config, Button **array, unsigned int *count, bool *malloced ) {
+
+	Errors_t returned_errors = { 0 };
+	const char *lookup_path = "buttonbinds";
+
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+
+	config_setting_t *array_setting = NULL;
+	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
+	add_error( &returned_errors, lookup_error );
+
+	if ( lookup_error != ERROR_NONE ) {
+		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
+		return returned_errors;
+	}
+
+	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Button ), _parse_buttonbind_adapter, malloced, (void **) array, count );
+	copy_errors( &returned_errors, array_errors );
+
+	return returned_errors;
+}
+
+/**
+ * @brief Capture the live configuration into a configuration generation.
+ *
+ * Copies the parser's global configuration variables into @p generation, including a
+ * dynamically allocated copy of every setting in @ref SETTING_ALIAS_MAP. Ownership of the
+ * memory backing the live configuration moves to @p generation, so the globals must be
+ * replaced (see @ref _parser_apply_generation()) before the generation is freed.
+ *
+ * @param[out] generation Pointer to where to store the live configuration.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_ALLOCATION if memory for the settings failed to be allocated.
+ * Everything else is still captured, with @p settings left NULL.
+ */
+static Error_t _parser_capture_generation( Config_Generation_t *generation ) {
+
+	RETURN_VALUE_IF_NULL( generation, ERROR_NULL_VALUE, "%s:\"generation\"\n", POINTER_NULL_PRINT_STRING );
+
+	generation->keys = keys;
+	generation->buttons = buttons;
+	generation->rules = rules;
+	generation->fonts = fonts;
+	generation->themes = themes;
+
+	generation->keys_count = keys_count;
+	generation->buttons_count = buttons_count;
+	generation->rules_count = rules_count;
+	generation->fonts_count = fonts_count;
+	generation->themes_count = themes_count;
+
+	generation->keys_malloced = keys_malloced;
+	generation->buttons_malloced = buttons_malloced;
+	generation->rules_malloced = rules_malloced;
+	generation->fonts_malloced = fonts_malloced;
+	generation->themes_malloced = themes_malloced;
+
+	memcpy( generation->tags, tags, sizeof( tags ) );
+	memcpy( generation->colors, colors, sizeof( colors ) );
+
+	generation->arena = config_arena;
+
+	errno = 0;
+	generation->settings = calloc( LENGTH( SETTING_ALIAS_MAP ), sizeof( uint64_t ) );
+
+	RETURN_VALUE_IF_NULL( generation->settings, ERROR_ALLOCATION, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, LENGTH( SETTING_ALIAS_MAP ) * sizeof( uint64_t ),
+	                      strerror( errno ) );
+
+	for ( unsigned int i = 0; i < LENGTH( SETTING_ALIAS_MAP ); i++ ) {
+		memcpy( &generation->settings[ i ], SETTING_ALIAS_MAP[ i ].setting, _parser_data_type_size( SETTING_ALIAS_MAP[ i ].type ) );
+	}
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Parse a group setting, like a keybind or a rule, into a struct using a member schema.
+ *
+ * The group's members are walked once, and each is matched to its place in the schema by
+ * name through @p schema's hash table, instead of looking every member up by name. Members
+ * the schema doesn't know are ignored. The members are then parsed in schema order, so a
+ * bind's function is always known by the time its argument is parsed.
+ *
+ * Every member is required, besides the argument of a function that takes none. If any of
+ * them fails to parse, @p element is zeroed so it doesn't have any data left over from
+ * parsing that could cause unusual behavior.
+ *
+ * @param[in] setting Pointer to the libconfig group setting to be parsed into @p element.
+ * @param[in] index Index of @p setting in the larger array. Used purely for debug printing.
+ * @param[in] element_name Name of the kind of element being parsed, used in logs.
+ * @param[in,out] schema Pointer to the index of the @ref Member_Schema_t map describing @p element.
+ * @param[out] element Pointer to the struct where the values parsed from @p setting are stored.
+ * @param[in] element_size Size in bytes of @p element.
+ *
+ * @return Errors of every member that failed to parse, @ref ERROR_NOT_FOUND for missing ones.
+ */
+static Errors_t _parse_element( config_setting_t *setting, const unsigned int index, const char *element_name, Member_Index_t *schema, void *element, const size_t element_size ) {
+
+	Errors_t returned_errors = { 0 };
+
+	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	RETURN_ERRORS_IF_NULL( schema, returned_errors, "%s:\"schema\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	RETURN_ERRORS_IF_NULL( element, returned_errors, "%s:\"element\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+
+	config_setting_t *found_members[ MEMBER_INDEX_SIZE ] = { 0 };
+	const int members_count = config_setting_length( setting );
+
+	for ( int i = 0; i < members_count; i++ ) {
+		config_setting_t *member = config_setting_get_elem( setting, i );
+		const char *name = config_setting_name( member );
+		const int member_index = name ? _parser_find_member( schema, name ) : -1;
+
+		if ( member_index < 0 ) {
+			LOG_DEBUG( "%s %d has an unknown member \"%s\", ignoring it\n", element_name, index + 1, name );
+			continue;
+		}
+
+		found_members[ member_index ] = member;
+	}
+
+	const Member_Schema_t *members = schema->map;
+	bool function_parsed = false;
+	Data_Type_t argument_type = TYPE_NONE;
+	long double argument_min = 0, argument_max = 0;
+
+	for ( unsigned int i = 0; i < schema->length; i++ ) {
+		config_setting_t *member = found_members[ i ];
+		void *field = (char *) element + members[ i ].offset;
+		Error_t error = ERROR_NONE;
+
+		// The argument can't be parsed without knowing its function, which was already warned about
+		if ( members[ i ].type == MEMBER_ARGUMENT && function_parsed == false ) continue;
+
+		if ( member == NULL && ( members[ i ].type != MEMBER_ARGUMENT || argument_type != TYPE_NONE ) ) {
+			error = ERROR_NOT_FOUND;
+		} else {
+			switch ( members[ i ].type ) {
+				case MEMBER_STRING: {
+					error = _libconfig_get_string( member, (const char **) field );
+					if ( error == ERROR_NONE ) error = _parser_intern_string( (const char **) field );
+					break;
+				}
+
+				case MEMBER_INT: {
+					error = _libconfig_get_int( member, members[ i ].range_min, members[ i ].range_max, (int *) field );
+					break;
+				}
+
+				case MEMBER_UINT: {
+					error = _libconfig_get_uint( member, members[ i ].range_min, members[ i ].range_max, (unsigned int *) field );
+					break;
+				}
+
+				case MEMBER_MODIFIER: {
+					error = _parse_bind_modifier( member, (unsigned int *) field );
+					break;
+				}
+
+				case MEMBER_KEYSYM: {
+					error = _parse_keybind_keysym( member, (KeySym *) field );
+					break;
+				}
+
+				case MEMBER_BUTTON: {
+					error = _parse_buttonbind_button( member, (unsigned int *) field );
+					break;
+				}
+
+				case MEMBER_CLICK: {
+					error = _parse_buttonbind_click( member, (unsigned int *) field );
+					break;
+				}
+
+				case MEMBER_FUNCTION: {
+					error = _parse_bind_function( member, (void ( ** )( const Arg * )) field, &argument_type, &argument_min, &argument_max );
+					function_parsed = error == ERROR_NONE;
+					break;
+				}
+
+				case MEMBER_ARGUMENT: {
+					error = _parse_bind_argument( member, argument_type, argument_min, argument_max, (Arg *) field );
+					break;
+				}
+
+				default: {
+					LOG_WARN( "Unknown member type during %s parsing: %d. Please reprogram to a valid type\n", element_name, members[ i ].type );
+					error = ERROR_TYPE;
+					break;
+				}
+			}
+		}
+
+		add_error( &returned_errors, error );
+
+		if ( error != ERROR_NONE ) {
+			LOG_WARN( "%s %d invalid, unable to parse its \"%s\": %s\n", element_name, index + 1, members[ i ].name, ERROR_ENUM_STRINGS[ error ] );
+		}
+	}
+
+	if ( errors_failure_count( &returned_errors ) != 0 ) memset( element, 0, element_size );
+
+	return returned_errors;
+}
+
+/**
+ * @brief TODO
+ *
+ * TODO
+ *
+ * @param[in] setting TODO
+ * @param[in] index TODO
+ * @param[out] font TODO
+ *
+ * @return TODO
+ */
+static Errors_t _parse_font( config_setting_t *setting, const unsigned int index, const char **font ) {
+
+	Errors_t returned_errors = { 0 };
+
+	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+
+	if ( config_setting_type( setting ) != CONFIG_TYPE_STRING ) {
+		LOG_WARN( "Font element at index %u is not a string\n", index );
+		add_error( &returned_errors, ERROR_TYPE );
+		return returned_errors;
+	}
+
+	*font = config_setting_get_string( setting );
+
+	if ( *font == NULL ) {
+		LOG_WARN( "Failed to parse theme font at index %u for unknown an reason\n", index );
+		add_error( &returned_errors, ERROR_NULL_VALUE );
+		return returned_errors;
+	}
+
+	add_error( &returned_errors, _parser_intern_string( font ) );
+
+	return returned_errors;
+}
+
+/**
+ * @brief Thin adapter function to allow for font parsing inside a generic array parsing function.
+ *
+ * See @ref _parse_font() for function documentation.
+ */
+static Errors_t _parse_font_adapter( config_setting_t *setting, const unsigned int index, void *font ) {
+	return _parse_font( setting, index, (const char **) font );
+}
+
+/**
+ * @brief Parse generic configuration settings from a libconfig configuration.
+ *
+ * TODO
+ *
+ * @param[in] config Pointer to the libconfig configuration containing the generic settings to be parsed.
+ *
+ * @return TODO
+ */
+static Errors_t _parse_generic_settings( const config_t *config ) {
+
+	Errors_t returned_errors = { 0 };
+
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+
+	for ( unsigned int i = 0; i < LENGTH( SETTING_ALIAS_MAP ); ++i ) {
+		Error_t returned_error = ERROR_NONE;
+
+		switch ( SETTING_ALIAS_MAP[ i ].type ) {
+			case TYPE_BOOLEAN:
+				returned_error = _libconfig_generic_lookup( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, CONFIG_TYPE_BOOL, SETTING_ALIAS_MAP[ i ].setting );
+				break;
+
+			case TYPE_INT:
+				returned_error = _libconfig_lookup_int( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, (int) SETTING_ALIAS_MAP[ i ].range_min,
+				                                        (int) SETTING_ALIAS_MAP[ i ].range_max, SETTING_ALIAS_MAP[ i ].setting );
+				break;
+
+			case TYPE_UINT:
+				returned_error = _libconfig_lookup_uint( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, (unsigned int) SETTING_ALIAS_MAP[ i ].range_min,
+				                                         (unsigned int) SETTING_ALIAS_MAP[ i ].range_max, SETTING_ALIAS_MAP[ i ].setting );
+				break;
+
+			case TYPE_FLOAT:
+				returned_error = _libconfig_lookup_float( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, (float) SETTING_ALIAS_MAP[ i ].range_min,
+				                                          (float) SETTING_ALIAS_MAP[ i ].range_max, SETTING_ALIAS_MAP[ i ].setting );
+				break;
+
+			case TYPE_STRING:
+				returned_error = _libconfig_lookup_string( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, SETTING_ALIAS_MAP[ i ].setting );
+				if ( returned_error == ERROR_NONE ) returned_error = _parser_intern_string( SETTING_ALIAS_MAP[ i ].setting );
+				break;
+
+			default:
+				returned_error = ERROR_TYPE;
+				LOG_WARN( "Setting \"%s\" is programmed with an invalid type\n", SETTING_ALIAS_MAP[ i ].alias );
+				break;
+		}
+
+		if ( returned_error != ERROR_NONE ) {
+			if ( returned_error == ERROR_NOT_FOUND && SETTING_ALIAS_MAP[ i ].optional ) {
+				LOG_DEBUG( "\"%s\" was not found but is flagged as optional, continuing", SETTING_ALIAS_MAP[ i ].alias );
+			} else {
+				add_error( &returned_errors, returned_error );
+				LOG_WARN( "Issue while parsing \"%s\": %s\n", SETTING_ALIAS_MAP[ i ].alias, ERROR_ENUM_STRINGS[ returned_error ] );
+			}
+		}
+	}
+
+	return returned_errors;
+}
+
+/**
+ * @brief Parse a keybind from a libconfig configuration setting.
+ *
+ * See @ref KEYBIND_SCHEMA for its members and @ref _parse_element() for how they are parsed.
+ *
+ * @param[in] setting Pointer to the libconfig setting containing the keybind to be parsed into @p keybind.
+ * @param[in] index Index of the current keybind in the larger array. Used purely for debug printing.
+ * @param[out] keybind Pointer to the Key struct where the values parsed from @p setting are stored.
+ *
+ * @return Any errors returned from @ref _parse_element().
+ */
+static Errors_t _parse_keybind( config_setting_t *setting, const unsigned int index, Key *keybind ) {
+	return _parse_element( setting, index, "Keybind", &KEYBIND_SCHEMA_INDEX, keybind, sizeof( Key ) );
+}
+
+/**
+ * @brief Thin adapter function to allow for keybind parsing inside a generic array parsing function.
+ *
+ * See @ref _parse_keybind() for function documentation.
+ */
+static Errors_t _parse_keybind_adapter( config_setting_t *setting, const unsigned int index, void *keybind ) {
+	return _parse_keybind( setting, index, (Key *) keybind );
+}
+
+/**
+ * @brief TODO
+ *
+ * TODO
+ *
+ * @param[in] setting Pointer to the keybind's "key" setting.
+ * @param[out] keysym Pointer to where to store the parsed keysym value.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if unable to convert parsed string to keysym.
+ * @return Any error returned from @ref _libconfig_get_string().
+ *
+ * @note `xev` is likely your best bet at finding the keysym values that will work with `XStringToKeysym()`.
+ * If someone knows a better way, please reach out and let me know.
+ *
+ * @see https://gitlab.freedesktop.org/xorg/app/xev
+ * @see https://gitlab.freedesktop.org/xorg/lib/libx11/-/blob/master/src/StrKeysym.c?ref_type=heads#L74
+ */
+static Error_t _parse_keybind_keysym( config_setting_t *setting, KeySym *keysym ) {
+
+	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( keysym, ERROR_NULL_VALUE, "%s:\"keysym\"\n", POINTER_NULL_PRINT_STRING );
+
+	const char *keybind_string = NULL;
+	const Error_t lookup_error = _libconfig_get_string( setting, &keybind_string );
+
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
+
+	*keysym = XStringToKeysym( keybind_string );
+
+	if ( *keysym == NoSymbol ) {
+		LOG_WARN( "Failed to convert string (\"%s\") to keysym\n", keybind_string );
+		return ERROR_NOT_FOUND;
+	}
+
+	// The upper case return of XConvertCase(), which we don't use.
+	KeySym unused = 0;
+	XConvertCase( *keysym, keysym, &unused );
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Parse a list of keybinds from a libconfig configuration into a list of
+ * Key structs.
+ *
+ * TODO
+ *
+ * @param[in] config Pointer to the libconfig configuration containing the keybinds to be parsed into @p array.
+ * @param[out] array Pointer to where to dynamically allocate memory and store all the parsed keybinds.
+ * @param[out] count Pointer to where to store the number of keybinds to be parsed. This value does not take
+ * into account any failures during parsing the keybinds.
+ * @param[out] malloced Boolean to track if @p array has been dynamically allocated yet or not, analogous to if
+ * the default keybinds are being used or not. Value is set to `false` after allocation.
+ *
+ * @return TODO
+ *
+ * @note TODO Maybe mention dynamic allocation in _parse_binds_config()?
+ */
+static Errors_t _parse_keybinds_config( const config_t *config, Key **array, unsigned int *count, bool *malloced ) {
+
+	Errors_t returned_errors = { 0 };
+	const char *lookup_path = "keybinds";
+
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+
+	config_setting_t *array_setting = NULL;
+	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
+	add_error( &returned_errors, lookup_error );
+
+	if ( lookup_error != ERROR_NONE ) {
+		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
+		return returned_errors;
+	}
+
+	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Key ), _parse_keybind_adapter, malloced, (void **) array, count );
+	copy_errors( &returned_errors, array_errors );
+
+	return returned_errors;
+}
+
+/**
+ * @brief Loads the configuration from a snapshot instead of parsing the configuration file.
+ *
+ * This function memory maps the snapshot written by @ref _parser_write_snapshot() and, if it
+ * was written from @p source_filepath and that file's contents haven't changed since (as told
+ * by @p source_info), loads the fully resolved configuration straight out of it. The bind, rule,
+ * and font arrays, as well as every string, like tags, colors, fonts, rule fields, and string
+ * arguments, are copied into @ref config_arena, so the mapping is released before returning.
+ * Nothing is changed unless the snapshot is valid in its entirety.
+ *
+ * @param[in] source_filepath Path to the configuration file the snapshot must have been written from.
+ * @param[in] source_info Identity of the current contents of @p source_filepath.
+ *
+ * @return @ref ERROR_NONE if the configuration was loaded from the snapshot.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if there is no snapshot, or it was written from a different file.
+ * @return @ref ERROR_TYPE if the snapshot was written by an incompatible build.
+ * @return @ref ERROR_RANGE if the snapshot is stale, truncated, or malformed.
+ * @return @ref ERROR_ALLOCATION if memory for the arrays or strings failed to be allocated.
+ * @return @ref ERROR_IO if the snapshot failed to be memory mapped.
+ */
+static Error_t _parser_load_snapshot( const char *source_filepath, const Source_Info_t *source_info ) {
+
+	RETURN_VALUE_IF_NULL( source_filepath, ERROR_NULL_VALUE, "%s:\"source_filepath\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( source_info, ERROR_NULL_VALUE, "%s:\"source_info\"\n", POINTER_NULL_PRINT_STRING );
+
+	char *snapshot_filepath = get_data_filepath( SNAPSHOT_FILENAME, false );
+
+	RETURN_VALUE_IF_NULL( snapshot_filepath, ERROR_NOT_FOUND, "Failed to get snapshot file path\n" );
+
+	FILE *snapshot_file = fopen( snapshot_filepath, "rb" );
+	free( snapshot_filepath );
+
+	if ( snapshot_file == NULL ) {
+		LOG_DEBUG( "No configuration snapshot found\n" );
+		return ERROR_NOT_FOUND;
+	}
+
+	struct stat stat_variable;
+	if ( fstat( fileno( snapshot_file ), &stat_variable ) != 0 || (uint64_t) stat_variable.st_size < sizeof( Snapshot_Header_t ) ) {
+		LOG_WARN( "Configuration snapshot is unreadable or truncated, ignoring it\n" );
+		fclose( snapshot_file );
+		return ERROR_RANGE;
+	}
+
+	const size_t mapping_size = stat_variable.st_size;
+
+	errno = 0;
+	void *mapping = mmap( NULL, mapping_size, PROT_READ, MAP_PRIVATE, fileno( snapshot_file ), 0 );
+	fclose( snapshot_file );
+
+	if ( mapping == MAP_FAILED ) {
+		LOG_WARN( "Failed to memory map configuration snapshot: %s\n", strerror( errno ) );
+		return ERROR_IO;
+	}
+
+	Snapshot_Layout_t layout;
+	const Error_t validate_error = _parser_validate_snapshot( mapping, mapping_size, source_filepath, source_info, &layout );
+
+	if ( validate_error != ERROR_NONE ) {
+		munmap( mapping, mapping_size );
+		return validate_error;
+	}
+
+	const Snapshot_Header_t *header = layout.header;
+
+	// A snapshot rejected past this point leaves its arrays behind in the arena,
+	// they are released along with the rest of it
+	Key *snapshot_keys = _parser_arena_alloc( config_arena, header->keys_count, sizeof( Key ) );
+	Button *snapshot_buttons = _parser_arena_alloc( config_arena, header->buttons_count, sizeof( Button ) );
+	Rule *snapshot_rules = header->rules_count ? _parser_arena_alloc( config_arena, header->rules_count, sizeof( Rule ) ) : NULL;
+	const char **snapshot_fonts = header->fonts_count ? _parser_arena_alloc( config_arena, header->fonts_count, sizeof( char * ) ) : NULL;
+	Theme_t *snapshot_themes = header->themes_count ? _parser_arena_alloc( config_arena, header->themes_count, sizeof( Theme_t ) ) : NULL;
+	const char *snapshot_tags[ LENGTH( tags ) ];
+	const char *snapshot_colors[ LENGTH( THEME_ALIAS_MAP ) ];
+	const char *snapshot_strings[ LENGTH( SETTING_ALIAS_MAP ) ] = { 0 };
+
+	Error_t decode_error = ERROR_NONE;
+
+	if ( snapshot_keys == NULL || snapshot_buttons == NULL || ( header->rules_count && snapshot_rules == NULL ) || ( header->fonts_count && snapshot_fonts == NULL ) ||
+	     ( header->themes_count && snapshot_themes == NULL ) ) {
+		LOG_ERROR( "%s for the configuration snapshot's arrays\n", FAILED_ALLOC_PRINT_STRING );
+		decode_error = ERROR_ALLOCATION;
+	}
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < header->keys_count; i++ ) {
+		const Snapshot_Key_t *record = &layout.keys[ i ];
+		snapshot_keys[ i ].mod = record->modifier;
+		snapshot_keys[ i ].keysym = record->keysym;
+		decode_error = _parser_snapshot_unpack_argument( &layout, record->function, record->argument, &snapshot_keys[ i ].func, &snapshot_keys[ i ].arg );
+	}
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < header->buttons_count; i++ ) {
+		const Snapshot_Button_t *record = &layout.buttons[ i ];
+		snapshot_buttons[ i ].click = record->click;
+		snapshot_buttons[ i ].mask = record->modifier;
+		snapshot_buttons[ i ].button = record->button;
+		decode_error = _parser_snapshot_unpack_argument( &layout, record->function, record->argument, &snapshot_buttons[ i ].func, &snapshot_buttons[ i ].arg );
+	}
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < header->rules_count; i++ ) {
+		const Snapshot_Rule_t *record = &layout.rules[ i ];
+		snapshot_rules[ i ].tags = record->tags;
+		snapshot_rules[ i ].isfloating = record->isfloating;
+		snapshot_rules[ i ].monitor = record->monitor;
+		decode_error = _parser_snapshot_string( &layout, record->class, &snapshot_rules[ i ].class );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_snapshot_string( &layout, record->instance, &snapshot_rules[ i ].instance );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_snapshot_string( &layout, record->title, &snapshot_rules[ i ].title );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &snapshot_rules[ i ].class );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &snapshot_rules[ i ].instance );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &snapshot_rules[ i ].title );
+	}
+
+	// Each theme's fonts are ended by a NULL offset, which must not appear anywhere else
+	unsigned int themes_decoded = 0, theme_fonts_start = 0;
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < header->fonts_count; i++ ) {
+		if ( header->themes_count && layout.fonts[ i ] == SNAPSHOT_NULL_INDEX ) {
+			if ( themes_decoded == header->themes_count || i == theme_fonts_start ) {
+				decode_error = ERROR_RANGE;
+				break;
+			}
+			snapshot_themes[ themes_decoded ].fonts = &snapshot_fonts[ theme_fonts_start ];
+			snapshot_themes[ themes_decoded ].fonts_count = i - theme_fonts_start;
+			themes_decoded++;
+			theme_fonts_start = i + 1;
+			continue;
+		}
+		decode_error = _parser_snapshot_string( &layout, layout.fonts[ i ], &snapshot_fonts[ i ] );
+		if ( decode_error == ERROR_NONE && snapshot_fonts[ i ] == NULL ) decode_error = ERROR_RANGE;
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &snapshot_fonts[ i ] );
+	}
+
+	if ( decode_error == ERROR_NONE && ( themes_decoded != header->themes_count || ( header->themes_count && theme_fonts_start != header->fonts_count ) ) ) {
+		decode_error = ERROR_RANGE;
+	}
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < LENGTH( tags ); i++ ) {
+		decode_error = _parser_snapshot_string( &layout, layout.tags[ i ], &snapshot_tags[ i ] );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &snapshot_tags[ i ] );
+	}
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < header->colors_count; i++ ) {
+		const char *color = NULL;
+		decode_error = _parser_snapshot_string( &layout, layout.colors[ i ], &color );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &color );
+		if ( i < LENGTH( THEME_ALIAS_MAP ) ) snapshot_colors[ i ] = color;
+		if ( header->themes_count ) *THEME_COLOR( &snapshot_themes[ i / LENGTH( THEME_ALIAS_MAP ) ], i % LENGTH( THEME_ALIAS_MAP ) ) = color;
+	}
+
+	for ( unsigned int i = 0; decode_error == ERROR_NONE && i < LENGTH( SETTING_ALIAS_MAP ); i++ ) {
+		if ( SETTING_ALIAS_MAP[ i ].type != TYPE_STRING ) continue;
+		decode_error = _parser_snapshot_string( &layout, layout.settings[ i ], &snapshot_strings[ i ] );
+		if ( decode_error == ERROR_NONE ) decode_error = _parser_intern_string( &snapshot_strings[ i ] );
+	}
+
+	if ( decode_error != ERROR_NONE ) {
+		LOG_WARN( "Configuration snapshot is malformed, ignoring it: %s\n", ERROR_ENUM_STRINGS[ decode_error ] );
+		munmap( mapping, mapping_size );
+		return decode_error;
+	}
+
+	// Everything has been validated, nothing past this point can fail
+	keys = snapshot_keys;
+	keys_count = header->keys_count;
+	keys_malloced = true;
+
+	buttons = snapshot_buttons;
+	buttons_count = header->buttons_count;
+	buttons_malloced = true;
+
+	if ( snapshot_rules != NULL ) {
+		rules = snapshot_rules;
+		rules_count = header->rules_count;
+		rules_malloced = true;
+	}
+
+	if ( snapshot_themes != NULL ) {
+		themes = snapshot_themes;
+		themes_count = header->themes_count;
+		themes_malloced = true;
+		fonts = themes[ 0 ].fonts;
+		fonts_count = themes[ 0 ].fonts_count;
+		fonts_malloced = true;
+	} else if ( snapshot_fonts != NULL ) {
+		fonts = snapshot_fonts;
+		fonts_count = header->fonts_count;
+		fonts_malloced = true;
+	}
+
+	for ( unsigned int i = 0; i < LENGTH( tags ); i++ ) {
+		tags[ i ] = snapshot_tags[ i ];
+	}
+
+	for ( unsigned int i = 0; i < LENGTH( THEME_ALIAS_MAP ); i++ ) {
+		*THEME_ALIAS_MAP[ i ].color = snapshot_colors[ i ];
+	}
+
+	for ( unsigned int i = 0; i < LENGTH( SETTING_ALIAS_MAP ); i++ ) {
+		if ( SETTING_ALIAS_MAP[ i ].type == TYPE_STRING ) {
+			*(const char **) SETTING_ALIAS_MAP[ i ].setting = snapshot_strings[ i ];
+		} else {
+			memcpy( SETTING_ALIAS_MAP[ i ].setting, &layout.settings[ i ], _parser_data_type_size( SETTING_ALIAS_MAP[ i ].type ) );
+		}
+	}
+
+	munmap( mapping, mapping_size );
+
+	LOG_INFO( "Configuration loaded from snapshot, skipping parsing\n" );
+
+	return ERROR_NONE;
+}
+
+/**
+ * @brief Parse the configuration read into @ref libconfig_config.
+ *
+ * Runs every parsing pass over @ref libconfig_config, storing the results in the parser's
+ * global configuration variables. If the configuration parsed cleanly, it is then backed up
+ * and snapshotted by @ref _parser_backup_config(), in a writer process of its own.
+ *
+ * @param[in] source_info Pointer to the identity of the configuration file's contents, used
+ * to write the snapshot. No snapshot is written if it isn't valid.
+ *
+ * @return An @ref Errors_t struct containing all collected errors (including @ref ERROR_NONE).
+ */
+static Errors_t _parse_loaded_config( const Source_Info_t *source_info ) {
+
+	Errors_t parsing_errors = { 0 };
+
+	RETURN_ERRORS_IF_NULL( libconfig_config, parsing_errors, "%s:\"libconfig_config\"\n", POINTER_NULL_PRINT_STRING );
+
+	config_set_options( libconfig_config, CONFIG_OPTION_AUTOCONVERT | CONFIG_OPTION_SEMICOLON_SEPARATORS );
+
+	TIME_PHASE( PHASE_SETTINGS, copy_errors( &parsing_errors, _parse_generic_settings( libconfig_config ) ) );
+	TIME_PHASE( PHASE_KEYBINDS, copy_errors( &parsing_errors, _parse_keybinds_config( libconfig_config, &keys, &keys_count, &keys_malloced ) ) );
+	TIME_PHASE( PHASE_BUTTONBINDS, copy_errors( &parsing_errors, _parse_buttonbinds_config( libconfig_config, &buttons, &buttons_count, &buttons_malloced ) ) );
+	TIME_PHASE( PHASE_RULES, copy_errors( &parsing_errors, _parse_rules_config( libconfig_config, &rules, &rules_count, &rules_malloced ) ) );
+	TIME_PHASE( PHASE_TAGS, copy_errors( &parsing_errors, _parse_tags_config( libconfig_config ) ) );
+	TIME_PHASE( PHASE_THEME, copy_errors( &parsing_errors, _parse_theme_config( libconfig_config ) ) );
+
+	// The error requirement being 0 may be a bit strict, I am not sure. May need
+	// some relaxing or possibly come up with a better way of calculating if a config
+	// passes, or is valid enough to warrant backing up.
+	if ( errors_failure_count( &parsing_errors ) == 0 && keys_malloced && buttons_malloced && !_parser_fallback_config_loaded ) {
+		Error_t backup_error = ERROR_NONE;
+		TIME_PHASE( PHASE_BACKUP, backup_error = _parser_backup_config( libconfig_config, source_info ) );
+		add_error( &parsing_errors, backup_error );
+	} else {
+		if ( keys_malloced == false || buttons_malloced == false ) {
+			LOG_WARN( "Not saving config as backup, as hardcoded default bind values were used, not the user's\n" );
+		}
+		if ( _parser_fallback_config_loaded == true ) {
+			LOG_WARN( "Not saving config as backup, as the parsed configuration file is a system fallback configuration\n" );
+		}
+		if ( errors_failure_count( &parsing_errors ) != 0 ) {
+			LOG_WARN( "Not saving config as backup, as the parsed config had too many (%d) errors\n", errors_failure_count( &parsing_errors ) );
+		}
+	}
+
+	LOG_DEBUG( "Parsing errors: %d\n", errors_failure_count( &parsing_errors ) );
 
-		// Copy path segment to stat
-		strncpy( current_path, normalized_path, current_path_length );
-		strcpy( current_path + current_path_length, "" );
+	return parsing_errors;
+}
 
-		errno = 0;
-		if ( stat( current_path, &stat_variable ) < 0 ) {
-			if ( errno == ENOENT ) {
-				LOG_DEBUG( "Making directory %s\n", current_path );
-				if ( mkdir( current_path, 0700 ) < 0 ) {
-					LOG_ERROR( "Failed to make directory \"%s\": %s\n", current_path, strerror( errno ) );
-					free( normalized_path );
-					return -1;
-				}
-			} else {
-				LOG_ERROR( "Error stat-ing directory \"%s\": %s\n", current_path, strerror( errno ) );
-				free( normalized_path );
-				return -1;
-			}
+/**
+ * @brief Attempts to find, open, and store a valid libconfig configuration file.
+ *
+ * This function handles most of the high level logic regarding finding, opening,
+ * validating, and storing a libconfig configuration file. This function will first
+ * search for a custom configuration file, passed in using @p config_filepath. If that
+ * is not found, a list of default directories are searched. If still no user configuration
+ * is found, a user's last configuration backup will be attempted to be loaded. If again
+ * unsuccessful, a system default configuration file will be loaded. Finally, if all else
+ * fails, the function will return and the program will rely on the hardcoded default values
+ * loaded from config.h
+ *
+ * @param[in] config TODO
+ * @param[in] custom_config_filepath TODO
+ * @param[out] found_config_filepath TODO
+ * @param[out] fallback_config_loaded TODO
+ * @param[out] source_info Pointer to where to store the identity of the found configuration file's contents,
+ * used to validate and write configuration snapshots.
+ * @param[out] snapshot_loaded Set to `true` if the configuration was loaded from a still valid snapshot of the
+ * found configuration file (see @ref _parser_load_snapshot()) instead of being read into @p config.
+ *
+ * @return TODO
+ *
+ * @todo These error returns may not be the most accurate, not sure exactly the best fits.
+ * @todo Should the parser even look for another config file if one is passed from the CLI? Could be deceptive behavior.
+ */
+static Errors_t _parser_open_config_file( config_t *config, const char *custom_config_filepath, char **found_config_filepath, bool *fallback_config_loaded, Source_Info_t *source_info,
+                                          bool *snapshot_loaded ) {
+
+	Errors_t returned_errors = { 0 };
+
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_ERRORS_IF_NULL( found_config_filepath, returned_errors, "%s:\"found_config_filepath\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_ERRORS_IF_NULL( fallback_config_loaded, returned_errors, "%s:\"fallback_config_loaded\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_ERRORS_IF_NULL( source_info, returned_errors, "%s:\"source_info\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_ERRORS_IF_NULL( snapshot_loaded, returned_errors, "%s:\"snapshot_loaded\"\n", POINTER_NULL_PRINT_STRING );
+
+	char *xdg_config_home = get_xdg_config_home();
+	char *xdg_data_home = get_xdg_data_home();
+
+	const struct Filepath {
+		const char *filepath_1;
+		const char *filepath_2;
+		const bool is_fallback_config;
+	} config_filepaths[ ] = {
+		{ custom_config_filepath, "", false },
+		{ xdg_config_home, "/dwm.conf", false },
+		{ xdg_config_home, "/dwm/dwm.conf", false },
+		{ xdg_data_home, "/dwm/dwm_last.conf", true },
+		{ "/etc/dwm.conf", "", true }
+	};
+
+	for ( unsigned int i = 0; i < LENGTH( config_filepaths ); i++ ) {
+		char constructed_path[ PATH_MAX ];
+
+		if ( config_filepaths[ i ].filepath_1 != NULL && config_filepaths[ i ].filepath_2 != NULL ) {
+			snprintf( constructed_path, sizeof( constructed_path ), "%s%s", config_filepaths[ i ].filepath_1, config_filepaths[ i ].filepath_2 );
+		} else {
+			LOG_DEBUG( "Part of a path at index %d was NULL while trying top open a configuration file, skipping invalid path\n", i );
+			continue;
 		}
 
-		// Continue to next path segment
-		walk += distance_to_slash;
+		const Error_t read_error = _parser_read_config_file( config, constructed_path, config_filepaths[ i ].is_fallback_config, source_info, snapshot_loaded );
+
+		if ( read_error != ERROR_NONE ) {
+			if ( read_error != ERROR_NOT_FOUND ) add_error( &returned_errors, read_error );
+			continue;
+		}
+
+		*found_config_filepath = estrdup( constructed_path );
+		if ( *found_config_filepath == NULL ) add_error( &returned_errors, ERROR_ALLOCATION );
+
+		*fallback_config_loaded = config_filepaths[ i ].is_fallback_config;
+
+		break;
 	}
 
-	free( normalized_path );
-	return 0;
+	free( xdg_config_home );
+	free( xdg_data_home );
+
+	return returned_errors;
 }
 
 /**
- * @brief Normalize a file or folder path to remove repeat forward slash characters.
+ * @brief Read a single configuration file.
+ *
+ * Opens @p filepath and either loads the configuration from its still valid snapshot
+ * (see @ref _parser_load_snapshot()), or reads it into @p config for parsing.
+ *
+ * @param[in,out] config Pointer to the libconfig configuration to read the file into.
+ * @param[in] filepath Path to the configuration file to read.
+ * @param[in] is_fallback_config Whether @p filepath is a fallback configuration. Snapshots
+ * are only ever written from user configurations, so none is looked for if it is.
+ * @param[out] source_info Pointer to where to store the identity of the file's contents.
+ * @param[out] snapshot_loaded Set to `true` if the configuration was loaded from a snapshot
+ * instead of being read into @p config.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided, or the file has syntax errors.
+ * @return @ref ERROR_NOT_FOUND if the file can't be opened.
+ */
+static Error_t _parser_read_config_file( config_t *config, const char *filepath, const bool is_fallback_config, Source_Info_t *source_info, bool *snapshot_loaded ) {
+
+	RETURN_VALUE_IF_NULL( config, ERROR_NULL_VALUE, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( filepath, ERROR_NULL_VALUE, "%s:\"filepath\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( source_info, ERROR_NULL_VALUE, "%s:\"source_info\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( snapshot_loaded, ERROR_NULL_VALUE, "%s:\"snapshot_loaded\"\n", POINTER_NULL_PRINT_STRING );
+
+	LOG_DEBUG( "Attempting to open config file \"%s\"\n", filepath );
+
+	FILE *configuration_file = fopen( filepath, "r" );
+
+	if ( configuration_file == NULL ) {
+		LOG_DEBUG( "Unable to open config file \"%s\"\n", filepath );
+		return ERROR_NOT_FOUND;
+	}
+
+	if ( _parser_read_source_info( configuration_file, source_info ) != ERROR_NONE ) {
+		LOG_WARN( "Unable to identify the contents of config file \"%s\", its snapshot will not be used\n", filepath );
+	}
+
+	Error_t returned_error = ERROR_NONE;
+
+	Error_t snapshot_error = ERROR_NOT_FOUND;
+	int read_result = CONFIG_TRUE;
+
+	if ( source_info->valid && is_fallback_config == false ) {
+		TIME_PHASE( PHASE_SNAPSHOT_LOAD, snapshot_error = _parser_load_snapshot( filepath, source_info ) );
+	}
+
+	if ( snapshot_error == ERROR_NONE ) {
+		*snapshot_loaded = true;
+	} else {
+		TIME_PHASE( PHASE_READ, read_result = config_read( config, configuration_file ) );
+
+		if ( read_result == CONFIG_FALSE ) {
+			LOG_WARN( "Problem parsing config file \"%s\", line %d: %s\n", filepath, config_error_line( config ), config_error_text( config ) );
+			returned_error = ERROR_NULL_VALUE;
+		}
+	}
+
+	fclose( configuration_file );
+
+	return returned_error;
+}
+
+/**
+ * @brief Parse a rule from a libconfig configuration setting.
+ *
+ * See @ref RULE_SCHEMA for its members and @ref _parse_element() for how they are parsed.
+ *
+ * @param[in] setting Pointer to the libconfig setting containing the rule to be parsed into @p rule.
+ * @param[in] index Index of the current rule in the larger array. Used purely for debug printing.
+ * @param[out] rule Pointer to the Rule struct where the values parsed from @p setting are stored.
+ *
+ * @return Any errors returned from @ref _parse_element().
+ */
+static Errors_t _parse_rule( config_setting_t *setting, const unsigned int index, Rule *rule ) {
+	return _parse_element( setting, index, "Rule", &RULE_SCHEMA_INDEX, rule, sizeof( Rule ) );
+}
+
+/**
+ * @brief Thin adapter function to allow for rule parsing inside a generic array parsing function.
+ *
+ * See @ref _parse_rule() for function documentation.
+ */
+static Errors_t _parse_rule_adapter( config_setting_t *setting, const unsigned int index, void *rule ) {
+	return _parse_rule( setting, index, (Rule *) rule );
+}
+
+/**
+ * @brief Parse a list of rules from a libconfig configuration into a list of Rule structs.
  *
  * TODO
  *
- * @param[in] original_path String containing the path to be normalized.
- * @param[out] normalized_path Pointer to where to store the normalized path. It is dynamically
- * allocated and will need to be manually freed.
+ * @param[in] config Pointer to the libconfig configuration containing the rules to be parsed into @p array.
+ * @param[out] array Pointer to where to dynamically allocate memory and store all the parsed rules.
+ * @param[out] count Pointer to where to store the number of rules to be parsed. This value does not take into account
+ * any failures during parsing the rules.
+ * @param[out] malloced Boolean to track if @p array has been dynamically allocated yet or not, analogous
+ * to if the default rules are being used or not. Value is set to `false` after allocation.
  *
- * @return 0 on success, -1 on failure.
+ * @return TODO
  *
- * @note
- * 	-# @p normalized_path can be dynamically allocated and will need to be manually freed.
- * 	-# This function is derived from [dwm-ipc's](https://github.com/mihirlad55/dwm-ipc) `normalizepath()`.
- * Credit more or less goes to [Mihir Lad](mihirlad55@gmail.com), I just made some minor adjustments.
+ * @todo Check for NULL pointers from function arguments. Possible able to use lookup_path in logs instead of repeating message
+ */
+static Errors_t _parse_rules_config( const config_t *config, Rule **array, unsigned int *count, bool *malloced ) {
+
+	Errors_t returned_errors = { 0 };
+	const char *lookup_path = "rules";
+
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+
+	config_setting_t *array_setting = NULL;
+	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
+	add_error( &returned_errors, lookup_error );
+
+	if ( lookup_error != ERROR_NONE ) {
+		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
+		return returned_errors;
+	}
+
+	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Rule ), _parse_rule_adapter, malloced, (void **) array, count );
+	copy_errors( &returned_errors, array_errors );
+
+	return returned_errors;
+}
+
+/**
+ * @brief TODO
  *
- * @author Mihir Lad - <mihirlad55@gmail.com>
+ * TODO
  *
- * @see https://github.com/mihirlad55/dwm-ipc
- * @see https://github.com/mihirlad55/dwm-ipc/blob/b3eebba7c043482d454afc5c882f513fc1b157ad/util.c#L40
+ * @param[in] setting TODO
+ * @param[in] element_size TODO
+ * @param[in] array_element_parser_function TODO
+ * @param[in,out] malloced TODO
+ * @param[in,out] parsed_config TODO
+ * @param[out] parsed_config_length TODO
+ *
+ * @return TODO
+ *
+ * @todo It may be worth trying to add some kind of safeguard to fall back on default config if enough
+ * elements fail to be parsed. For example, if the keybinds all (or many) fail, it could soft-lock the
+ * user in the program. Not sure best way to do that, or if it is even the best idea to add.
+ *
+ * @todo The logic around @p malloced and null checking @p parsed_config before allocation is brittle, needs work.
  */
-int normalize_path( const char *original_path, char **normalized_path ) {
+static Errors_t _parse_setting_array( const config_setting_t *setting, const size_t element_size, const Array_Element_Parser_Function_t array_element_parser_function, bool *malloced,
+                                      void **parsed_config, unsigned int *parsed_config_length ) {
 
-	RETURN_VALUE_IF_NULL( original_path, -1, "%s:\"original_path\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( normalized_path, -1, "%s:\"normalized_path\"\n", POINTER_NULL_PRINT_STRING );
+	Errors_t returned_errors = { 0 };
 
-	const size_t original_length = strlen( original_path );
+	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_ERRORS_IF_NULL( parsed_config_length, returned_errors, "%s:\"parsed_config_length\"\n", POINTER_NULL_PRINT_STRING );
 
-	errno = 0;
-	*normalized_path = calloc( ( original_length + 1 ), sizeof( char ) );
+	const char *setting_name = NULL;
+	const Error_t setting_name_error = _libconfig_get_setting_name( setting, &setting_name );
 
-	RETURN_VALUE_IF_NULL( *normalized_path, -1, "%s (%lu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, ( original_length + 1 ) * sizeof( char ), strerror(errno) );
+	if ( setting_name_error != ERROR_NONE ) {
+		LOG_WARN( "Unable to acquire setting name, logs in this function may not print correctly: %s\n", ERROR_ENUM_STRINGS[ setting_name_error ] );
+	}
 
-	size_t new_length = 0;
-	const char *match, *walk = original_path;
-	while ( ( match = strchr( walk, '/' ) ) ) {
+	*parsed_config_length = config_setting_length( setting );
+	if ( *parsed_config_length == 0 ) {
+		LOG_ERROR( "No %s listed. Default values will be used\n", setting_name );
+		add_error( &returned_errors, ERROR_NOT_FOUND );
+		return returned_errors;
+	}
 
-		// Copy everything between match and walk
-		strncpy( *normalized_path + new_length, walk, match - walk );
-		new_length += match - walk;
-		walk += match - walk;
+	LOG_DEBUG( "%u elements detected in \"%s\"\n", *parsed_config_length, setting_name );
 
-		// Skip all repeating slashes
-		while ( *walk == '/' ) walk++;
+	// malloced is also used to determine if we should dynamically
+	// allocate the array or if it is already allocated some other
+	// way, usually on the stack, as well as report that it has
+	// been dynamically allocated here.
+	if ( malloced != NULL && parsed_config != NULL ) {
+
+		if ( element_size == 0 ) {
+			LOG_ERROR( "Cannot allocate memory correctly if element size to allocate is 0\n" );
+			add_error( &returned_errors, ERROR_RANGE );
+			return returned_errors;
+		}
+
+		LOG_DEBUG( "Allocating %zu bytes of memory for \"%s\" from the configuration arena\n", *parsed_config_length * element_size, setting_name );
+
+		void *allocated_memory = _parser_arena_alloc( config_arena, *parsed_config_length, element_size );
+
+		if ( allocated_memory == NULL ) {
+			LOG_ERROR( "Failed to allocate %zu bytes for \"%s\"\n", *parsed_config_length * element_size, setting_name );
+			add_error( &returned_errors, ERROR_ALLOCATION );
+			return returned_errors;
+		}
 
-		// If not last character in path
-		if ( walk != original_path + original_length ) ( *normalized_path )[ new_length++ ] = '/';
+		*parsed_config = allocated_memory;
+		*malloced = true;
+
+		_parser_report.array_bytes += *parsed_config_length * element_size;
+		_parser_report.array_count++;
 	}
 
-	( *normalized_path )[ new_length++ ] = '\0';
+	for ( unsigned int i = 0; i < *parsed_config_length; i++ ) {
 
-	// Copy remaining path
-	strcat( *normalized_path, walk );
-	new_length += strlen( walk );
+		config_setting_t *child_setting = config_setting_get_elem( setting, i );
 
-	errno = 0;
-	*normalized_path = realloc( *normalized_path, new_length * sizeof( char ) );
+		RETURN_ERRORS_IF_NULL( child_setting, returned_errors, "Element index %u in \"%s\" returned NULL\n", i, setting_name );
+
+		// Yes, parsed_config can be NULL, that is intended. It is used by things like
+		// theme or tag parsing that rely on global values.
+		void *element = parsed_config ? (char *) ( *parsed_config ) + ( i * element_size ) : NULL;
 
-	RETURN_VALUE_IF_NULL( *normalized_path, -1, "%s (%lu bytes) using realloc(): %s\n", FAILED_ALLOC_PRINT_STRING, new_length * sizeof( char ), strerror(errno) );
+		const Errors_t parsing_error = array_element_parser_function( child_setting, i, element );
 
-	return 0;
+		if ( errors_failure_count( &parsing_error ) ) {
+			LOG_WARN( "\"%s\" element number %u failed to be parsed. It had %d errors\n", setting_name, i + 1, errors_failure_count( &parsing_error ) );
+			copy_errors( &returned_errors, parsing_error );
+			continue;
+		}
+	}
+
+	return returned_errors;
 }
 
 /**
- * @brief Set current layout to floating.
+ * @brief TODO
  *
- * This is a wrapper for the `setlayout()` function. It sets the
- * currently focused monitor's layout to the floating layout found
- * in the layouts array.
+ * TODO
  *
- * @param arg Unused.
+ * @param[in] setting TODO
+ * @param[out] index TODO
+ *
+ * @return TODO
  */
-void setlayout_floating( const Arg *arg ) {
-
-	const Layout *layout = get_layout( NULL ); // NULL is floating layout's arrange function
+static Errors_t _parse_tag( config_setting_t *setting, const unsigned int index ) {
 
-	RETURN_IF_NULL( layout, "Failed to get floating layout" );
+	Errors_t returned_errors = { 0 };
 
-	setlayout( &(Arg){ .v = layout } );
-}
+	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
 
-/**
- * @brief Set current layout to monocle.
- *
- * This is a wrapper for the `setlayout()` function. It sets the
- * currently focused monitor's layout to the monocle layout found in
- * the layouts array.
- *
- * @param arg Unused.
- */
-void setlayout_monocle( const Arg *arg ) {
+	if ( index >= LENGTH( tags ) ) {
+		LOG_WARN( "Parsed tag's index exceeds limits of the tags array\n" );
+		add_error( &returned_errors, ERROR_RANGE );
+		return returned_errors;
+	}
 
-	const Layout *layout = get_layout( monocle );
+	const char *original_tag_name = tags[ index ];
 
-	RETURN_IF_NULL( layout, "Failed to get monocle layout" );
+	if ( config_setting_type( setting ) != CONFIG_TYPE_STRING ) {
+		LOG_WARN( "Tag element at index %u is not a string\n", index );
+		add_error( &returned_errors, ERROR_TYPE );
+		return returned_errors;
+	}
 
-	setlayout( &(Arg){ .v = layout } );
-}
+	tags[ index ] = config_setting_get_string( setting );
 
-/**
- * @brief Set current layout to tile.
- *
- * This is a wrapper for the `setlayout()` function. It sets the
- * currently focused monitor's layout to the tile layout found in the
- * layouts array.
- *
- * @param arg Unused.
- */
-void setlayout_tiled( const Arg *arg ) {
+	if ( tags[ index ] == NULL ) {
+		tags[ index ] = original_tag_name;
+		LOG_WARN( "Failed to parse tag at index %u for unknown an reason\n", index );
+		add_error( &returned_errors, ERROR_NULL_VALUE );
+		return returned_errors;
+	}
 
-	const Layout *layout = get_layout( tile );
+	const Error_t intern_error = _parser_intern_string( &tags[ index ] );
 
-	RETURN_IF_NULL( layout, "Failed to get tile layout" );
+	if ( intern_error != ERROR_NONE ) {
+		tags[ index ] = original_tag_name;
+		add_error( &returned_errors, intern_error );
+		return returned_errors;
+	}
 
-	setlayout( &(Arg){ .v = layout } );
+	return returned_errors;
 }
 
 /**
- * @brief Wrapper around `spawn()` for simpler program spawning.
- *
- * This wrapper is to simplify the parsers interaction with the
- * `spawn()` function. It takes in the program name and arguments
- * as a string from Arg, prepares them with the necessary shell
- * executable and flag, and then passes it all to `spawn()`.
+ * @brief Thin adapter function to allow for tag parsing inside a generic array parsing function.
  *
- * @param[in] arg Pointer to the Arg struct containing a null
- * terminated string containing the name and arguments of the program
- * to spawn.
+ * See @ref _parse_tag() for function documentation.
  */
-void spawn_string( const Arg *arg ) {
-
-	RETURN_IF_NULL( arg, "%s:\"arg\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_IF_NULL( arg->v, "%s:\"arg->v\"\n", POINTER_NULL_PRINT_STRING );
-
-	const char *cmd = arg->v;
-	char *argv[ ] = { "/bin/sh", "-c", (char *) cmd, NULL };
-	const Arg tmp = { .v = argv };
-
-	LOG_DEBUG( "Attempting to spawn \"%s\"\n", (char *) cmd );
-	spawn( &tmp );
+static Errors_t _parse_tags_adapter( config_setting_t *setting, const unsigned int index, void *unused ) {
+	return _parse_tag( setting, index );
 }
 
-/////////////////////////////////////
-///// Parser internal functions /////
-/////////////////////////////////////
-
 /**
- * @brief Backs up a libconfig configuration to disk.
+ * @brief Parse a list of tags from a libconfig configuration.
  *
- * This function backs up the given libconfig config_t,
- * @p config, following the XDG specification. If the function
- * @ref get_xdg_data_home() fails to find the XDG data directory
- * (which is likely), we will default to using "~/.local/share/"
- * instead. Meaning that, in the latter case, the filepath to
- * the backup file will be "~/.local/share/dwm/dwm_last.conf".
- * "/dwm/dwm_last.conf" will always be appended to the end of
- * whatever path is returned by @ref get_xdg_data_home().
- * The backup file is then created and written to by libconfig's
- * `config_write_file()`.
+ * TODO
  *
- * @param[in] config Pointer to the libconfig configuration
- * to be backed up.
+ * @param[in] config Pointer to the libconfig configuration containing the tags to be parsed.
  *
- * @return @ref ERROR_NONE on success.
- * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_NOT_FOUND if the call to @ref get_xdg_data_home() failed
- * to provide necessary directory.
- * @return @ref ERROR_ALLOCATION if any calls to @ref extend_string() were unable
- * to allocate necessary memory to construct the complete backup filepath.
- * @return @ref ERROR_IO if libconfig failed to write @p config to a file.
+ * @return TODO
  */
-static Error_t _parser_backup_config( config_t *config ) {
-
-	RETURN_VALUE_IF_NULL( config, ERROR_NULL_VALUE, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+static Errors_t _parse_tags_config( const config_t *config ) {
 
-	// Save xdg data directory to buffer (~/.local/share)
-	char *buffer = get_xdg_data_home();
+	const char *lookup_path = "tags";
+	unsigned int tags_count = 0;
+	Errors_t returned_errors = { 0 };
 
-	RETURN_VALUE_IF_NULL( buffer, ERROR_NOT_FOUND, "Failed to get parent backup directory path\n" );
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
 
-	// Append buffer (already has "~/.local/share" or other xdg data directory)
-	// with the directory we want to backup the config to, create the directory
-	// if it doesn't exist, and then extend with the filename we want to backup
-	// to config in.
-	extend_string( &buffer, "/dwm/" );
-	RETURN_VALUE_IF_NULL( buffer, ERROR_ALLOCATION, "%s for backup directory path\n", FAILED_ALLOC_PRINT_STRING );
+	config_setting_t *array_setting = NULL;
+	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
+	add_error( &returned_errors, lookup_error );
 
-	if ( make_directory_path( buffer ) != 0 ) return ERROR_IO;
+	if ( lookup_error != ERROR_NONE ) {
+		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
+		return returned_errors;
+	}
 
-	extend_string( &buffer, "dwm_last.conf" );
-	RETURN_VALUE_IF_NULL( buffer, ERROR_ALLOCATION, "%s for backup file path\n", FAILED_ALLOC_PRINT_STRING );
+	const Errors_t array_errors = _parse_setting_array( array_setting, 0, _parse_tags_adapter, NULL, NULL, &tags_count );
+	copy_errors( &returned_errors, array_errors );
 
-	if ( config_write_file( config, buffer ) == CONFIG_FALSE ) {
-		LOG_ERROR( "Failed to write configuration to \"%s\"\n", buffer );
-		free( buffer );
-		return ERROR_IO;
+	if ( tags_count > LENGTH( tags ) ) {
+		LOG_WARN( "More than %zu tag names detected (%u were detected) while parsing config, only the first %zu will be used\n", LENGTH( tags ), tags_count, LENGTH( tags ) );
+	} else if ( tags_count < LENGTH( tags ) ) {
+		LOG_WARN( "Less than %zu tag names detected while parsing config, default tags will be used for the remainder\n", LENGTH( tags ) );
 	}
 
-	LOG_INFO( "Current config backed up to \"%s\"\n", buffer );
-	free( buffer );
-
-	return ERROR_NONE;
+	return returned_errors;
 }
 
 /**
- * @brief TODO
+ * @brief Parse a theme from a libconfig configuration setting.
  *
- * TODO
+ * The first theme starts out with the current fonts and colors, usually the defaults, and every
+ * later theme starts out with the first theme's, so a member that fails to parse falls back to them.
+ * Later themes may also leave members out entirely, without it being an error.
  *
- * @param[in] setting TODO
- * @param[in] argument_type Enum describing the type of data stored in @p parsed_argument.
- * @param[in] range_min Minimum value @p parsed_argument can have. Only applies to numerical types.
- * @param[in] range_max Maximum value @p parsed_argument can have. Only applies to numerical types.
- * @param[out] argument Pointer to an Arg struct where the parsed value of type @p argument_type
- * in range @p range_min to @p range_max will be stored.
+ * @param[in] setting Pointer to the libconfig setting containing the theme to be parsed.
+ * @param[in] index Index of the current theme being parsed.
+ * @param[out] theme Pointer to where to store the parsed theme.
  *
- * @return @ref ERROR_NONE on success.
- * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_TYPE if @p argument_type does not match any case in the switch statement.
- * @return Any error returned from any of the `_libconfig_setting_lookup_TYPE()` functions.
+ * @return Errors of every member of the theme that failed to parse.
  */
-static Error_t _parse_bind_argument( config_setting_t *setting, const Data_Type_t argument_type, const long double range_min, const long double range_max, Arg *argument ) {
+static Errors_t _parse_theme( config_setting_t *setting, const unsigned int index, Theme_t *theme ) {
 
-	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( argument, ERROR_NULL_VALUE, "%s:\"argument\"\n", POINTER_NULL_PRINT_STRING );
+	Errors_t returned_errors = { 0 };
 
-	const char *argument_path = "argument";
-	Error_t lookup_error = ERROR_NONE;
-	switch ( argument_type ) {
-		case TYPE_NONE: {
-			return ERROR_NONE;
-		}
+	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	RETURN_ERRORS_IF_NULL( theme, returned_errors, "%s:\"theme\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
 
-		case TYPE_BOOLEAN: {
-			lookup_error = _libconfig_generic_lookup( setting, argument_path, CONFIG_TYPE_BOOL, (bool *) &argument->ui );
-			break;
-		}
+	if ( index > 0 ) {
+		*theme = themes[ 0 ];
+	} else {
+		theme->fonts = fonts;
+		theme->fonts_count = fonts_count;
+		memcpy( theme->colors, colors, sizeof( colors ) );
+	}
 
-		case TYPE_INT: {
-			lookup_error = _libconfig_lookup_int( setting, argument_path, range_min, range_max, &argument->i );
-			break;
-		}
+	// Find every member in a single pass, instead of looking each one up by name
+	const char *fonts_lookup_path = "fonts";
+	config_setting_t *fonts_setting = NULL;
+	config_setting_t *color_settings[ LENGTH( THEME_ALIAS_MAP ) ] = { 0 };
+	const int members_count = config_setting_length( setting );
 
-		case TYPE_UINT: {
-			lookup_error = _libconfig_lookup_uint( setting, argument_path, range_min, range_max, &argument->ui );
-			break;
-		}
+	for ( int i = 0; i < members_count; i++ ) {
+		config_setting_t *member = config_setting_get_elem( setting, i );
+		const char *name = config_setting_name( member );
 
-		case TYPE_FLOAT: {
-			lookup_error = _libconfig_lookup_float( setting, argument_path, range_min, range_max, &argument->f );
-			break;
+		if ( name == NULL ) continue;
+
+		if ( strcmp( name, fonts_lookup_path ) == 0 ) {
+			fonts_setting = member;
+			continue;
 		}
 
-		case TYPE_STRING: {
-			lookup_error = _libconfig_lookup_string( setting, argument_path, (const char **) &argument->v );
-			break;
+		const int color_index = _parser_find_member( &THEME_MEMBER_INDEX, name );
+		if ( color_index >= 0 ) color_settings[ color_index ] = member;
+	}
+
+	config_setting_t *array_setting = NULL;
+	const Error_t lookup_error = _libconfig_get_value( fonts_setting, CONFIG_TYPE_LIST, &array_setting );
+
+	// Only the first theme has to be complete, later ones can leave members out to keep its values
+	if ( lookup_error == ERROR_NOT_FOUND && index > 0 ) {
+		LOG_DEBUG( "Theme %d has no \"%s\", using the first theme's\n", index, fonts_lookup_path );
+	} else if ( lookup_error != ERROR_NONE ) {
+		add_error( &returned_errors, lookup_error );
+		LOG_ERROR( "Lookup of theme %d's \"%s\" failed: %s\n", index, fonts_lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
+	} else {
+		bool fonts_allocated = false;
+		const char **theme_fonts = NULL;
+		unsigned int theme_fonts_count = 0;
+		const Errors_t font_errors = _parse_setting_array( array_setting, sizeof( char * ), _parse_font_adapter, &fonts_allocated, (void **) &theme_fonts, &theme_fonts_count );
+		copy_errors( &returned_errors, font_errors );
+
+		if ( fonts_allocated && theme_fonts_count > 0 ) {
+			theme->fonts = theme_fonts;
+			theme->fonts_count = theme_fonts_count;
 		}
+	}
 
-		default: {
-			LOG_WARN( "Unknown argument type during bind parsing: %d. Please reprogram to a valid type\n", argument_type );
-			return ERROR_TYPE;
+	for ( unsigned int i = 0; i < LENGTH( THEME_ALIAS_MAP ); i++ ) {
+		const char *color = NULL;
+		Error_t error = _libconfig_get_string( color_settings[ i ], &color );
+		if ( error == ERROR_NONE ) error = _parser_intern_string( &color );
+		if ( error == ERROR_NOT_FOUND && index > 0 ) continue;
+		add_error( &returned_errors, error );
+		if ( error != ERROR_NONE ) {
+			LOG_WARN( "Failed to parse theme %d's element \"%s\": %s\n", index, THEME_ALIAS_MAP[ i ].alias, ERROR_ENUM_STRINGS[ error ] );
+			continue;
 		}
+		*THEME_COLOR( theme, i ) = color;
 	}
 
-	return lookup_error;
+	return returned_errors;
 }
 
 /**
- * @brief TODO
+ * @brief Thin adapter function to allow for theme parsing inside a generic array parsing function.
  *
- * TODO
+ * See @ref _parse_theme() for function documentation.
+ */
+static Errors_t _parse_theme_adapter( config_setting_t *setting, const unsigned int index, void *theme ) {
+	return _parse_theme( setting, index, theme );
+}
+
+/**
+ * @brief Parse a list of themes from a libconfig configuration.
  *
- * @param[in] setting TODO
- * @param[in] bind_index TODO
- * @param[out] modifier TODO
- * @param[out] function TODO
- * @param[out] argument TODO
+ * Every theme is parsed into @ref themes, so dwm can load them all up front and switch between
+ * them without parsing anything again. The first theme is also made the current @ref fonts and
+ * @ref colors.
  *
- * @return TODO
+ * @param[in] config Pointer to the libconfig configuration containing the themes to be parsed.
+ *
+ * @return Errors of every theme that failed to parse.
  */
-static Errors_t _parse_bind_core( config_setting_t *setting, const unsigned int bind_index, unsigned int *modifier, void ( **function )( const Arg * ), Arg *argument ) {
+static Errors_t _parse_theme_config( const config_t *config ) {
 
 	Errors_t returned_errors = { 0 };
+	const char *lookup_path = "themes";
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( modifier, returned_errors, "%s:\"modifier\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( function, returned_errors, "%s:\"function\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( argument, returned_errors, "%s:\"argument\"\n", POINTER_NULL_PRINT_STRING );
-
-	const char *setting_name = NULL;
-	const Error_t setting_name_error = _libconfig_get_setting_name( setting, &setting_name );
-	add_error( &returned_errors, setting_name_error );
-
-	if ( setting_name_error != ERROR_NONE ) {
-		LOG_WARN( "Unable to acquire setting name, logs in this function may not print correctly: %s\n", ERROR_ENUM_STRINGS[ setting_name_error ] );
-	}
+	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
 
-	const Error_t modifier_error = _parse_bind_modifier( setting, modifier );
-	add_error( &returned_errors, modifier_error );
+	config_setting_t *array_setting = NULL;
+	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
+	add_error( &returned_errors, lookup_error );
 
-	if ( modifier_error != ERROR_NONE ) {
-		LOG_WARN( "\"%s\" index %d invalid, unable to parse the bind's modifier: %s\n", setting_name, bind_index + 1, ERROR_ENUM_STRINGS[ modifier_error ] );
+	if ( lookup_error != ERROR_NONE ) {
+		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
 		return returned_errors;
 	}
 
-	Data_Type_t argument_type = TYPE_NONE;
-	long double range_min = 0, range_max = 0;
-	const Error_t bind_error = _parse_bind_function( setting, function, &argument_type, &range_min, &range_max );
-	add_error( &returned_errors, bind_error );
+	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Theme_t ), _parse_theme_adapter, &themes_malloced, (void **) &themes, &themes_count );
+	copy_errors( &returned_errors, array_errors );
 
-	if ( bind_error != ERROR_NONE ) {
-		LOG_WARN( "\"%s\" index %d invalid, unable to parse the bind's function: %s\n", setting_name, bind_index + 1, ERROR_ENUM_STRINGS[ bind_error ] );
+	if ( themes_malloced == false ) {
+		themes = NULL;
+		themes_count = 0;
 		return returned_errors;
 	}
 
-	const Error_t argument_error = _parse_bind_argument( setting, argument_type, range_min, range_max, argument );
-	add_error( &returned_errors, argument_error );
-
-	if ( argument_error != ERROR_NONE ) {
-		LOG_WARN( "\"%s\" index %d invalid, unable to parse the bind's arguments: %s\n", setting_name, bind_index + 1, ERROR_ENUM_STRINGS[ argument_error ] );
-		return returned_errors;
-	}
+	if ( themes[ 0 ].fonts != fonts ) fonts_malloced = true;
+	fonts = themes[ 0 ].fonts;
+	fonts_count = themes[ 0 ].fonts_count;
+	memcpy( colors, themes[ 0 ].colors, sizeof( colors ) );
 
 	return returned_errors;
 }
 
 /**
- * @brief TODO
+ * @brief Validates a configuration snapshot image against its source configuration file.
  *
- * TODO
+ * This function checks that the snapshot image at @p image was written by a compatible build,
+ * is internally consistent, and was written from the file at @p source_filepath while it had the
+ * same size, modification time, and content hash that it has now. Individual records are range
+ * checked as they are decoded by @ref _parser_load_snapshot().
  *
- * @param[in] setting TODO
- * @param[out] function TODO
- * @param[out] argument_type Pointer to where to store the data type of the Arg that can be passed to @p function.
- * @param[out] range_min Pointer to where to store the minimum value of the Arg that can be passed to @p function.
- * @param[out] range_max Pointer to where to store the maximum value of the Arg that can be passed to @p function.
+ * @param[in] image Pointer to the snapshot image.
+ * @param[in] image_size Size in bytes of @p image.
+ * @param[in] source_filepath Path to the configuration file the snapshot must have been written from.
+ * @param[in] source_info Identity of the current contents of @p source_filepath.
+ * @param[out] layout Pointer to where to store the location of each of the snapshot's sections.
  *
- * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NONE if the snapshot is valid.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_NOT_FOUND if parsed intermediate function string does not match any alias found in @ref FUNCTION_ALIAS_MAP.
- * @return Any error returned from @ref _libconfig_setting_lookup_string().
+ * @return @ref ERROR_NOT_FOUND if the snapshot was written from a different file.
+ * @return @ref ERROR_TYPE if the snapshot was written by an incompatible build.
+ * @return @ref ERROR_RANGE if the snapshot is stale, truncated, or malformed.
  */
-static Error_t _parse_bind_function( config_setting_t *setting, void ( **function )( const Arg * ), Data_Type_t *argument_type, long double *range_min, long double *range_max ) {
+static Error_t _parser_validate_snapshot( void *image, const uint64_t image_size, const char *source_filepath, const Source_Info_t *source_info, Snapshot_Layout_t *layout ) {
 
-	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( function, ERROR_NULL_VALUE, "%s:\"function\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( argument_type, ERROR_NULL_VALUE, "%s:\"argument_type\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( range_min, ERROR_NULL_VALUE, "%s:\"range_min\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( range_max, ERROR_NULL_VALUE, "%s:\"range_max\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( image, ERROR_NULL_VALUE, "%s:\"image\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( source_filepath, ERROR_NULL_VALUE, "%s:\"source_filepath\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( source_info, ERROR_NULL_VALUE, "%s:\"source_info\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( layout, ERROR_NULL_VALUE, "%s:\"layout\"\n", POINTER_NULL_PRINT_STRING );
 
-	const char *function_string = NULL;
-	const Error_t lookup_error = _libconfig_lookup_string( setting, "function", &function_string );
+	if ( image_size < sizeof( Snapshot_Header_t ) ) return ERROR_RANGE;
+
+	const Snapshot_Header_t *header = image;
+
+	if ( memcmp( header->magic, SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) ) != 0 || header->version != SNAPSHOT_VERSION || header->header_size != sizeof( Snapshot_Header_t ) ) {
+		LOG_INFO( "Configuration snapshot was written by an incompatible version of dwm, ignoring it\n" );
+		return ERROR_TYPE;
+	}
+
+	if ( header->schema_hash != _parser_snapshot_schema_hash() ) {
+		LOG_INFO( "Configuration snapshot was written by a build with different alias maps, ignoring it\n" );
+		return ERROR_TYPE;
+	}
+
+	if ( header->tags_count != LENGTH( tags ) || header->colors_count != LENGTH( THEME_ALIAS_MAP ) * MAX( header->themes_count, 1 ) || header->fonts_count < header->themes_count ||
+	     header->settings_count != LENGTH( SETTING_ALIAS_MAP ) || header->keys_count == 0 ||
+	     header->buttons_count == 0 || _parser_snapshot_layout( image, image_size, layout ) != ERROR_NONE || layout->fixed_size + header->strings_size != image_size ||
+	     header->strings_size == 0 || layout->strings[ header->strings_size - 1 ] != '\0' ) {
+		LOG_WARN( "Configuration snapshot is truncated or malformed, ignoring it\n" );
+		return ERROR_RANGE;
+	}
 
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	const char *snapshot_source_filepath = NULL;
+	if ( _parser_snapshot_string( layout, header->source_filepath, &snapshot_source_filepath ) != ERROR_NONE || snapshot_source_filepath == NULL ||
+	     strcmp( snapshot_source_filepath, source_filepath ) != 0 ) {
+		LOG_DEBUG( "Configuration snapshot was written from a different config file, ignoring it\n" );
+		return ERROR_NOT_FOUND;
+	}
 
-	for ( unsigned int i = 0; i < LENGTH( FUNCTION_ALIAS_MAP ); i++ ) {
-		if ( strcasecmp( function_string, FUNCTION_ALIAS_MAP[ i ].alias ) == 0 ) {
-			*function = FUNCTION_ALIAS_MAP[ i ].function;
-			*argument_type = FUNCTION_ALIAS_MAP[ i ].argument_type;
-			*range_min = FUNCTION_ALIAS_MAP[ i ].range_min;
-			*range_max = FUNCTION_ALIAS_MAP[ i ].range_max;
-			return ERROR_NONE;
-		}
+	if ( header->source_size != source_info->size || header->source_mtime_seconds != source_info->mtime_seconds || header->source_mtime_nanoseconds != source_info->mtime_nanoseconds ||
+	     header->source_hash != source_info->hash ) {
+		LOG_INFO( "Config file \"%s\" changed since its snapshot was written, parsing it instead\n", source_filepath );
+		return ERROR_RANGE;
 	}
 
-	return ERROR_NOT_FOUND;
+	return ERROR_NONE;
 }
 
 /**
- * @brief TODO
+ * @brief Writes the configuration backup, unless it is already up to date.
  *
- * TODO
+ * This function serializes @p config in memory and hashes it, and only writes it out
+ * if the existing backup's contents hash differently, so an unchanged configuration
+ * never causes a write. The backup is written to a temporary file next to it, synced,
+ * and renamed over it, so a crash at any point leaves either the old or the new backup
+ * in place, never a partial one. See @ref _parser_backup_config().
  *
- * @param[in] setting TODO
- * @param[out] modifier TODO
+ * @param[in] config Pointer to the libconfig configuration to be backed up.
  *
- * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NONE on success, including when the backup was already up to date.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_ALLOCATION if @ref estrdup() fails to allocate memory.
- * @return @ref ERROR_NOT_FOUND if parsed intermediate modifier string does not
- * match any alias found in @ref MODIFIER_ALIAS_MAP.
- * @return Any error returned from @ref _libconfig_setting_lookup_string().
- *
- * @see https://gitlab.freedesktop.org/xorg/proto/xorgproto/-/blob/master/include/X11/X.h
+ * @return @ref ERROR_NOT_FOUND if the backup file path could not be constructed.
+ * @return @ref ERROR_ALLOCATION if @p config failed to be serialized in memory.
+ * @return @ref ERROR_IO if the backup failed to be written.
  */
-static Error_t _parse_bind_modifier( config_setting_t *setting, unsigned int *modifier ) {
+static Error_t _parser_write_backup( const config_t *config ) {
 
-	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( modifier, ERROR_NULL_VALUE, "%s:\"modifier\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( config, ERROR_NULL_VALUE, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
 
-	const char *modifier_string = NULL;
-	const Error_t lookup_error = _libconfig_lookup_string( setting, "modifier", &modifier_string );
+	char *backup_filepath = get_data_filepath( BACKUP_FILENAME, true );
 
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	RETURN_VALUE_IF_NULL( backup_filepath, ERROR_NOT_FOUND, "Failed to get backup file path\n" );
 
-	char *buffer = estrdup( modifier_string );
+	char *data = NULL;
+	size_t data_size = 0;
+	errno = 0;
+	FILE *stream = open_memstream( &data, &data_size );
 
-	if ( buffer == NULL ) return ERROR_ALLOCATION;
+	if ( stream == NULL ) {
+		LOG_ERROR( "%s to serialize the configuration backup: %s\n", FAILED_ALLOC_PRINT_STRING, strerror( errno ) );
+		free( backup_filepath );
+		return ERROR_ALLOCATION;
+	}
 
-	char *modifier_token = strtok( buffer, "+" );
-	while ( modifier_token != NULL ) {
+	config_write( config, stream );
 
-		while ( *modifier_token == ' ' || *modifier_token == '\t' ) modifier_token++;
+	if ( fclose( stream ) != 0 || data == NULL ) {
+		LOG_ERROR( "%s to serialize the configuration backup\n", FAILED_ALLOC_PRINT_STRING );
+		free( data );
+		free( backup_filepath );
+		return ERROR_ALLOCATION;
+	}
 
-		char *end = modifier_token + strlen( modifier_token ) - 1;
-		while ( end > modifier_token && ( *end == ' ' || *end == '\t' ) ) {
-			*end = '\0';
-			end--;
+	// Hash the existing backup in chunks and compare it against the new one
+	FILE *backup_file = fopen( backup_filepath, "rb" );
+
+	if ( backup_file != NULL ) {
+		uint64_t backup_hash = FNV1A_OFFSET_BASIS;
+		size_t backup_size = 0;
+		char chunk[ 4096 ];
+		size_t chunk_size;
+
+		while ( ( chunk_size = fread( chunk, 1, sizeof( chunk ), backup_file ) ) > 0 ) {
+			backup_hash = _parser_fnv1a_hash( chunk, chunk_size, backup_hash );
+			backup_size += chunk_size;
 		}
 
-		bool found = false;
-		for ( unsigned int i = 0; i < LENGTH( MODIFIER_ALIAS_MAP ); i++ ) {
-			if ( strcasecmp( modifier_token, MODIFIER_ALIAS_MAP[ i ].alias ) == 0 ) {
-				*modifier |= MODIFIER_ALIAS_MAP[ i ].modifier;
-				found = true;
-				break;
-			}
+		const bool read_failed = ferror( backup_file );
+		fclose( backup_file );
+
+		if ( !read_failed && backup_size == data_size && backup_hash == _parser_fnv1a_hash( data, data_size, FNV1A_OFFSET_BASIS ) ) {
+			LOG_INFO( "Config backup \"%s\" is already up to date\n", backup_filepath );
+			free( data );
+			free( backup_filepath );
+			return ERROR_NONE;
 		}
+	}
 
-		if ( found == false ) {
-			LOG_WARN( "Invalid modifier: \"%s\"\n", modifier_token );
-			free( buffer );
-			return ERROR_NOT_FOUND;
+	char *temporary_filepath = join_strings( backup_filepath, ".XXXXXX" );
+	Error_t write_error = ERROR_NONE;
+	int temporary_fd = -1;
+
+	if ( temporary_filepath == NULL || ( temporary_fd = mkstemp( temporary_filepath ) ) < 0 ) {
+		write_error = ERROR_IO;
+	} else {
+		FILE *temporary_file = fdopen( temporary_fd, "wb" );
+
+		if ( temporary_file == NULL ) {
+			close( temporary_fd );
+			write_error = ERROR_IO;
+		} else {
+			if ( fwrite( data, 1, data_size, temporary_file ) != data_size ) write_error = ERROR_IO;
+			if ( fflush( temporary_file ) != 0 || fsync( fileno( temporary_file ) ) != 0 ) write_error = ERROR_IO;
+			if ( fclose( temporary_file ) != 0 ) write_error = ERROR_IO;
+			if ( write_error == ERROR_NONE && rename( temporary_filepath, backup_filepath ) != 0 ) write_error = ERROR_IO;
 		}
 
-		modifier_token = strtok( NULL, "+" );
+		if ( write_error != ERROR_NONE ) remove( temporary_filepath );
 	}
 
-	free( buffer );
+	if ( write_error == ERROR_NONE ) {
+		LOG_INFO( "Current config backed up to \"%s\"\n", backup_filepath );
+	} else {
+		LOG_ERROR( "Failed to write configuration backup to \"%s\": %s\n", backup_filepath, strerror( errno ) );
+	}
 
-	return ERROR_NONE;
+	free( temporary_filepath );
+	free( backup_filepath );
+	free( data );
+
+	return write_error;
 }
 
 /**
- * @brief TODO
+ * @brief Writes the currently loaded configuration to a snapshot file.
  *
- * TODO
+ * This function flattens the parsed keybinds, buttonbinds, rules, fonts, tags, colors, and the values
+ * of every setting in @ref SETTING_ALIAS_MAP into a snapshot image (see @ref Snapshot_Header_t), and
+ * writes it to "dwm_last.snapshot", next to the configuration backup written by @ref _parser_backup_config().
+ * As long as @p source_filepath stays unchanged, the next start will load it with @ref _parser_load_snapshot()
+ * instead of parsing. Functions are stored as indexes into @ref FUNCTION_ALIAS_MAP and strings as offsets
+ * into the snapshot's string table, so nothing in the image depends on where dwm is loaded in memory.
+ * The image is written to a temporary file of its own first, synced, and renamed into place, like the
+ * backup in @ref _parser_write_backup(), so neither an interrupted write nor two writers of quick reloads
+ * can leave a partial or mixed snapshot behind.
  *
- * @param[in] setting TODO
- * @param[in] index TODO
- * @param[out] buttonbind TODO
+ * @param[in] source_filepath Path to the configuration file the current configuration was parsed from.
+ * @param[in] source_info Identity of the contents of @p source_filepath when it was parsed.
  *
- * @return TODO
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_ALLOCATION if memory for the snapshot image failed to be allocated.
+ * @return @ref ERROR_NOT_FOUND if a bind's function is not present in @ref FUNCTION_ALIAS_MAP.
+ * @return @ref ERROR_RANGE if the string table outgrows what the snapshot can address.
+ * @return @ref ERROR_IO if the snapshot file failed to be written.
  */
-static Errors_t _parse_buttonbind( config_setting_t *setting, const unsigned int index, Button *buttonbind ) {
+static Error_t _parser_write_snapshot( const char *source_filepath, const Source_Info_t *source_info ) {
+
+	RETURN_VALUE_IF_NULL( source_filepath, ERROR_NULL_VALUE, "%s:\"source_filepath\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( source_info, ERROR_NULL_VALUE, "%s:\"source_info\"\n", POINTER_NULL_PRINT_STRING );
+
+	Snapshot_Header_t header = { 0 };
+	memcpy( header.magic, SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) );
+	header.version = SNAPSHOT_VERSION;
+	header.header_size = sizeof( Snapshot_Header_t );
+	header.schema_hash = _parser_snapshot_schema_hash();
+	header.source_hash = source_info->hash;
+	header.source_size = source_info->size;
+	header.source_mtime_seconds = source_info->mtime_seconds;
+	header.source_mtime_nanoseconds = source_info->mtime_nanoseconds;
+	header.keys_count = keys_count;
+	header.buttons_count = buttons_count;
+	header.rules_count = rules_malloced ? rules_count : 0;
+	header.fonts_count = fonts_malloced ? fonts_count : 0;
+	header.themes_count = themes_malloced ? themes_count : 0;
+	header.tags_count = LENGTH( tags );
+	header.colors_count = LENGTH( THEME_ALIAS_MAP ) * MAX( header.themes_count, 1 );
+
+	if ( header.themes_count ) {
+		header.fonts_count = 0;
+		for ( unsigned int i = 0; i < themes_count; i++ ) {
+			header.fonts_count += themes[ i ].fonts_count + 1;
+		}
+	}
+	header.settings_count = LENGTH( SETTING_ALIAS_MAP );
 
-	Errors_t returned_errors = { 0 };
+	const uint64_t fixed_size = _parser_snapshot_fixed_size( &header );
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
-	RETURN_ERRORS_IF_NULL( buttonbind, returned_errors, "%s:\"buttonbind\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	errno = 0;
+	char *image = calloc( 1, fixed_size );
 
-	copy_errors( &returned_errors, _parse_bind_core( setting, index, &buttonbind->mask, &buttonbind->func, &buttonbind->arg ) );
+	RETURN_VALUE_IF_NULL( image, ERROR_ALLOCATION, "%s (%llu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, (unsigned long long) fixed_size, strerror(errno) );
 
-	const Error_t button_error = _parse_buttonbind_button( setting, &buttonbind->button );
-	add_error( &returned_errors, button_error );
+	memcpy( image, &header, sizeof( header ) );
 
-	if ( button_error != ERROR_NONE ) {
-		LOG_WARN( "Buttonbind %d invalid, unable to parse the bind's button: %s\n", index + 1, ERROR_ENUM_STRINGS[ button_error ] );
-		return returned_errors;
+	Snapshot_Layout_t layout;
+	_parser_snapshot_layout( image, fixed_size, &layout );
+
+	Snapshot_Strings_t strings = { 0 };
+	Error_t pack_error = _parser_snapshot_add_string( &strings, source_filepath, &layout.header->source_filepath );
+
+	for ( unsigned int i = 0; pack_error == ERROR_NONE && i < header.keys_count; i++ ) {
+		Snapshot_Key_t *record = &layout.keys[ i ];
+		record->modifier = keys[ i ].mod;
+		record->keysym = keys[ i ].keysym;
+		pack_error = _parser_snapshot_pack_argument( &strings, keys[ i ].func, &keys[ i ].arg, &record->function, &record->argument );
 	}
 
-	const Error_t click_error = _parse_buttonbind_click( setting, &buttonbind->click );
-	add_error( &returned_errors, click_error );
+	for ( unsigned int i = 0; pack_error == ERROR_NONE && i < header.buttons_count; i++ ) {
+		Snapshot_Button_t *record = &layout.buttons[ i ];
+		record->click = buttons[ i ].click;
+		record->modifier = buttons[ i ].mask;
+		record->button = buttons[ i ].button;
+		pack_error = _parser_snapshot_pack_argument( &strings, buttons[ i ].func, &buttons[ i ].arg, &record->function, &record->argument );
+	}
 
-	if ( click_error != ERROR_NONE ) {
-		LOG_WARN( "Buttonbind %d invalid, unable to parse the bind's click: %s\n", index + 1, ERROR_ENUM_STRINGS[ click_error ] );
+	for ( unsigned int i = 0; pack_error == ERROR_NONE && i < header.rules_count; i++ ) {
+		Snapshot_Rule_t *record = &layout.rules[ i ];
+		record->tags = rules[ i ].tags;
+		record->isfloating = rules[ i ].isfloating;
+		record->monitor = rules[ i ].monitor;
+		pack_error = _parser_snapshot_add_string( &strings, rules[ i ].class, &record->class );
+		if ( pack_error == ERROR_NONE ) pack_error = _parser_snapshot_add_string( &strings, rules[ i ].instance, &record->instance );
+		if ( pack_error == ERROR_NONE ) pack_error = _parser_snapshot_add_string( &strings, rules[ i ].title, &record->title );
 	}
 
-	// Ensure button is zeroed and doesn't accidentally have any
-	// data left over from parsing that could cause unusual behavior
-	if ( errors_failure_count( &returned_errors ) != 0 ) {
-		buttonbind->click = 0;
-		buttonbind->mask = 0;
-		buttonbind->button = 0;
-		buttonbind->func = NULL;
-		buttonbind->arg.i = 0;
+	for ( unsigned int i = 0; pack_error == ERROR_NONE && i < LENGTH( SETTING_ALIAS_MAP ); i++ ) {
+		if ( SETTING_ALIAS_MAP[ i ].type == TYPE_STRING ) {
+			uint32_t offset = SNAPSHOT_NULL_INDEX;
+			pack_error = _parser_snapshot_add_string( &strings, *(const char **) SETTING_ALIAS_MAP[ i ].setting, &offset );
+			layout.settings[ i ] = offset;
+		} else {
+			memcpy( &layout.settings[ i ], SETTING_ALIAS_MAP[ i ].setting, _parser_data_type_size( SETTING_ALIAS_MAP[ i ].type ) );
+		}
 	}
 
-	return returned_errors;
-}
+	if ( header.themes_count ) {
+		uint32_t *font_offset = layout.fonts;
+		for ( unsigned int i = 0; i < themes_count; i++ ) {
+			for ( unsigned int j = 0; pack_error == ERROR_NONE && j < themes[ i ].fonts_count; j++ ) {
+				pack_error = _parser_snapshot_add_string( &strings, themes[ i ].fonts[ j ], font_offset++ );
+			}
+			*font_offset++ = SNAPSHOT_NULL_INDEX;
+		}
+	} else {
+		for ( unsigned int i = 0; pack_error == ERROR_NONE && i < header.fonts_count; i++ ) {
+			pack_error = _parser_snapshot_add_string( &strings, fonts[ i ], &layout.fonts[ i ] );
+		}
+	}
 
-/**
- * @brief Thin adapter function to allow for buttonbind parsing inside a generic array parsing function.
- *
- * See @ref _parse_buttonbind() for function documentation.
- */
-static Errors_t _parse_buttonbind_adapter( config_setting_t *setting, const unsigned int index, void *buttonbind ) {
-	return _parse_buttonbind( setting, index, (Button *) buttonbind );
+	for ( unsigned int i = 0; pack_error == ERROR_NONE && i < LENGTH( tags ); i++ ) {
+		pack_error = _parser_snapshot_add_string( &strings, tags[ i ], &layout.tags[ i ] );
+	}
+
+	for ( unsigned int i = 0; pack_error == ERROR_NONE && i < header.colors_count; i++ ) {
+		const char *color = header.themes_count ? *THEME_COLOR( &themes[ i / LENGTH( THEME_ALIAS_MAP ) ], i % LENGTH( THEME_ALIAS_MAP ) ) : *THEME_ALIAS_MAP[ i ].color;
+		pack_error = _parser_snapshot_add_string( &strings, color, &layout.colors[ i ] );
+	}
+
+	if ( pack_error != ERROR_NONE ) {
+		LOG_ERROR( "Failed to build configuration snapshot: %s\n", ERROR_ENUM_STRINGS[ pack_error ] );
+		free( strings.data );
+		free( image );
+		return pack_error;
+	}
+
+	layout.header->strings_size = strings.size;
+
+	char *snapshot_filepath = get_data_filepath( SNAPSHOT_FILENAME, true );
+	char *temporary_filepath = snapshot_filepath ? join_strings( snapshot_filepath, ".XXXXXX" ) : NULL;
+	Error_t write_error = ERROR_NONE;
+	int temporary_fd = -1;
+
+	if ( temporary_filepath == NULL || ( temporary_fd = mkstemp( temporary_filepath ) ) < 0 ) {
+		write_error = ERROR_IO;
+	} else {
+		FILE *snapshot_file = fdopen( temporary_fd, "wb" );
+
+		if ( snapshot_file == NULL ) {
+			close( temporary_fd );
+			write_error = ERROR_IO;
+		} else {
+			if ( fwrite( image, 1, fixed_size, snapshot_file ) != fixed_size || fwrite( strings.data, 1, strings.size, snapshot_file ) != strings.size ) write_error = ERROR_IO;
+			if ( fflush( snapshot_file ) != 0 || fsync( fileno( snapshot_file ) ) != 0 ) write_error = ERROR_IO;
+			if ( fclose( snapshot_file ) != 0 ) write_error = ERROR_IO;
+			if ( write_error == ERROR_NONE && rename( temporary_filepath, snapshot_filepath ) != 0 ) write_error = ERROR_IO;
+		}
+
+		if ( write_error != ERROR_NONE ) remove( temporary_filepath );
+	}
+
+	if ( write_error == ERROR_NONE ) {
+		LOG_INFO( "Configuration snapshot written to \"%s\"\n", snapshot_filepath );
+	} else {
+		LOG_ERROR( "Failed to write configuration snapshot to \"%s\": %s\n", snapshot_filepath ? snapshot_filepath : SNAPSHOT_FILENAME, strerror( errno ) );
+	}
+
+	free( temporary_filepath );
+	free( snapshot_filepath );
+	free( strings.data );
+	free( image );
+
+	return write_error;
 }
 
+/////////////////////////////////////////////
+///// Parser internal utility functions /////
+/////////////////////////////////////////////
+
 /**
  * @brief TODO
  *
  * TODO
  *
- * @param[in] setting TODO
- * @param[out] button TODO
+ * @param[in] parent_setting TODO
+ * @param[in] path TODO
+ * @param[in] expected_type TODO
+ * @param[out] parsed_value TODO
  *
  * @return @ref ERROR_NONE on success.
- * @return @ref ERROR_NULL_VALUE if a NULL argument is provided or if `strtoul()`
- * failed to properly convert parsed intermediate button string to a number.
- * @return @ref ERROR_RANGE If parsed button value exceeds 8 bit mask value limit (255,
- * 8 bit maximum value minus 1) or is 0, an empty/no button.
- *
- * @see https://gitlab.freedesktop.org/xorg/proto/xorgproto/-/blob/master/include/X11/X.h
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_NOT_FOUND if lookup failed.
+ * @return @ref ERROR_TYPE if type found at @p path does not match
+ * @p expected_type or if there is an unexpected type in the switch case.
  */
-static Error_t _parse_buttonbind_button( config_setting_t *setting, unsigned int *button ) {
+static Error_t _libconfig_generic_lookup( config_setting_t *parent_setting, const char *path, const int expected_type, void *parsed_value ) {
 
-	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( button, ERROR_NULL_VALUE, "%s:\"button\"\n", POINTER_NULL_PRINT_STRING );
+	if ( parent_setting == NULL || path == NULL ) return ERROR_NULL_VALUE;
 
-	const char *button_string = NULL;
-	const Error_t lookup_error = _libconfig_lookup_string( setting, "button", &button_string );
+	return _libconfig_get_value( config_setting_lookup( parent_setting, path ), expected_type, parsed_value );
+}
+
+/**
+ * @brief Get a float value from a libconfig setting.
+ *
+ * @param[in] setting Pointer to the libconfig setting holding the value, or NULL if it wasn't found.
+ * @param[in] range_min Minimum value that can be saved to @p parsed_value.
+ * @param[in] range_max Maximum value that can be saved to @p parsed_value.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if @p parsed_value is NULL.
+ * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or
+ * if the value of @p setting is outside the provided range.
+ * @return Any error returned from @ref _libconfig_get_value().
+ */
+static Error_t _libconfig_get_float( const config_setting_t *setting, const float range_min, const float range_max, float *parsed_value ) {
+
+	if ( parsed_value == NULL ) return ERROR_NULL_VALUE;
+	if ( range_min > range_max ) return ERROR_RANGE;
 
+	float tmp_float = 0;
+	const Error_t lookup_error = _libconfig_get_value( setting, CONFIG_TYPE_FLOAT, &tmp_float );
 	if ( lookup_error != ERROR_NONE ) return lookup_error;
 
-	for ( unsigned int i = 0; i < LENGTH( BUTTON_ALIAS_MAP ); i++ ) {
-		if ( strcasecmp( button_string, BUTTON_ALIAS_MAP[ i ].alias ) == 0 ) {
-			*button = BUTTON_ALIAS_MAP[ i ].button;
-			return ERROR_NONE;
-		}
-	}
+	if ( tmp_float < range_min || tmp_float > range_max ) return ERROR_RANGE;
 
-	errno = 0;
-	char *end_pointer = NULL;
-	const unsigned long parsed_value = strtoul( button_string, &end_pointer, 10 );
+	*parsed_value = tmp_float;
 
-	if ( errno != 0 || end_pointer == button_string || *end_pointer != '\0' ) return ERROR_NULL_VALUE;
+	return ERROR_NONE;
+}
 
-	// X11 button mask is only 8 bits, ensure it fits
-	if ( parsed_value == 0 || parsed_value >= Button1Mask ) return ERROR_RANGE;
+/**
+ * @brief Get an integer value from a libconfig setting.
+ *
+ * @param[in] setting Pointer to the libconfig setting holding the value, or NULL if it wasn't found.
+ * @param[in] range_min Minimum value that can be saved to @p parsed_value.
+ * @param[in] range_max Maximum value that can be saved to @p parsed_value.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if @p parsed_value is NULL.
+ * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or
+ * if the value of @p setting is outside the provided range.
+ * @return Any error returned from @ref _libconfig_get_value().
+ */
+static Error_t _libconfig_get_int( const config_setting_t *setting, const int range_min, const int range_max, int *parsed_value ) {
 
-	*button = (unsigned int) parsed_value;
+	if ( parsed_value == NULL ) return ERROR_NULL_VALUE;
+	if ( range_min > range_max ) return ERROR_RANGE;
+
+	int tmp_int = 0;
+	const Error_t lookup_error = _libconfig_get_value( setting, CONFIG_TYPE_INT, &tmp_int );
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
+
+	if ( tmp_int < range_min || tmp_int > range_max ) return ERROR_RANGE;
+
+	*parsed_value = tmp_int;
 
 	return ERROR_NONE;
 }
 
 /**
- * @brief TODO
+ * @brief Returns the name of a given setting, or its nearest named parent setting.
  *
  * TODO
  *
  * @param[in] setting TODO
- * @param[out] click TODO
+ * @param[out] found_name TODO
  *
  * @return @ref ERROR_NONE on success.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_NOT_FOUND if parsed intermediate click string does not
- * match any alias found in @ref CLICK_ALIAS_MAP.
- * @return Any error returned from @ref _libconfig_setting_lookup_string().
+ * @return @ref ERROR_NOT_FOUND if no named parent settings are found.
  */
-static Error_t _parse_buttonbind_click( config_setting_t *setting, unsigned int *click ) {
-
-	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( click, ERROR_NULL_VALUE, "%s:\"click\"\n", POINTER_NULL_PRINT_STRING );
+static Error_t _libconfig_get_setting_name( const config_setting_t *setting, const char **found_name ) {
 
-	const char *click_string = NULL;
-	const Error_t lookup_error = _libconfig_lookup_string( setting, "click", &click_string );
+	if ( setting == NULL || found_name == NULL ) return ERROR_NULL_VALUE;
 
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	while ( setting != NULL ) {
+		const char *tmp_string = config_setting_name( setting );
 
-	for ( unsigned int i = 0; i < LENGTH( CLICK_ALIAS_MAP ); i++ ) {
-		if ( strcasecmp( click_string, CLICK_ALIAS_MAP[ i ].alias ) == 0 ) {
-			*click = CLICK_ALIAS_MAP[ i ].click;
+		if ( tmp_string != NULL ) {
+			*found_name = tmp_string;
 			return ERROR_NONE;
 		}
+
+		setting = config_setting_parent( setting );
 	}
 
 	return ERROR_NOT_FOUND;
 }
 
 /**
- * @brief Parse a list of buttonbinds from a libconfig configuration into a list of Button structs.
- *
- * TODO
+ * @brief Get a string value from a libconfig setting.
  *
- * @param[in] config Pointer to the libconfig configuration containing the buttonbinds to be parsed into @p array.
- * @param[out] array Pointer to where to dynamically allocate and store all the parsed buttonbinds.
- * @param[out] count Pointer to where to store the number of buttonbinds to be parsed. This value does not take into
- * account any failures during parsing the buttonbinds.
- * @param[out] malloced Boolean to track if @p array has been dynamically allocated yet or not, analogous to if the
- * default buttonbinds are being used or not. Value is set to `false` after allocation.
+ * The string "NULL", in any case, is stored as a NULL pointer.
  *
- * @return TODO
+ * @param[in] setting Pointer to the libconfig setting holding the value, or NULL if it wasn't found.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
  *
- * @note TODO Maybe mention dynamic allocation in _parse_binds_config()?
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if @p parsed_value is NULL.
+ * @return Any error returned from @ref _libconfig_get_value().
  */
-static Errors_t _parse_buttonbinds_config( const config_t *config, Button **array, unsigned int *count, bool *malloced ) {
-
-	Errors_t returned_errors = { 0 };
-	const char *lookup_path = "buttonbinds";
+static Error_t _libconfig_get_string( const config_setting_t *setting, const char **parsed_value ) {
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	if ( parsed_value == NULL ) return ERROR_NULL_VALUE;
 
-	config_setting_t *array_setting = NULL;
-	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
-	add_error( &returned_errors, lookup_error );
+	const Error_t lookup_error = _libconfig_get_value( setting, CONFIG_TYPE_STRING, parsed_value );
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
 
-	if ( lookup_error != ERROR_NONE ) {
-		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
-		return returned_errors;
+	if ( *parsed_value && strcasecmp( *parsed_value, "NULL" ) == 0 ) {
+		*parsed_value = NULL;
 	}
 
-	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Button ), _parse_buttonbind_adapter, malloced, (void **) array, count );
-	copy_errors( &returned_errors, array_errors );
-
-	return returned_errors;
+	return ERROR_NONE;
 }
 
 /**
- * @brief TODO
- *
- * TODO
+ * @brief Get an unsigned integer value from a libconfig setting.
  *
- * @param[in] setting TODO
- * @param[in] index TODO
- * @param[out] font TODO
+ * @param[in] setting Pointer to the libconfig setting holding the value, or NULL if it wasn't found.
+ * @param[in] range_min Minimum value that can be saved to @p parsed_value.
+ * @param[in] range_max Maximum value that can be saved to @p parsed_value.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
  *
- * @return TODO
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if @p parsed_value is NULL.
+ * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or if the
+ * value of @p setting is less than zero or outside the provided range.
+ * @return Any error returned from @ref _libconfig_get_value().
  */
-static Errors_t _parse_font( config_setting_t *setting, const unsigned int index, const char **font ) {
-
-	Errors_t returned_errors = { 0 };
+static Error_t _libconfig_get_uint( const config_setting_t *setting, const unsigned int range_min, const unsigned int range_max, unsigned int *parsed_value ) {
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	if ( parsed_value == NULL ) return ERROR_NULL_VALUE;
+	if ( range_min > range_max ) return ERROR_RANGE;
 
-	if ( config_setting_type( setting ) != CONFIG_TYPE_STRING ) {
-		LOG_WARN( "Font element at index %u is not a string\n", index );
-		add_error( &returned_errors, ERROR_TYPE );
-		return returned_errors;
-	}
+	int tmp_int = 0;
+	const Error_t lookup_error = _libconfig_get_value( setting, CONFIG_TYPE_INT, &tmp_int );
+	if ( lookup_error != ERROR_NONE ) return lookup_error;
 
-	*font = config_setting_get_string( setting );
+	if ( tmp_int < 0 ) return ERROR_RANGE;
 
-	if ( *font == NULL ) {
-		LOG_WARN( "Failed to parse theme font at index %u for unknown an reason\n", index );
-		add_error( &returned_errors, ERROR_NULL_VALUE );
-		return returned_errors;
-	}
+	const unsigned int tmp_uint = (unsigned int) tmp_int;
 
-	return returned_errors;
-}
+	if ( tmp_uint < range_min || tmp_uint > range_max ) return ERROR_RANGE;
 
-/**
- * @brief Thin adapter function to allow for font parsing inside a generic array parsing function.
- *
- * See @ref _parse_font() for function documentation.
- */
-static Errors_t _parse_font_adapter( config_setting_t *setting, const unsigned int index, void *font ) {
-	return _parse_font( setting, index, (const char **) font );
+	*parsed_value = tmp_uint;
+
+	return ERROR_NONE;
 }
 
 /**
- * @brief Parse generic configuration settings from a libconfig configuration.
+ * @brief Get the value of a libconfig setting of a given type.
  *
- * TODO
+ * Every other `_libconfig_*()` function ends up here, either with a setting looked up by
+ * path, or with one already found by walking its parent's members, see @ref _parse_element().
  *
- * @param[in] config Pointer to the libconfig configuration containing the generic settings to be parsed.
+ * @param[in] setting Pointer to the libconfig setting holding the value, or NULL if it wasn't found.
+ * @param[in] expected_type libconfig type @p setting must have.
+ * @param[out] parsed_value Pointer to where the value will be stored on success. Groups, arrays and
+ * lists are stored as a pointer to their setting.
  *
- * @return TODO
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if @p parsed_value is NULL.
+ * @return @ref ERROR_NOT_FOUND if @p setting is NULL.
+ * @return @ref ERROR_TYPE if @p setting is not of @p expected_type or if there is an unexpected type in the switch case.
  */
-static Errors_t _parse_generic_settings( const config_t *config ) {
+static Error_t _libconfig_get_value( const config_setting_t *setting, const int expected_type, void *parsed_value ) {
 
-	Errors_t returned_errors = { 0 };
+	if ( parsed_value == NULL ) return ERROR_NULL_VALUE;
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	if ( setting == NULL ) return ERROR_NOT_FOUND;
 
-	for ( unsigned int i = 0; i < LENGTH( SETTING_ALIAS_MAP ); ++i ) {
-		Error_t returned_error = ERROR_NONE;
+	if ( config_setting_type( setting ) != expected_type ) return ERROR_TYPE;
 
-		switch ( SETTING_ALIAS_MAP[ i ].type ) {
-			case TYPE_BOOLEAN:
-				returned_error = _libconfig_generic_lookup( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, CONFIG_TYPE_BOOL, SETTING_ALIAS_MAP[ i ].setting );
-				break;
+	switch ( expected_type ) {
+		case CONFIG_TYPE_STRING:
+			*(const char **) parsed_value = config_setting_get_string( setting );
+			break;
 
-			case TYPE_INT:
-				returned_error = _libconfig_lookup_int( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, (int) SETTING_ALIAS_MAP[ i ].range_min,
-				                                        (int) SETTING_ALIAS_MAP[ i ].range_max, SETTING_ALIAS_MAP[ i ].setting );
-				break;
+		case CONFIG_TYPE_INT:
+			*(int *) parsed_value = config_setting_get_int( setting );
+			break;
 
-			case TYPE_UINT:
-				returned_error = _libconfig_lookup_uint( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, (unsigned int) SETTING_ALIAS_MAP[ i ].range_min,
-				                                         (unsigned int) SETTING_ALIAS_MAP[ i ].range_max, SETTING_ALIAS_MAP[ i ].setting );
-				break;
+		case CONFIG_TYPE_INT64:
+			*(long long *) parsed_value = config_setting_get_int64( setting );
+			break;
 
-			case TYPE_FLOAT:
-				returned_error = _libconfig_lookup_float( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, (float) SETTING_ALIAS_MAP[ i ].range_min,
-				                                          (float) SETTING_ALIAS_MAP[ i ].range_max, SETTING_ALIAS_MAP[ i ].setting );
-				break;
+		case CONFIG_TYPE_FLOAT:
+			*(float *) parsed_value = config_setting_get_float( setting );
+			break;
 
-			case TYPE_STRING:
-				returned_error = _libconfig_lookup_string( config_root_setting( config ), SETTING_ALIAS_MAP[ i ].alias, SETTING_ALIAS_MAP[ i ].setting );
-				break;
+		case CONFIG_TYPE_BOOL:
+			*(bool *) parsed_value = config_setting_get_bool( setting );
+			break;
 
-			default:
-				returned_error = ERROR_TYPE;
-				LOG_WARN( "Setting \"%s\" is programmed with an invalid type\n", SETTING_ALIAS_MAP[ i ].alias );
-				break;
-		}
+		case CONFIG_TYPE_GROUP:
+		case CONFIG_TYPE_ARRAY:
+		case CONFIG_TYPE_LIST:
+			*(const config_setting_t **) parsed_value = setting;
+			break;
 
-		if ( returned_error != ERROR_NONE ) {
-			if ( returned_error == ERROR_NOT_FOUND && SETTING_ALIAS_MAP[ i ].optional ) {
-				LOG_DEBUG( "\"%s\" was not found but is flagged as optional, continuing", SETTING_ALIAS_MAP[ i ].alias );
-			} else {
-				add_error( &returned_errors, returned_error );
-				LOG_WARN( "Issue while parsing \"%s\": %s\n", SETTING_ALIAS_MAP[ i ].alias, ERROR_ENUM_STRINGS[ returned_error ] );
-			}
-		}
+		default:
+			return ERROR_TYPE;
 	}
 
-	return returned_errors;
+	return ERROR_NONE;
 }
 
 /**
- * @brief TODO
+ * @brief Look up a float value in a libconfig setting.
  *
  * TODO
  *
- * @param[in] setting TODO
- * @param[in] index TODO
- * @param[out] keybind TODO
+ * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
+ * @param[in] path Path expression to search within @p parent_setting.
+ * @param[in] range_min Minimum value that can be saved to @p parsed_value.
+ * @param[in] range_max Maximum value that can be saved to @p parsed_value.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
  *
- * @return TODO
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or
+ * if the parsed value at @p path is outside the provided range.
+ * @return Any error returned from @ref _libconfig_get_float().
  */
-static Errors_t _parse_keybind( config_setting_t *setting, const unsigned int index, Key *keybind ) {
-
-	Errors_t returned_errors = { 0 };
-
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( keybind, returned_errors, "%s:\"keybind\"\n", POINTER_NULL_PRINT_STRING );
+static Error_t _libconfig_lookup_float( config_setting_t *parent_setting, const char *path, const float range_min, const float range_max, float *parsed_value ) {
 
-	const Errors_t bind_core_errors = _parse_bind_core( setting, index, &keybind->mod, &keybind->func, &keybind->arg );
-	copy_errors( &returned_errors, bind_core_errors );
+	if ( parent_setting == NULL || path == NULL ) return ERROR_NULL_VALUE;
 
-	const Error_t keysym_error = _parse_keybind_keysym( setting, &keybind->keysym );
-	add_error( &returned_errors, keysym_error );
+	return _libconfig_get_float( config_setting_lookup( parent_setting, path ), range_min, range_max, parsed_value );
+}
 
-	if ( keysym_error != ERROR_NONE ) {
-		LOG_WARN( "Keybind %d invalid, unable to parse the bind's key: %s\n", index + 1, ERROR_ENUM_STRINGS[ keysym_error ] );
-	}
+/**
+ * @brief Look up an integer value in a libconfig setting.
+ *
+ * TODO
+ *
+ * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
+ * @param[in] path Path expression to search within @p parent_setting.
+ * @param[in] range_min Minimum value that can be saved to @p parsed_value.
+ * @param[in] range_max Maximum value that can be saved to @p parsed_value.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or
+ * if the parsed value at @p path is outside the provided range.
+ * @return Any error returned from @ref _libconfig_get_int().
+ */
+static Error_t _libconfig_lookup_int( config_setting_t *parent_setting, const char *path, const int range_min, const int range_max, int *parsed_value ) {
 
-	// Ensure key is zeroed and doesn't accidentally have any
-	// data left over from parsing that could cause unusual behavior
-	if ( errors_failure_count( &returned_errors ) != 0 ) {
-		keybind->mod = 0;
-		keybind->keysym = NoSymbol;
-		keybind->func = NULL;
-		keybind->arg.i = 0;
-	}
+	if ( parent_setting == NULL || path == NULL ) return ERROR_NULL_VALUE;
 
-	return returned_errors;
+	return _libconfig_get_int( config_setting_lookup( parent_setting, path ), range_min, range_max, parsed_value );
 }
 
 /**
- * @brief Thin adapter function to allow for keybind parsing inside a generic array parsing function.
+ * @brief Look up a string value in a libconfig setting.
  *
- * See @ref _parse_keybind() for function documentation.
+ * TODO
+ *
+ * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
+ * @param[in] path Path expression to search within @p parent_setting.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return Any error returned from @ref _libconfig_get_string().
  */
-static Errors_t _parse_keybind_adapter( config_setting_t *setting, const unsigned int index, void *keybind ) {
-	return _parse_keybind( setting, index, (Key *) keybind );
+static Error_t _libconfig_lookup_string( config_setting_t *parent_setting, const char *path, const char **parsed_value ) {
+
+	if ( parent_setting == NULL || path == NULL ) return ERROR_NULL_VALUE;
+
+	return _libconfig_get_string( config_setting_lookup( parent_setting, path ), parsed_value );
 }
 
 /**
- * @brief TODO
+ * @brief Look up an unsigned integer value in a libconfig setting.
  *
  * TODO
  *
- * @param[in] setting TODO
- * @param[out] keysym Pointer to where to store the parsed keysym value.
+ * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
+ * @param[in] path Path expression to search within @p parent_setting.
+ * @param[in] range_min Minimum value that can be saved to @p parsed_value.
+ * @param[in] range_max Maximum value that can be saved to @p parsed_value.
+ * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
  *
  * @return @ref ERROR_NONE on success.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_NOT_FOUND if unable to convert parsed string to keysym.
- * @return Any error returned from @ref _libconfig_setting_lookup_string().
+ * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or if the
+ * parsed value at @p path is less than zero or outside the provided range.
+ * @return Any error returned from @ref _libconfig_get_uint().
+ */
+static Error_t _libconfig_lookup_uint( config_setting_t *parent_setting, const char *path, const unsigned int range_min, const unsigned int range_max, unsigned int *parsed_value ) {
+
+	if ( parent_setting == NULL || path == NULL ) return ERROR_NULL_VALUE;
+
+	return _libconfig_get_uint( config_setting_lookup( parent_setting, path ), range_min, range_max, parsed_value );
+}
+
+/**
+ * @brief Allocate zeroed memory out of an arena.
  *
- * @note `xev` is likely your best bet at finding the keysym values that will work with `XStringToKeysym()`.
- * If someone knows a better way, please reach out and let me know.
+ * Memory is bump allocated out of @p arena's current block, and a new block, at least twice
+ * the size of the previous one, is chained in whenever it runs out. The memory is only ever
+ * released all at once, by @ref _parser_free_arena().
  *
- * @see https://gitlab.freedesktop.org/xorg/app/xev
- * @see https://gitlab.freedesktop.org/xorg/lib/libx11/-/blob/master/src/StrKeysym.c?ref_type=heads#L74
+ * @param[in,out] arena Pointer to the arena to allocate from.
+ * @param[in] count Number of elements to allocate.
+ * @param[in] size Size in bytes of every element.
+ *
+ * @return Pointer to the zeroed memory, aligned to @ref ARENA_ALIGNMENT, or NULL if @p arena
+ * is NULL or memory failed to be allocated. A zero sized allocation still returns a valid pointer.
  */
-static Error_t _parse_keybind_keysym( config_setting_t *setting, KeySym *keysym ) {
+static void *_parser_arena_alloc( Arena_t *arena, const size_t count, const size_t size ) {
 
-	RETURN_VALUE_IF_NULL( setting, ERROR_NULL_VALUE, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_VALUE_IF_NULL( keysym, ERROR_NULL_VALUE, "%s:\"keysym\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( arena, NULL, "%s:\"arena\"\n", POINTER_NULL_PRINT_STRING );
 
-	const char *keybind_string = NULL;
-	const Error_t lookup_error = _libconfig_lookup_string( setting, "key", &keybind_string );
+	if ( size != 0 && count > ( SIZE_MAX / 2 - ARENA_ALIGNMENT ) / size ) {
+		LOG_ERROR( "%s, %zu elements of %zu bytes is too large\n", FAILED_ALLOC_PRINT_STRING, count, size );
+		return NULL;
+	}
 
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	const size_t length = count * size != 0 ? count * size : 1;
+	Arena_Block_t *block = arena->blocks;
+	size_t offset = 0;
 
-	*keysym = XStringToKeysym( keybind_string );
+	if ( block != NULL ) offset = block->used + ( ( ARENA_ALIGNMENT - (uintptr_t) ( block->data + block->used ) % ARENA_ALIGNMENT ) % ARENA_ALIGNMENT );
 
-	if ( *keysym == NoSymbol ) {
-		LOG_WARN( "Failed to convert string (\"%s\") to keysym\n", keybind_string );
-		return ERROR_NOT_FOUND;
+	if ( block == NULL || offset > block->size || length > block->size - offset ) {
+		size_t block_size = block != NULL ? block->size * 2 : ARENA_BLOCK_SIZE;
+		if ( block_size < length + ARENA_ALIGNMENT ) block_size = length + ARENA_ALIGNMENT;
+
+		errno = 0;
+		Arena_Block_t *new_block = malloc( sizeof( Arena_Block_t ) + block_size );
+
+		RETURN_VALUE_IF_NULL( new_block, NULL, "%s (%zu bytes) using malloc(): %s\n", FAILED_ALLOC_PRINT_STRING, sizeof( Arena_Block_t ) + block_size, strerror( errno ) );
+
+		new_block->next = block;
+		new_block->size = block_size;
+		new_block->used = 0;
+		arena->blocks = block = new_block;
+
+		offset = ( ARENA_ALIGNMENT - (uintptr_t) block->data % ARENA_ALIGNMENT ) % ARENA_ALIGNMENT;
 	}
 
-	// The upper case return of XConvertCase(), which we don't use.
-	KeySym unused = 0;
-	XConvertCase( *keysym, keysym, &unused );
+	void *memory = block->data + offset;
+	block->used = offset + length;
+	memset( memory, 0, length );
 
-	return ERROR_NONE;
+	return memory;
 }
 
 /**
- * @brief Parse a list of keybinds from a libconfig configuration into a list of
- * Key structs.
+ * @brief Free an arena's string interning table once parsing is done.
  *
- * TODO
+ * The interned strings themselves stay in the arena. Strings interned afterward are still
+ * copied into the arena, they are just no longer de-duplicated against the earlier ones.
  *
- * @param[in] config Pointer to the libconfig configuration containing the keybinds to be parsed into @p array.
- * @param[out] array Pointer to where to dynamically allocate memory and store all the parsed keybinds.
- * @param[out] count Pointer to where to store the number of keybinds to be parsed. This value does not take
- * into account any failures during parsing the keybinds.
- * @param[out] malloced Boolean to track if @p array has been dynamically allocated yet or not, analogous to if
- * the default keybinds are being used or not. Value is set to `false` after allocation.
+ * @param[in,out] arena Pointer to the arena to finish, or NULL.
+ */
+static void _parser_arena_finish( Arena_t *arena ) {
+
+	if ( arena == NULL ) return;
+
+	free( arena->strings );
+	arena->strings = NULL;
+	arena->strings_count = 0;
+	arena->strings_capacity = 0;
+}
+
+/**
+ * @brief Build a hash index over a bind array.
  *
- * @return TODO
+ * Frees whatever @p index previously held, then chains every element of @p binds into a
+ * power of two number of buckets, at least twice the number of binds, by @p bind_hash.
+ * On allocation failure @p index is left without buckets, which lookups treat as a
+ * single bucket holding every bind.
  *
- * @note TODO Maybe mention dynamic allocation in _parse_binds_config()?
+ * @param[in,out] index Pointer to the index to rebuild.
+ * @param[in] binds Pointer to the bind array to index.
+ * @param[in] binds_count Number of elements in @p binds.
+ * @param[in] bind_hash Function returning the hash of the element of @p binds at a given index.
  */
-static Errors_t _parse_keybinds_config( const config_t *config, Key **array, unsigned int *count, bool *malloced ) {
+static void _parser_build_bind_index( Bind_Index_t *index, const void *binds, const unsigned int binds_count, uint64_t ( *bind_hash )( unsigned int bind_index ) ) {
 
-	Errors_t returned_errors = { 0 };
-	const char *lookup_path = "keybinds";
+	RETURN_IF_NULL( index, "%s:\"index\"\n", POINTER_NULL_PRINT_STRING );
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	_parser_free_bind_index( index );
 
-	config_setting_t *array_setting = NULL;
-	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
-	add_error( &returned_errors, lookup_error );
+	index->binds = binds;
+	index->binds_count = binds_count;
+	index->numlockmask = numlockmask;
 
-	if ( lookup_error != ERROR_NONE ) {
-		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
-		return returned_errors;
+	unsigned int bucket_count = 1;
+	while ( bucket_count < binds_count * 2 && bucket_count < UINT_MAX / 4 ) bucket_count *= 2;
+
+	errno = 0;
+	index->buckets = calloc( bucket_count, sizeof( unsigned int ) );
+	index->next = calloc( binds_count + 1, sizeof( unsigned int ) );
+
+	if ( index->buckets == NULL || index->next == NULL ) {
+		LOG_WARN( "%s (%zu bytes) using calloc(), binds will be looked up linearly: %s\n", FAILED_ALLOC_PRINT_STRING, ( bucket_count + binds_count + 1 ) * sizeof( unsigned int ),
+		          strerror( errno ) );
+		_parser_free_bind_index( index );
+		index->binds = binds;
+		index->binds_count = binds_count;
+		index->numlockmask = numlockmask;
+		return;
 	}
 
-	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Key ), _parse_keybind_adapter, malloced, (void **) array, count );
-	copy_errors( &returned_errors, array_errors );
+	index->bucket_mask = bucket_count - 1;
 
-	return returned_errors;
+	for ( unsigned int i = 0; i < bucket_count; i++ ) index->buckets[ i ] = binds_count;
+
+	// Pushing binds onto the front of their bucket in reverse leaves
+	// every bucket in array order, preserving configuration order.
+	for ( unsigned int i = binds_count; i > 0; i-- ) {
+		unsigned int *bucket = &index->buckets[ bind_hash( i - 1 ) & index->bucket_mask ];
+		index->next[ i - 1 ] = *bucket;
+		*bucket = i - 1;
+	}
 }
 
 /**
- * @brief Attempts to find, open, and store a valid libconfig configuration file.
- *
- * This function handles most of the high level logic regarding finding, opening,
- * validating, and storing a libconfig configuration file. This function will first
- * search for a custom configuration file, passed in using @p config_filepath. If that
- * is not found, a list of default directories are searched. If still no user configuration
- * is found, a user's last configuration backup will be attempted to be loaded. If again
- * unsuccessful, a system default configuration file will be loaded. Finally, if all else
- * fails, the function will return and the program will rely on the hardcoded default values
- * loaded from config.h
+ * @brief Build an Aho-Corasick automaton over one field of every rule in @ref rules.
  *
- * @param[in] config TODO
- * @param[in] custom_config_filepath TODO
- * @param[out] found_config_filepath TODO
- * @param[out] fallback_config_loaded TODO
+ * Inserts the non empty @p field of every rule into a trie, then links every node to
+ * its longest proper suffix in the trie, breadth first, so a scan never has to back up.
  *
- * @return TODO
+ * @param[out] automaton Pointer to where to store the automaton.
+ * @param[in] field Field of every rule to build the automaton over.
  *
- * @todo These error returns may not be the most accurate, not sure exactly the best fits.
- * @todo Should the parser even look for another config file if one is passed from the CLI? Could be deceptive behavior.
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_ALLOCATION if memory for the automaton failed to be allocated.
  */
-static Errors_t _parser_open_config_file( config_t *config, const char *custom_config_filepath, char **found_config_filepath, bool *fallback_config_loaded ) {
+static Error_t _parser_build_rule_automaton( Rule_Automaton_t *automaton, const Rule_Field_t field ) {
 
-	Errors_t returned_errors = { 0 };
+	RETURN_VALUE_IF_NULL( automaton, ERROR_NULL_VALUE, "%s:\"automaton\"\n", POINTER_NULL_PRINT_STRING );
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( found_config_filepath, returned_errors, "%s:\"found_config_filepath\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( fallback_config_loaded, returned_errors, "%s:\"fallback_config_loaded\"\n", POINTER_NULL_PRINT_STRING );
+	size_t nodes_capacity = 1;
+	for ( unsigned int i = 0; i < rules_count; i++ ) {
+		const char *pattern = _parser_rule_field( &rules[ i ], field );
+		if ( pattern != NULL ) nodes_capacity += strlen( pattern );
+	}
 
-	char *xdg_config_home = get_xdg_config_home();
-	char *xdg_data_home = get_xdg_data_home();
+	errno = 0;
+	automaton->nodes = calloc( nodes_capacity, sizeof( Rule_Automaton_Node_t ) );
+	automaton->next_rule = calloc( rules_count + 1, sizeof( unsigned int ) );
 
-	const struct Filepath {
-		const char *filepath_1;
-		const char *filepath_2;
-		const bool is_fallback_config;
-	} config_filepaths[ ] = {
-		{ custom_config_filepath, "", false },
-		{ xdg_config_home, "/dwm.conf", false },
-		{ xdg_config_home, "/dwm/dwm.conf", false },
-		{ xdg_data_home, "/dwm/dwm_last.conf", true },
-		{ "/etc/dwm.conf", "", true }
-	};
+	if ( automaton->nodes == NULL || automaton->next_rule == NULL ) return ERROR_ALLOCATION;
+
+	automaton->nodes[ 0 ].first_rule = rules_count;
+	automaton->nodes_count = 1;
 
-	for ( unsigned int i = 0; i < LENGTH( config_filepaths ); i++ ) {
-		char constructed_path[ PATH_MAX ];
+	// Insert in reverse, so rules sharing a pattern are chained in ascending order
+	for ( unsigned int i = rules_count; i > 0; i-- ) {
+		const char *pattern = _parser_rule_field( &rules[ i - 1 ], field );
 
-		if ( config_filepaths[ i ].filepath_1 != NULL && config_filepaths[ i ].filepath_2 != NULL ) {
-			snprintf( constructed_path, sizeof( constructed_path ), "%s%s", config_filepaths[ i ].filepath_1, config_filepaths[ i ].filepath_2 );
-		} else {
-			LOG_DEBUG( "Part of a path at index %d was NULL while trying top open a configuration file, skipping invalid path\n", i );
-			continue;
-		}
+		if ( pattern == NULL || pattern[ 0 ] == '\0' ) continue;
 
-		LOG_DEBUG( "Attempting to open config file \"%s\"\n", constructed_path );
+		unsigned int node = 0;
+		for ( const unsigned char *byte = (const unsigned char *) pattern; *byte != '\0'; byte++ ) {
+			unsigned int child = automaton->nodes[ node ].first_child;
+			while ( child != 0 && automaton->nodes[ child ].byte != *byte ) child = automaton->nodes[ child ].next_sibling;
 
-		FILE *configuration_file = fopen( constructed_path, "r" );
+			if ( child == 0 ) {
+				child = automaton->nodes_count++;
+				automaton->nodes[ child ].byte = *byte;
+				automaton->nodes[ child ].first_rule = rules_count;
+				automaton->nodes[ child ].next_sibling = automaton->nodes[ node ].first_child;
+				automaton->nodes[ node ].first_child = child;
+			}
 
-		if ( configuration_file == NULL ) {
-			LOG_DEBUG( "Unable to open config file \"%s\"\n", constructed_path );
-			continue;
+			node = child;
 		}
 
-		if ( config_read( config, configuration_file ) == CONFIG_FALSE ) {
-			LOG_WARN( "Problem parsing config file \"%s\", line %d: %s\n", constructed_path, config_error_line( config ), config_error_text( config ) );
-			add_error( &returned_errors, ERROR_NULL_VALUE );
-			fclose( configuration_file );
-			continue;
-		}
+		automaton->next_rule[ i - 1 ] = automaton->nodes[ node ].first_rule;
+		automaton->nodes[ node ].first_rule = i - 1;
+	}
 
-		*found_config_filepath = estrdup( constructed_path );
-		if ( *found_config_filepath == NULL ) add_error( &returned_errors, ERROR_ALLOCATION );
+	// Nodes are numbered in insertion order rather than by depth,
+	// so suffix links are linked breadth first through a queue.
+	errno = 0;
+	unsigned int *queue = calloc( automaton->nodes_count, sizeof( unsigned int ) );
 
-		*fallback_config_loaded = config_filepaths[ i ].is_fallback_config;
+	RETURN_VALUE_IF_NULL( queue, ERROR_ALLOCATION, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, automaton->nodes_count * sizeof( unsigned int ), strerror( errno ) );
 
-		fclose( configuration_file );
+	unsigned int head = 0, tail = 0;
 
-		break;
+	for ( unsigned int child = automaton->nodes[ 0 ].first_child; child != 0; child = automaton->nodes[ child ].next_sibling ) {
+		automaton->nodes[ child ].fail = 0;
+		queue[ tail++ ] = child;
 	}
 
-	free( xdg_config_home );
-	free( xdg_data_home );
+	while ( head < tail ) {
+		const unsigned int node = queue[ head++ ];
 
-	return returned_errors;
+		for ( unsigned int child = automaton->nodes[ node ].first_child; child != 0; child = automaton->nodes[ child ].next_sibling ) {
+			unsigned int fail = automaton->nodes[ node ].fail;
+			unsigned int target = 0;
+
+			for ( ;; ) {
+				target = _parser_rule_automaton_child( automaton, fail, automaton->nodes[ child ].byte );
+				if ( target != 0 || fail == 0 ) break;
+				fail = automaton->nodes[ fail ].fail;
+			}
+
+			automaton->nodes[ child ].fail = target;
+			automaton->nodes[ child ].dictionary = automaton->nodes[ target ].first_rule < rules_count ? target : automaton->nodes[ target ].dictionary;
+			queue[ tail++ ] = child;
+		}
+	}
+
+	free( queue );
+
+	return ERROR_NONE;
 }
 
 /**
- * @brief Parse a rule from a libconfig configuration setting.
- *
- * TODO
+ * @brief Hash a buttonbind chord.
  *
- * @param[in] setting Pointer to the libconfig setting containing the rule to be parsed into @p rule.
- * @param[in] index Index of the current rule in the larger array. Used purely for debug printing.
- * @param[out] rule Pointer to the Rule struct where the values parsed from @p setting are stored.
+ * @param[in] click Click enum of the buttonbind.
+ * @param[in] button X11 button of the buttonbind.
+ * @param[in] modifier Cleaned X11 modifier mask of the buttonbind.
  *
- * @return TODO
+ * @return The hash of the chord.
  */
-static Errors_t _parse_rule( config_setting_t *setting, const unsigned int index, Rule *rule ) {
+static uint64_t _parser_buttonbind_hash( const unsigned int click, const unsigned int button, const unsigned int modifier ) {
 
-	Errors_t returned_errors = { 0 };
+	const uint64_t chord[ ] = { click, button, modifier };
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"config\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
-	RETURN_ERRORS_IF_NULL( rule, returned_errors, "%s:\"rule\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	return _parser_fnv1a_hash( chord, sizeof( chord ), FNV1A_OFFSET_BASIS );
+}
 
-	add_error( &returned_errors, _libconfig_lookup_string( setting, "class", &rule->class ) );
-	add_error( &returned_errors, _libconfig_lookup_string( setting, "instance", &rule->instance ) );
-	add_error( &returned_errors, _libconfig_lookup_string( setting, "title", &rule->title ) );
-	add_error( &returned_errors, _libconfig_lookup_uint( setting, "tag-mask", 0, TAGMASK, &rule->tags ) );
-	add_error( &returned_errors, _libconfig_lookup_int( setting, "monitor", -1, 99, &rule->monitor ) );
+/**
+ * @brief Hash the chord of an element of @ref buttons, for @ref _parser_build_bind_index().
+ *
+ * @param[in] bind_index Index of the element of @ref buttons to hash.
+ *
+ * @return The hash of the buttonbind's chord.
+ */
+static uint64_t _parser_buttonbind_index_hash( const unsigned int bind_index ) {
 
-	// This logically should be a boolean value, but I didn't want to
-	// deviate from the coded type, so I kept it an int and range check it.
-	add_error( &returned_errors, _libconfig_lookup_int( setting, "floating", 0, 1, &rule->isfloating ) );
+	return _parser_buttonbind_hash( buttons[ bind_index ].click, buttons[ bind_index ].button, CLEANMASK( buttons[ bind_index ].mask ) );
+}
 
-	// Ensure rule is zeroed and doesn't accidentally have any
-	// data left over from parsing that could cause unusual behavior
-	if ( errors_failure_count( &returned_errors ) != 0 ) {
-		rule->class = NULL;
-		rule->instance = NULL;
-		rule->title = NULL;
-		rule->tags = 0;
-		rule->isfloating = 0;
-		rule->monitor = 0;
-	}
+/**
+ * @brief qsort() and bsearch() comparison function for unsigned integers.
+ *
+ * @param[in] a Pointer to the first unsigned integer.
+ * @param[in] b Pointer to the second unsigned integer.
+ *
+ * @return Less than, equal to, or greater than zero if @p a is less than, equal to, or greater than @p b.
+ */
+static int _parser_compare_uint( const void *a, const void *b ) {
 
-	LOG_DEBUG( "Rule %d: class: \"%s\", instance: \"%s\", title: \"%s\", tag-mask: %d, monitor: %d, floating: %d\n", rule_index, parsed_rule->class, parsed_rule->instance, parsed_rule->title,
-	           parsed_rule->tags, parsed_rule->monitor, parsed_rule->isfloating );
+	const unsigned int first = *(const unsigned int *) a, second = *(const unsigned int *) b;
 
-	return returned_errors;
+	return ( first > second ) - ( first < second );
 }
 
 /**
- * @brief Thin adapter function to allow for rule parsing inside a generic array parsing function.
+ * @brief Returns the size in bytes of the variable backing a given @ref Data_Type_t.
  *
- * See @ref _parse_rule() for function documentation.
+ * @param[in] type Data type to get the size of.
+ *
+ * @return Size in bytes of a variable of type @p type, or 0 for @ref TYPE_NONE and unknown types.
  */
-static Errors_t _parse_rule_adapter( config_setting_t *setting, const unsigned int index, void *rule ) {
-	return _parse_rule( setting, index, (Rule *) rule );
+static size_t _parser_data_type_size( const Data_Type_t type ) {
+
+	switch ( type ) {
+		case TYPE_BOOLEAN: return sizeof( bool );
+		case TYPE_INT: return sizeof( int );
+		case TYPE_UINT: return sizeof( unsigned int );
+		case TYPE_FLOAT: return sizeof( float );
+		case TYPE_STRING: return sizeof( const char * );
+		case TYPE_COMMAND: return sizeof( const Spawn_Command_t * );
+		default: return 0;
+	}
 }
 
 /**
- * @brief Parse a list of rules from a libconfig configuration into a list of Rule structs.
+ * @brief Destroy and free @ref libconfig_config, if there is one.
  *
- * TODO
+ * Nothing parsed out of it is needed afterward, as everything kept has been copied
+ * into @ref config_arena, see @ref _parser_intern_string().
+ */
+static void _parser_destroy_config( void ) {
+
+	if ( libconfig_config == NULL ) return;
+
+	config_destroy( libconfig_config );
+	free( libconfig_config );
+	libconfig_config = NULL;
+}
+
+/**
+ * @brief Find an alias in an alias map through its sorted index.
  *
- * @param[in] config Pointer to the libconfig configuration containing the rules to be parsed into @p array.
- * @param[out] array Pointer to where to dynamically allocate memory and store all the parsed rules.
- * @param[out] count Pointer to where to store the number of rules to be parsed. This value does not take into account
- * any failures during parsing the rules.
- * @param[out] malloced Boolean to track if @p array has been dynamically allocated yet or not, analogous
- * to if the default rules are being used or not. Value is set to `false` after allocation.
+ * Binary searches @p index for @p alias, case insensitively. The index is sorted the
+ * first time it is searched, with a stable sort, so if a map holds the same alias more
+ * than once the first one is found, just like a linear scan over the map would.
  *
- * @return TODO
+ * @param[in,out] index Pointer to the index of the alias map to search.
+ * @param[in] alias Alias to search for.
  *
- * @todo Check for NULL pointers from function arguments. Possible able to use lookup_path in logs instead of repeating message
+ * @return The index of the matching element of the alias map, or -1 if there is none.
  */
-static Errors_t _parse_rules_config( const config_t *config, Rule **array, unsigned int *count, bool *malloced ) {
-
-	Errors_t returned_errors = { 0 };
-	const char *lookup_path = "rules";
+static int _parser_find_alias( Alias_Index_t *index, const char *alias ) {
+
+	RETURN_VALUE_IF_NULL( index, -1, "%s:\"index\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( alias, -1, "%s:\"alias\"\n", POINTER_NULL_PRINT_STRING );
+
+	// Maps are tiny and only sorted once, so an insertion sort is plenty
+	if ( index->sorted == false ) {
+		for ( unsigned int i = 0; i < index->length; i++ ) {
+			unsigned int j = i;
+			while ( j > 0 && strcasecmp( ALIAS_AT( index, index->order[ j - 1 ] ), ALIAS_AT( index, i ) ) > 0 ) {
+				index->order[ j ] = index->order[ j - 1 ];
+				j--;
+			}
+			index->order[ j ] = i;
+		}
+		index->sorted = true;
+	}
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	unsigned int low = 0, high = index->length;
 
-	config_setting_t *array_setting = NULL;
-	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
-	add_error( &returned_errors, lookup_error );
+	while ( low < high ) {
+		const unsigned int middle = low + ( high - low ) / 2;
 
-	if ( lookup_error != ERROR_NONE ) {
-		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
-		return returned_errors;
+		if ( strcasecmp( ALIAS_AT( index, index->order[ middle ] ), alias ) < 0 ) low = middle + 1;
+		else high = middle;
 	}
 
-	const Errors_t array_errors = _parse_setting_array( array_setting, sizeof( Rule ), _parse_rule_adapter, malloced, (void **) array, count );
-	copy_errors( &returned_errors, array_errors );
+	if ( low < index->length && strcasecmp( ALIAS_AT( index, index->order[ low ] ), alias ) == 0 ) return (int) index->order[ low ];
 
-	return returned_errors;
+	return -1;
 }
 
 /**
- * @brief TODO
- *
- * TODO
- *
- * @param[in] setting TODO
- * @param[in] element_size TODO
- * @param[in] array_element_parser_function TODO
- * @param[in,out] malloced TODO
- * @param[in,out] parsed_config TODO
- * @param[out] parsed_config_length TODO
+ * @brief Find a member in a member schema or alias map through its hashed index.
  *
- * @return TODO
+ * The hash table is filled the first time it is searched. If the map holds the same
+ * name more than once, the first one is found, just like a linear scan over the map would.
  *
- * @todo It may be worth trying to add some kind of safeguard to fall back on default config if enough
- * elements fail to be parsed. For example, if the keybinds all (or many) fail, it could soft-lock the
- * user in the program. Not sure best way to do that, or if it is even the best idea to add.
+ * @param[in,out] index Pointer to the index of the map to search.
+ * @param[in] name Name to search for, case sensitively.
  *
- * @todo The logic around @p malloced and null checking @p parsed_config before allocation is brittle, needs work.
+ * @return The index of the matching element of the map, or -1 if there is none.
  */
-static Errors_t _parse_setting_array( const config_setting_t *setting, const size_t element_size, const Array_Element_Parser_Function_t array_element_parser_function, bool *malloced,
-                                      void **parsed_config, unsigned int *parsed_config_length ) {
-
-	Errors_t returned_errors = { 0 };
+static int _parser_find_member( Member_Index_t *index, const char *name ) {
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\"\n", POINTER_NULL_PRINT_STRING );
-	RETURN_ERRORS_IF_NULL( parsed_config_length, returned_errors, "%s:\"parsed_config_length\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( index, -1, "%s:\"index\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( name, -1, "%s:\"name\"\n", POINTER_NULL_PRINT_STRING );
 
-	const char *setting_name = NULL;
-	const Error_t setting_name_error = _libconfig_get_setting_name( setting, &setting_name );
+	// Keep the table at most half full, so probe sequences stay short
+	if ( index->length * 2 > MEMBER_INDEX_SIZE ) {
+		LOG_ERROR( "Map of %u members is too large for a member index of %d slots\n", index->length, MEMBER_INDEX_SIZE );
+		return -1;
+	}
 
-	if ( setting_name_error != ERROR_NONE ) {
-		LOG_WARN( "Unable to acquire setting name, logs in this function may not print correctly: %s\n", ERROR_ENUM_STRINGS[ setting_name_error ] );
+	if ( index->hashed == false ) {
+		for ( unsigned int i = 0; i < index->length; i++ ) {
+			const char *member = ALIAS_AT( index, i );
+			unsigned int slot = _parser_fnv1a_hash( member, strlen( member ), FNV1A_OFFSET_BASIS ) & ( MEMBER_INDEX_SIZE - 1 );
+			while ( index->slots[ slot ] != 0 ) slot = ( slot + 1 ) & ( MEMBER_INDEX_SIZE - 1 );
+			index->slots[ slot ] = i + 1;
+		}
+		index->hashed = true;
 	}
 
-	*parsed_config_length = config_setting_length( setting );
-	if ( *parsed_config_length == 0 ) {
-		LOG_ERROR( "No %s listed. Default values will be used\n", setting_name );
-		add_error( &returned_errors, ERROR_NOT_FOUND );
-		return returned_errors;
+	unsigned int slot = _parser_fnv1a_hash( name, strlen( name ), FNV1A_OFFSET_BASIS ) & ( MEMBER_INDEX_SIZE - 1 );
+
+	for ( ; index->slots[ slot ] != 0; slot = ( slot + 1 ) & ( MEMBER_INDEX_SIZE - 1 ) ) {
+		if ( strcmp( ALIAS_AT( index, index->slots[ slot ] - 1 ), name ) == 0 ) return index->slots[ slot ] - 1;
 	}
 
-	LOG_DEBUG( "%u elements detected in \"%s\"\n", *parsed_config_length, setting_name );
+	return -1;
+}
 
-	// malloced is also used to determine if we should dynamically
-	// allocate the array or if it is already allocated some other
-	// way, usually on the stack, as well as report that it has
-	// been dynamically allocated here.
-	if ( malloced != NULL && parsed_config != NULL ) {
+/**
+ * @brief Hash a block of memory using 64 bit FNV-1a.
+ *
+ * @param[in] data Pointer to the memory to be hashed.
+ * @param[in] length Number of bytes of @p data to hash.
+ * @param[in] hash Hash to continue from. Pass @ref FNV1A_OFFSET_BASIS to start a new hash.
+ *
+ * @return @p hash, continued over @p length bytes of @p data.
+ */
+static uint64_t _parser_fnv1a_hash( const void *data, const size_t length, uint64_t hash ) {
 
-		if ( element_size == 0 ) {
-			LOG_ERROR( "Cannot allocate memory correctly if element size to allocate is 0\n" );
-			add_error( &returned_errors, ERROR_RANGE );
-			return returned_errors;
-		}
+	const unsigned char *bytes = data;
 
-		LOG_DEBUG( "Dynamically allocating %lu bytes of memory for \"%s\"\n", *parsed_config_length * element_size, setting_name );
+	for ( size_t i = 0; i < length; i++ ) {
+		hash ^= bytes[ i ];
+		hash *= FNV1A_PRIME;
+	}
 
-		errno = 0;
-		void *calloced_memory = calloc( *parsed_config_length, element_size );
+	return hash;
+}
 
-		if ( calloced_memory == NULL ) {
-			LOG_ERROR( "Failed to allocate %lu bytes for \"%s\": %s\n", *parsed_config_length * element_size, setting_name, strerror(errno) );
-			add_error( &returned_errors, ERROR_ALLOCATION );
-			return returned_errors;
-		}
+/**
+ * @brief Free an arena and everything allocated out of it.
+ *
+ * @param[in] arena Pointer to the arena to free, or NULL.
+ */
+static void _parser_free_arena( Arena_t *arena ) {
 
-		*parsed_config = calloced_memory;
-		*malloced = true;
+	if ( arena == NULL ) return;
+
+	while ( arena->blocks != NULL ) {
+		Arena_Block_t *next_block = arena->blocks->next;
+		free( arena->blocks );
+		arena->blocks = next_block;
 	}
 
-	for ( unsigned int i = 0; i < *parsed_config_length; i++ ) {
+	free( arena->strings );
+	free( arena );
+}
 
-		config_setting_t *child_setting = config_setting_get_elem( setting, i );
+/**
+ * @brief Free the memory held by a bind index.
+ *
+ * @param[in,out] index Pointer to the index to free. It is zeroed afterward.
+ */
+static void _parser_free_bind_index( Bind_Index_t *index ) {
 
-		RETURN_ERRORS_IF_NULL( child_setting, returned_errors, "Element index %u in \"%s\" returned NULL\n", i, setting_name );
+	RETURN_IF_NULL( index, "%s:\"index\"\n", POINTER_NULL_PRINT_STRING );
 
-		// Yes, parsed_config can be NULL, that is intended. It is used by things like
-		// theme or tag parsing that rely on global values.
-		void *element = parsed_config ? (char *) ( *parsed_config ) + ( i * element_size ) : NULL;
+	free( index->buckets );
+	free( index->next );
 
-		const Errors_t parsing_error = array_element_parser_function( child_setting, i, element );
+	memset( index, 0, sizeof( *index ) );
+}
 
-		if ( errors_failure_count( &parsing_error ) ) {
-			LOG_WARN( "\"%s\" element number %d failed to be parsed. It had %d errors\n", setting_name, i + 1, errors_failure_count( &parsing_error ) );
-			copy_errors( &returned_errors, parsing_error );
-			continue;
-		}
+/**
+ * @brief Free the memory held by a rule matcher.
+ *
+ * @param[in,out] matcher Pointer to the matcher to free. It is zeroed afterward.
+ */
+static void _parser_free_rule_matcher( Rule_Matcher_t *matcher ) {
+
+	RETURN_IF_NULL( matcher, "%s:\"matcher\"\n", POINTER_NULL_PRINT_STRING );
+
+	for ( unsigned int i = 0; i < RULE_FIELD_LENGTH; i++ ) {
+		free( matcher->automata[ i ].nodes );
+		free( matcher->automata[ i ].next_rule );
 	}
 
-	return returned_errors;
+	free( matcher->required );
+	free( matcher->always );
+	free( matcher->found );
+	free( matcher->found_stamp );
+	free( matcher->matches );
+
+	memset( matcher, 0, sizeof( *matcher ) );
 }
 
 /**
- * @brief TODO
+ * @brief Replace a string with its interned copy in @ref config_arena.
  *
- * TODO
+ * The first time a string is interned, it is copied into @ref config_arena. Interning an
+ * equal string afterward returns that same copy, so repeated strings, like the same spawn
+ * command bound to several keys, only take up memory once. The interning table grows to
+ * stay at most half full.
  *
- * @param[in] setting TODO
- * @param[out] index TODO
+ * @param[in,out] string Pointer to the string to intern. Left untouched if it is NULL.
  *
- * @return TODO
+ * @return @ref ERROR_NONE on success, or if @p string points to NULL.
+ * @return @ref ERROR_NULL_VALUE if @p string is NULL.
+ * @return @ref ERROR_ALLOCATION if there is no @ref config_arena, or memory failed to be allocated.
  */
-static Errors_t _parse_tag( config_setting_t *setting, const unsigned int index ) {
+static Error_t _parser_intern_string( const char **string ) {
 
-	Errors_t returned_errors = { 0 };
+	RETURN_VALUE_IF_NULL( string, ERROR_NULL_VALUE, "%s:\"string\"\n", POINTER_NULL_PRINT_STRING );
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	if ( *string == NULL ) return ERROR_NONE;
 
-	if ( index >= LENGTH( tags ) ) {
-		LOG_WARN( "Parsed tag's index exceeds limits of the tags array\n" );
-		add_error( &returned_errors, ERROR_RANGE );
-		return returned_errors;
-	}
+	RETURN_VALUE_IF_NULL( config_arena, ERROR_ALLOCATION, "%s:\"config_arena\"\n", POINTER_NULL_PRINT_STRING );
 
-	const char *original_tag_name = tags[ index ];
+	Arena_t *arena = config_arena;
 
-	if ( config_setting_type( setting ) != CONFIG_TYPE_STRING ) {
-		LOG_WARN( "Tag element at index %u is not a string\n", index );
-		add_error( &returned_errors, ERROR_TYPE );
-		return returned_errors;
+	if ( ( arena->strings_count + 1 ) * 2 > arena->strings_capacity ) {
+		const unsigned int capacity = arena->strings_capacity ? arena->strings_capacity * 2 : 64;
+
+		errno = 0;
+		const char **strings = calloc( capacity, sizeof( char * ) );
+
+		RETURN_VALUE_IF_NULL( strings, ERROR_ALLOCATION, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, capacity * sizeof( char * ), strerror( errno ) );
+
+		for ( unsigned int i = 0; i < arena->strings_capacity; i++ ) {
+			if ( arena->strings[ i ] == NULL ) continue;
+			unsigned int slot = _parser_fnv1a_hash( arena->strings[ i ], strlen( arena->strings[ i ] ), FNV1A_OFFSET_BASIS ) & ( capacity - 1 );
+			while ( strings[ slot ] != NULL ) slot = ( slot + 1 ) & ( capacity - 1 );
+			strings[ slot ] = arena->strings[ i ];
+		}
+
+		free( arena->strings );
+		arena->strings = strings;
+		arena->strings_capacity = capacity;
 	}
 
-	tags[ index ] = config_setting_get_string( setting );
+	const size_t length = strlen( *string );
+	unsigned int slot = _parser_fnv1a_hash( *string, length, FNV1A_OFFSET_BASIS ) & ( arena->strings_capacity - 1 );
 
-	if ( tags[ index ] == NULL ) {
-		tags[ index ] = original_tag_name;
-		LOG_WARN( "Failed to parse tag at index %u for unknown an reason\n", index );
-		add_error( &returned_errors, ERROR_NULL_VALUE );
-		return returned_errors;
+	for ( ; arena->strings[ slot ] != NULL; slot = ( slot + 1 ) & ( arena->strings_capacity - 1 ) ) {
+		if ( strcmp( arena->strings[ slot ], *string ) == 0 ) {
+			*string = arena->strings[ slot ];
+			return ERROR_NONE;
+		}
 	}
 
-	return returned_errors;
+	char *copy = _parser_arena_alloc( arena, length + 1, sizeof( char ) );
+
+	RETURN_VALUE_IF_NULL( copy, ERROR_ALLOCATION, "%s to intern \"%s\"\n", FAILED_ALLOC_PRINT_STRING, *string );
+
+	memcpy( copy, *string, length + 1 );
+
+	arena->strings[ slot ] = copy;
+	arena->strings_count++;
+	*string = copy;
+
+	_parser_report.interned_bytes += length + 1;
+	_parser_report.interned_count++;
+
+	return ERROR_NONE;
 }
 
 /**
- * @brief Thin adapter function to allow for tag parsing inside a generic array parsing function.
+ * @brief Hash a keybind chord.
  *
- * See @ref _parse_tag() for function documentation.
+ * @param[in] keysym X11 keysym of the keybind.
+ * @param[in] modifier Cleaned X11 modifier mask of the keybind.
+ *
+ * @return The hash of the chord.
  */
-static Errors_t _parse_tags_adapter( config_setting_t *setting, const unsigned int index, void *unused ) {
-	return _parse_tag( setting, index );
+static uint64_t _parser_keybind_hash( const KeySym keysym, const unsigned int modifier ) {
+
+	const uint64_t chord[ ] = { keysym, modifier };
+
+	return _parser_fnv1a_hash( chord, sizeof( chord ), FNV1A_OFFSET_BASIS );
 }
 
 /**
- * @brief Parse a list of tags from a libconfig configuration.
+ * @brief Hash the chord of an element of @ref keys, for @ref _parser_build_bind_index().
  *
- * TODO
+ * @param[in] bind_index Index of the element of @ref keys to hash.
  *
- * @param[in] config Pointer to the libconfig configuration containing the tags to be parsed.
+ * @return The hash of the keybind's chord.
+ */
+static uint64_t _parser_keybind_index_hash( const unsigned int bind_index ) {
+
+	return _parser_keybind_hash( keys[ bind_index ].keysym, CLEANMASK( keys[ bind_index ].mod ) );
+}
+
+/**
+ * @brief Log the report of the parse that just finished, and write it to a file if requested.
  *
- * @return TODO
+ * Logs how long the parse and each of its phases took, and how much memory it allocated,
+ * from @ref _parser_report. If the environment variable @ref REPORT_ENVIRONMENT_VARIABLE
+ * names a file, the report is also written there as one `key value` pair per line,
+ * replacing the report of the previous parse.
+ *
+ * @param[in] action What was done with the configuration, like "Parsed" or "Reloaded".
+ * @param[in] errors Pointer to the errors collected while parsing.
+ * @param[in] snapshot_loaded Whether the configuration was loaded from its snapshot.
  */
-static Errors_t _parse_tags_config( const config_t *config ) {
+static void _parser_log_report( const char *action, const Errors_t *errors, const bool snapshot_loaded ) {
 
-	const char *lookup_path = "tags";
-	unsigned int tags_count = 0;
-	Errors_t returned_errors = { 0 };
+	const Parse_Report_t *report = &_parser_report;
+	const uint64_t total_nanoseconds = _parser_time_now() - report->start_nanoseconds;
+
+	LOG_INFO( "%s \"%s\" from its %s in %.3f ms with %d errors\n", action, config_filepath, snapshot_loaded ? "snapshot" : "file", total_nanoseconds / 1e6,
+	          errors_failure_count( errors ) );
+
+	for ( unsigned int i = 0; i < PHASE_ENUM_LENGTH; i++ ) {
+		if ( report->phase_nanoseconds[ i ] != 0 ) LOG_INFO( "Phase %-14s %10.3f ms\n", PHASE_ENUM_STRINGS[ i ], report->phase_nanoseconds[ i ] / 1e6 );
+	}
+
+	LOG_INFO( "Allocated %zu bytes in %u arrays, %zu bytes in %u interned strings, and %zu bytes in %u duplicated strings\n", report->array_bytes, report->array_count,
+	          report->interned_bytes, report->interned_count, report->estrdup_bytes, report->estrdup_count );
+
+	const char *report_filepath = getenv( REPORT_ENVIRONMENT_VARIABLE );
+
+	if ( report_filepath == NULL || report_filepath[ 0 ] == '\0' ) return;
+
+	errno = 0;
+	FILE *report_file = fopen( report_filepath, "w" );
+
+	if ( report_file == NULL ) {
+		LOG_WARN( "Unable to write the parse report to \"%s\": %s\n", report_filepath, strerror( errno ) );
+		return;
+	}
+
+	fprintf( report_file, "config %s\nsource %s\nerrors %d\ntotal_ns %llu\n", config_filepath, snapshot_loaded ? "snapshot" : "file", errors_failure_count( errors ),
+	         (unsigned long long) total_nanoseconds );
+
+	for ( unsigned int i = 0; i < PHASE_ENUM_LENGTH; i++ ) {
+		fprintf( report_file, "phase_%s_ns %llu\n", PHASE_ENUM_STRINGS[ i ], (unsigned long long) report->phase_nanoseconds[ i ] );
+	}
+
+	fprintf( report_file, "array_bytes %zu\narray_count %u\ninterned_bytes %zu\ninterned_count %u\nestrdup_bytes %zu\nestrdup_count %u\n", report->array_bytes, report->array_count,
+	         report->interned_bytes, report->interned_count, report->estrdup_bytes, report->estrdup_count );
+
+	if ( fclose( report_file ) != 0 ) {
+		LOG_WARN( "Unable to write the parse report to \"%s\": %s\n", report_filepath, strerror( errno ) );
+	}
+}
+
+/**
+ * @brief Allocate a new, empty arena.
+ *
+ * @return Pointer to the new arena, to be freed with @ref _parser_free_arena(),
+ * or NULL if memory failed to be allocated.
+ */
+static Arena_t *_parser_new_arena( void ) {
+
+	errno = 0;
+	Arena_t *arena = calloc( 1, sizeof( Arena_t ) );
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( arena, NULL, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, sizeof( Arena_t ), strerror( errno ) );
 
-	config_setting_t *array_setting = NULL;
-	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
-	add_error( &returned_errors, lookup_error );
+	return arena;
+}
 
-	if ( lookup_error != ERROR_NONE ) {
-		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
-		return returned_errors;
-	}
+/**
+ * @brief Allocate and initialize a new libconfig configuration.
+ *
+ * @return Pointer to the new configuration, to be freed with `config_destroy()` and `free()`,
+ * or NULL if memory failed to be allocated.
+ */
+static config_t *_parser_new_config( void ) {
 
-	const Errors_t array_errors = _parse_setting_array( array_setting, 0, _parse_tags_adapter, NULL, NULL, &tags_count );
-	copy_errors( &returned_errors, array_errors );
+	errno = 0;
+	config_t *config = calloc( 1, sizeof( config_t ) );
 
-	if ( tags_count > LENGTH( tags ) ) {
-		LOG_WARN( "More than %lu tag names detected (%d were detected) while parsing config, only the first %lu will be used\n", LENGTH( tags ), tags_count, LENGTH( tags ) );
-	} else if ( tags_count < LENGTH( tags ) ) {
-		LOG_WARN( "Less than %lu tag names detected while parsing config, default tags will be used for the remainder\n", LENGTH( tags ) );
-	}
+	RETURN_VALUE_IF_NULL( config, NULL, "%s (%zu bytes) using calloc(): %s\n", FAILED_ALLOC_PRINT_STRING, sizeof( config_t ), strerror( errno ) );
 
-	return returned_errors;
+	config_init( config );
+
+	return config;
 }
 
 /**
- * @brief Parse a theme from a libconfig configuration setting.
+ * @brief Collects the identity of an open configuration file's contents.
  *
- * TODO
+ * This function hashes the entire contents of @p file, along with its size and modification
+ * time, so that a snapshot can be tied to the exact bytes it was parsed from. @p file is
+ * rewound afterward so it can still be read by libconfig.
  *
- * @param[in] setting Pointer to the libconfig setting containing the theme to be parsed.
- * @param[in] index Index of the current theme being parsed.
+ * @param[in] file Open configuration file to identify.
+ * @param[out] source_info Pointer to where to store the collected identity. Its `valid`
+ * field is only set to `true` on success.
  *
- * @return TODO
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
+ * @return @ref ERROR_IO if @p file failed to be stat-ed or read.
  */
-static Errors_t _parse_theme( config_setting_t *setting, const unsigned int index ) {
+static Error_t _parser_read_source_info( FILE *file, Source_Info_t *source_info ) {
 
-	Errors_t returned_errors = { 0 };
+	RETURN_VALUE_IF_NULL( file, ERROR_NULL_VALUE, "%s:\"file\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( source_info, ERROR_NULL_VALUE, "%s:\"source_info\"\n", POINTER_NULL_PRINT_STRING );
 
-	RETURN_ERRORS_IF_NULL( setting, returned_errors, "%s:\"setting\" at index %d\n", POINTER_NULL_PRINT_STRING, index );
+	source_info->valid = false;
 
-	// dwm does not support more than 1 theme
-	if ( index > 0 ) {
-		LOG_WARN( "%d themes detected. dwm can only supports using 1 theme\n", index + 1 );
-		add_error( &returned_errors, ERROR_RANGE );
-		return returned_errors;
+	struct stat stat_variable;
+
+	errno = 0;
+	if ( fstat( fileno( file ), &stat_variable ) != 0 ) {
+		LOG_WARN( "Failed to stat config file: %s\n", strerror( errno ) );
+		return ERROR_IO;
 	}
 
-	const char *fonts_lookup_path = "fonts";
-	config_setting_t *array_setting = NULL;
-	const Error_t lookup_error = _libconfig_generic_lookup( setting, fonts_lookup_path, CONFIG_TYPE_LIST, &array_setting );
-	add_error( &returned_errors, lookup_error );
+	uint64_t hash = FNV1A_OFFSET_BASIS;
+	char buffer[ 4096 ];
+	size_t read_size = 0;
 
-	if ( lookup_error != ERROR_NONE ) {
-		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", fonts_lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
-		return returned_errors;
+	while ( ( read_size = fread( buffer, 1, sizeof( buffer ), file ) ) > 0 ) {
+		hash = _parser_fnv1a_hash( buffer, read_size, hash );
 	}
 
-	const Errors_t font_errors = _parse_setting_array( array_setting, sizeof( char * ), _parse_font_adapter, &fonts_malloced, (void **) &fonts, &fonts_count );
-	copy_errors( &returned_errors, font_errors );
+	const bool read_failed = ferror( file );
+	rewind( file );
 
-	for ( unsigned int i = 0; i < LENGTH( THEME_ALIAS_MAP ); i++ ) {
-		const Error_t error = _libconfig_lookup_string( setting, THEME_ALIAS_MAP[ i ].alias, THEME_ALIAS_MAP[ i ].color );
-		add_error( &returned_errors, error );
-		if ( error != ERROR_NONE ) {
-			LOG_WARN( "Failed to parse theme %d's element \"%s\": %s\n", index, THEME_ALIAS_MAP[ i ].alias, ERROR_ENUM_STRINGS[ error ] );
-		}
-	}
+	if ( read_failed ) return ERROR_IO;
 
-	return returned_errors;
+	source_info->hash = hash;
+	source_info->size = stat_variable.st_size;
+	source_info->mtime_seconds = stat_variable.st_mtim.tv_sec;
+	source_info->mtime_nanoseconds = stat_variable.st_mtim.tv_nsec;
+	source_info->valid = true;
+
+	return ERROR_NONE;
 }
 
 /**
- * @brief Thin adapter function to allow for theme parsing inside a generic array parsing function.
+ * @brief Start a new report in @ref _parser_report for a parse that is about to begin.
+ */
+static void _parser_reset_report( void ) {
+
+	memset( &_parser_report, 0, sizeof( _parser_report ) );
+	_parser_report.start_nanoseconds = _parser_time_now();
+}
+
+/**
+ * @brief Find the child of a rule automaton node along an edge.
  *
- * See @ref _parse_theme() for function documentation.
+ * @param[in] automaton Pointer to the automaton.
+ * @param[in] node Node to find the child of.
+ * @param[in] byte Byte of the edge to the child.
+ *
+ * @return The child node, or 0 if @p node has no such child.
  */
-static Errors_t _parse_theme_adapter( config_setting_t *setting, const unsigned int index, void *unused ) {
-	return _parse_theme( setting, index );
+static unsigned int _parser_rule_automaton_child( const Rule_Automaton_t *automaton, const unsigned int node, const unsigned char byte ) {
+
+	unsigned int child = automaton->nodes[ node ].first_child;
+
+	while ( child != 0 && automaton->nodes[ child ].byte != byte ) child = automaton->nodes[ child ].next_sibling;
+
+	return child;
 }
 
 /**
- * @brief Parse a list of themes from a libconfig configuration.
+ * @brief Get one field of a rule.
  *
- * TODO
+ * @param[in] rule Pointer to the rule.
+ * @param[in] field Field of @p rule to get.
  *
- * @param[in] config Pointer to the libconfig configuration containing the theme to be parsed.
+ * @return The pattern @p rule has for @p field, which may be NULL.
+ */
+static const char *_parser_rule_field( const Rule *rule, const Rule_Field_t field ) {
+
+	switch ( field ) {
+		case RULE_FIELD_CLASS: return rule->class;
+		case RULE_FIELD_INSTANCE: return rule->instance;
+		case RULE_FIELD_TITLE: return rule->title;
+		default: return NULL;
+	}
+}
+
+/**
+ * @brief Scan a string through a rule automaton, recording the rules it completes.
  *
- * @return TODO
+ * Every rule whose pattern for the automaton's field is found in @p string has one more
+ * of its required fields found. Rules with all their required fields found are appended
+ * to the matcher's matches. Nodes are only counted the first time they are reached.
  *
- * @note dwm only supports a single theme, so only the first theme in the list is parsed.
+ * @param[in,out] matcher Pointer to the matcher the automaton belongs to.
+ * @param[in,out] automaton Pointer to the automaton to scan @p string through.
+ * @param[in] string String to scan. Nothing is found in a NULL string.
  */
-static Errors_t _parse_theme_config( const config_t *config ) {
+static void _parser_scan_rule_automaton( Rule_Matcher_t *matcher, Rule_Automaton_t *automaton, const char *string ) {
 
-	Errors_t returned_errors = { 0 };
-	const char *lookup_path = "themes";
+	if ( string == NULL || automaton->nodes[ 0 ].first_child == 0 ) return;
 
-	RETURN_ERRORS_IF_NULL( config, returned_errors, "%s:\"config\"\n", POINTER_NULL_PRINT_STRING );
+	unsigned int node = 0;
 
-	config_setting_t *array_setting = NULL;
-	const Error_t lookup_error = _libconfig_generic_lookup( config_root_setting( config ), lookup_path, CONFIG_TYPE_LIST, &array_setting );
-	add_error( &returned_errors, lookup_error );
+	for ( const unsigned char *byte = (const unsigned char *) string; *byte != '\0'; byte++ ) {
+		unsigned int child = 0;
 
-	if ( lookup_error != ERROR_NONE ) {
-		LOG_ERROR( "Lookup of \"%s\" failed: %s\n", lookup_path, ERROR_ENUM_STRINGS[ lookup_error ] );
-		return returned_errors;
-	}
+		for ( ;; ) {
+			child = _parser_rule_automaton_child( automaton, node, *byte );
+			if ( child != 0 || node == 0 ) break;
+			node = automaton->nodes[ node ].fail;
+		}
 
-	unsigned int unused = 0;
-	const Errors_t array_errors = _parse_setting_array( array_setting, 0, _parse_theme_adapter, NULL, NULL, &unused );
-	copy_errors( &returned_errors, array_errors );
+		node = child;
 
-	return returned_errors;
-}
+		// Every pattern ending here is either this node's, or on its dictionary chain
+		for ( unsigned int output = automaton->nodes[ node ].first_rule < matcher->rules_count ? node : automaton->nodes[ node ].dictionary; output != 0;
+		      output = automaton->nodes[ output ].dictionary ) {
+			if ( automaton->nodes[ output ].seen == matcher->stamp ) break;
+			automaton->nodes[ output ].seen = matcher->stamp;
 
-/////////////////////////////////////////////
-///// Parser internal utility functions /////
-/////////////////////////////////////////////
+			for ( unsigned int rule = automaton->nodes[ output ].first_rule; rule < matcher->rules_count; rule = automaton->next_rule[ rule ] ) {
+				if ( matcher->found_stamp[ rule ] != matcher->stamp ) {
+					matcher->found_stamp[ rule ] = matcher->stamp;
+					matcher->found[ rule ] = 0;
+				}
+
+				if ( ++matcher->found[ rule ] == matcher->required[ rule ] ) matcher->matches[ matcher->matches_count++ ] = rule;
+			}
+		}
+	}
+}
 
 /**
- * @brief TODO
- *
- * TODO
+ * @brief Append a string to a snapshot's string table.
  *
- * @param[in] parent_setting TODO
- * @param[in] path TODO
- * @param[in] expected_type TODO
- * @param[out] parsed_value TODO
+ * @param[in,out] strings Pointer to the string table to append @p string to.
+ * @param[in] string String to append. May be NULL.
+ * @param[out] offset Pointer to where to store the offset of @p string in @p strings,
+ * or @ref SNAPSHOT_NULL_INDEX if @p string is NULL.
  *
  * @return @ref ERROR_NONE on success.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_NOT_FOUND if lookup failed.
- * @return @ref ERROR_TYPE if type found at @p path does not match
- * @p expected_type or if there is an unexpected type in the switch case.
+ * @return @ref ERROR_RANGE if the string table would outgrow a 32 bit offset.
+ * @return @ref ERROR_ALLOCATION if the string table failed to be grown.
  */
-static Error_t _libconfig_generic_lookup( config_setting_t *parent_setting, const char *path, const int expected_type, void *parsed_value ) {
+static Error_t _parser_snapshot_add_string( Snapshot_Strings_t *strings, const char *string, uint32_t *offset ) {
 
-	if ( parent_setting == NULL || path == NULL || parsed_value == NULL ) return ERROR_NULL_VALUE;
+	RETURN_VALUE_IF_NULL( strings, ERROR_NULL_VALUE, "%s:\"strings\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( offset, ERROR_NULL_VALUE, "%s:\"offset\"\n", POINTER_NULL_PRINT_STRING );
 
-	config_setting_t *child_setting = config_setting_lookup( parent_setting, path );
+	if ( string == NULL ) {
+		*offset = SNAPSHOT_NULL_INDEX;
+		return ERROR_NONE;
+	}
 
-	if ( child_setting == NULL ) return ERROR_NOT_FOUND;
+	const size_t length = strlen( string ) + 1;
 
-	if ( config_setting_type( child_setting ) != expected_type ) return ERROR_TYPE;
+	if ( strings->size + length >= SNAPSHOT_NULL_INDEX ) return ERROR_RANGE;
 
-	switch ( expected_type ) {
-		case CONFIG_TYPE_STRING:
-			*(const char **) parsed_value = config_setting_get_string( child_setting );
-			break;
+	if ( strings->size + length > strings->capacity ) {
+		size_t capacity = strings->capacity ? strings->capacity * 2 : 4096;
+		while ( capacity < strings->size + length ) capacity *= 2;
 
-		case CONFIG_TYPE_INT:
-			*(int *) parsed_value = config_setting_get_int( child_setting );
-			break;
+		errno = 0;
+		char *data = realloc( strings->data, capacity );
 
-		case CONFIG_TYPE_INT64:
-			*(long long *) parsed_value = config_setting_get_int64( child_setting );
-			break;
+		RETURN_VALUE_IF_NULL( data, ERROR_ALLOCATION, "%s (%zu bytes) using realloc(): %s\n", FAILED_ALLOC_PRINT_STRING, capacity, strerror(errno) );
 
-		case CONFIG_TYPE_FLOAT:
-			*(float *) parsed_value = config_setting_get_float( child_setting );
-			break;
+		strings->data = data;
+		strings->capacity = capacity;
+	}
 
-		case CONFIG_TYPE_BOOL:
-			*(bool *) parsed_value = config_setting_get_bool( child_setting );
-			break;
+	memcpy( strings->data + strings->size, string, length );
+	*offset = (uint32_t) strings->size;
+	strings->size += length;
 
-		case CONFIG_TYPE_GROUP:
-		case CONFIG_TYPE_ARRAY:
-		case CONFIG_TYPE_LIST:
-			*(config_setting_t **) parsed_value = child_setting;
-			break;
+	return ERROR_NONE;
+}
 
-		default:
-			return ERROR_TYPE;
-	}
+/**
+ * @brief Computes the size of everything in a snapshot before its string table.
+ *
+ * @param[in] header Pointer to the snapshot header containing the section counts.
+ *
+ * @return Size in bytes of the header and all of the record sections described by @p header.
+ */
+static uint64_t _parser_snapshot_fixed_size( const Snapshot_Header_t *header ) {
+
+	return sizeof( Snapshot_Header_t ) + (uint64_t) header->keys_count * sizeof( Snapshot_Key_t ) + (uint64_t) header->buttons_count * sizeof( Snapshot_Button_t ) +
+	       (uint64_t) header->rules_count * sizeof( Snapshot_Rule_t ) + (uint64_t) header->settings_count * sizeof( uint64_t ) +
+	       ( (uint64_t) header->fonts_count + header->tags_count + header->colors_count ) * sizeof( uint32_t );
+}
+
+/**
+ * @brief Locates each section of a snapshot image.
+ *
+ * @param[in] image Pointer to the snapshot image, starting with a @ref Snapshot_Header_t.
+ * @param[in] image_size Size in bytes of @p image.
+ * @param[out] layout Pointer to where to store the location of each section of @p image.
+ *
+ * @return @ref ERROR_NONE on success.
+ * @return @ref ERROR_RANGE if the sections described by the header don't fit in @p image_size.
+ */
+static Error_t _parser_snapshot_layout( void *image, const uint64_t image_size, Snapshot_Layout_t *layout ) {
+
+	Snapshot_Header_t *header = image;
+	const uint64_t fixed_size = _parser_snapshot_fixed_size( header );
+
+	if ( fixed_size > image_size ) return ERROR_RANGE;
+
+	char *walk = image;
+
+	layout->header = header;
+	walk += sizeof( Snapshot_Header_t );
+	layout->keys = (Snapshot_Key_t *) walk;
+	walk += header->keys_count * sizeof( Snapshot_Key_t );
+	layout->buttons = (Snapshot_Button_t *) walk;
+	walk += header->buttons_count * sizeof( Snapshot_Button_t );
+	layout->rules = (Snapshot_Rule_t *) walk;
+	walk += header->rules_count * sizeof( Snapshot_Rule_t );
+	layout->settings = (uint64_t *) walk;
+	walk += header->settings_count * sizeof( uint64_t );
+	layout->fonts = (uint32_t *) walk;
+	layout->tags = layout->fonts + header->fonts_count;
+	layout->colors = layout->tags + header->tags_count;
+	layout->strings = (char *) ( layout->colors + header->colors_count );
+	layout->fixed_size = fixed_size;
 
 	return ERROR_NONE;
 }
 
 /**
- * @brief Returns the name of a given setting, or its nearest named parent setting.
+ * @brief Packs a bind's function and argument into their snapshot representation.
  *
- * TODO
+ * The function is stored as its index in @ref FUNCTION_ALIAS_MAP, and the argument is
+ * stored according to that function's argument type: strings as an offset into @p strings,
+ * numbers and booleans as their raw bytes.
  *
- * @param[in] setting TODO
- * @param[out] found_name TODO
+ * @param[in,out] strings Pointer to the string table string arguments are appended to.
+ * @param[in] function Bind function to pack. May be NULL.
+ * @param[in] argument Pointer to the bind's argument.
+ * @param[out] function_index Pointer to where to store the packed function.
+ * @param[out] packed_argument Pointer to where to store the packed argument.
  *
  * @return @ref ERROR_NONE on success.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_NOT_FOUND if no named parent settings are found.
+ * @return @ref ERROR_NOT_FOUND if @p function is not present in @ref FUNCTION_ALIAS_MAP.
+ * @return Any error returned from @ref _parser_snapshot_add_string().
  */
-static Error_t _libconfig_get_setting_name( const config_setting_t *setting, const char **found_name ) {
+static Error_t _parser_snapshot_pack_argument( Snapshot_Strings_t *strings, void ( *function )( const Arg * ), const Arg *argument, uint32_t *function_index, uint64_t *packed_argument ) {
 
-	if ( setting == NULL || found_name == NULL ) return ERROR_NULL_VALUE;
+	RETURN_VALUE_IF_NULL( argument, ERROR_NULL_VALUE, "%s:\"argument\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( function_index, ERROR_NULL_VALUE, "%s:\"function_index\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( packed_argument, ERROR_NULL_VALUE, "%s:\"packed_argument\"\n", POINTER_NULL_PRINT_STRING );
 
-	while ( setting != NULL ) {
-		const char *tmp_string = config_setting_name( setting );
+	*function_index = SNAPSHOT_NULL_INDEX;
+	*packed_argument = 0;
 
-		if ( tmp_string != NULL ) {
-			*found_name = tmp_string;
-			return ERROR_NONE;
+	if ( function == NULL ) return ERROR_NONE;
+
+	for ( unsigned int i = 0; i < LENGTH( FUNCTION_ALIAS_MAP ); i++ ) {
+		if ( FUNCTION_ALIAS_MAP[ i ].function != function ) continue;
+
+		*function_index = i;
+
+		if ( FUNCTION_ALIAS_MAP[ i ].argument_type == TYPE_STRING || FUNCTION_ALIAS_MAP[ i ].argument_type == TYPE_COMMAND ) {
+			const char *string = argument->v;
+			if ( FUNCTION_ALIAS_MAP[ i ].argument_type == TYPE_COMMAND && string != NULL ) string = ( (const Spawn_Command_t *) argument->v )->command;
+
+			uint32_t offset = SNAPSHOT_NULL_INDEX;
+			const Error_t string_error = _parser_snapshot_add_string( strings, string, &offset );
+			*packed_argument = offset;
+			return string_error;
 		}
 
-		setting = config_setting_parent( setting );
+		memcpy( packed_argument, argument, _parser_data_type_size( FUNCTION_ALIAS_MAP[ i ].argument_type ) );
+		return ERROR_NONE;
 	}
 
 	return ERROR_NOT_FOUND;
 }
 
 /**
- * @brief Look up a float value in a libconfig setting.
+ * @brief Hashes everything a snapshot's contents depend on besides the configuration file itself.
  *
- * TODO
- *
- * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
- * @param[in] path Path expression to search within @p parent_setting.
- * @param[in] range_min Minimum value that can be saved to @p parsed_value.
- * @param[in] range_max Maximum value that can be saved to @p parsed_value.
- * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ * Snapshots store functions, settings, and colors by their position in the alias maps, so this
+ * hash covers the alias maps' names, types, and ranges, as well as the sizes of the structs they
+ * describe. A build that changes any of them will discard snapshots written by another.
  *
- * @return @ref ERROR_NONE on success.
- * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or
- * if the parsed value at @p path is outside the provided range.
- * @return Any error returned from @ref _libconfig_generic_lookup().
+ * @return Hash of the alias maps and struct sizes compiled into this build.
  */
-static Error_t _libconfig_lookup_float( config_setting_t *parent_setting, const char *path, const float range_min, const float range_max, float *parsed_value ) {
+static uint64_t _parser_snapshot_schema_hash( void ) {
 
-	if ( parent_setting == NULL || path == NULL || parsed_value == NULL ) return ERROR_NULL_VALUE;
-	if ( range_min > range_max ) return ERROR_RANGE;
+	const uint64_t sizes[ ] = {
+		sizeof( Key ), sizeof( Button ), sizeof( Rule ), sizeof( Arg ), sizeof( KeySym ),
+		LENGTH( tags ), LENGTH( FUNCTION_ALIAS_MAP ), LENGTH( SETTING_ALIAS_MAP ), LENGTH( THEME_ALIAS_MAP )
+	};
 
-	float tmp_float = 0;
-	const Error_t lookup_error = _libconfig_generic_lookup( parent_setting, path, CONFIG_TYPE_FLOAT, &tmp_float );
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	uint64_t hash = _parser_fnv1a_hash( sizes, sizeof( sizes ), FNV1A_OFFSET_BASIS );
 
-	if ( tmp_float < range_min || tmp_float > range_max ) return ERROR_RANGE;
+	for ( unsigned int i = 0; i < LENGTH( FUNCTION_ALIAS_MAP ); i++ ) {
+		const double range[ ] = { (double) FUNCTION_ALIAS_MAP[ i ].range_min, (double) FUNCTION_ALIAS_MAP[ i ].range_max, (double) FUNCTION_ALIAS_MAP[ i ].argument_type };
+		hash = _parser_fnv1a_hash( FUNCTION_ALIAS_MAP[ i ].alias, strlen( FUNCTION_ALIAS_MAP[ i ].alias ) + 1, hash );
+		hash = _parser_fnv1a_hash( range, sizeof( range ), hash );
+	}
 
-	*parsed_value = tmp_float;
+	for ( unsigned int i = 0; i < LENGTH( SETTING_ALIAS_MAP ); i++ ) {
+		const double range[ ] = { (double) SETTING_ALIAS_MAP[ i ].range_min, (double) SETTING_ALIAS_MAP[ i ].range_max, (double) SETTING_ALIAS_MAP[ i ].type };
+		hash = _parser_fnv1a_hash( SETTING_ALIAS_MAP[ i ].alias, strlen( SETTING_ALIAS_MAP[ i ].alias ) + 1, hash );
+		hash = _parser_fnv1a_hash( range, sizeof( range ), hash );
+	}
 
-	return ERROR_NONE;
+	for ( unsigned int i = 0; i < LENGTH( THEME_ALIAS_MAP ); i++ ) {
+		hash = _parser_fnv1a_hash( THEME_ALIAS_MAP[ i ].alias, strlen( THEME_ALIAS_MAP[ i ].alias ) + 1, hash );
+	}
+
+	return hash;
 }
 
 /**
- * @brief Look up an integer value in a libconfig setting.
- *
- * TODO
+ * @brief Resolves a string offset in a snapshot's string table.
  *
- * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
- * @param[in] path Path expression to search within @p parent_setting.
- * @param[in] range_min Minimum value that can be saved to @p parsed_value.
- * @param[in] range_max Maximum value that can be saved to @p parsed_value.
- * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ * @param[in] layout Pointer to the layout of the snapshot the offset belongs to.
+ * @param[in] offset Offset into the snapshot's string table, or @ref SNAPSHOT_NULL_INDEX.
+ * @param[out] string Pointer to where to store the resolved string, or NULL if @p offset
+ * is @ref SNAPSHOT_NULL_INDEX.
  *
  * @return @ref ERROR_NONE on success.
- * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or
- * if the parsed value at @p path is outside the provided range.
- * @return Any error returned from @ref _libconfig_generic_lookup().
+ * @return @ref ERROR_RANGE if @p offset is outside of the string table.
  */
-static Error_t _libconfig_lookup_int( config_setting_t *parent_setting, const char *path, const int range_min, const int range_max, int *parsed_value ) {
-
-	if ( parent_setting == NULL || path == NULL || parsed_value == NULL ) return ERROR_NULL_VALUE;
-	if ( range_min > range_max ) return ERROR_RANGE;
+static Error_t _parser_snapshot_string( const Snapshot_Layout_t *layout, const uint64_t offset, const char **string ) {
 
-	int tmp_int = 0;
-	const Error_t lookup_error = _libconfig_generic_lookup( parent_setting, path, CONFIG_TYPE_INT, &tmp_int );
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	if ( offset == SNAPSHOT_NULL_INDEX ) {
+		*string = NULL;
+		return ERROR_NONE;
+	}
 
-	if ( tmp_int < range_min || tmp_int > range_max ) return ERROR_RANGE;
+	if ( offset >= layout->header->strings_size ) return ERROR_RANGE;
 
-	*parsed_value = tmp_int;
+	*string = layout->strings + offset;
 
 	return ERROR_NONE;
 }
 
 /**
- * @brief Look up a string value in a libconfig setting.
+ * @brief Unpacks a bind's function and argument from their snapshot representation.
  *
- * TODO
+ * See @ref _parser_snapshot_pack_argument() for how they are packed. String arguments
+ * are copied into @ref config_arena, so they outlive the snapshot's mapping.
  *
- * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
- * @param[in] path Path expression to search within @p parent_setting.
- * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ * @param[in] layout Pointer to the layout of the snapshot the bind belongs to.
+ * @param[in] function_index Packed function, an index into @ref FUNCTION_ALIAS_MAP or @ref SNAPSHOT_NULL_INDEX.
+ * @param[in] packed_argument Packed argument.
+ * @param[out] function Pointer to where to store the unpacked function.
+ * @param[out] argument Pointer to where to store the unpacked argument.
  *
  * @return @ref ERROR_NONE on success.
- * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return Any error returned from @ref _libconfig_generic_lookup().
+ * @return @ref ERROR_RANGE if @p function_index or a string argument's offset are out of range.
+ * @return @ref ERROR_ALLOCATION if a string argument failed to be copied into @ref config_arena.
  */
-static Error_t _libconfig_lookup_string( config_setting_t *parent_setting, const char *path, const char **parsed_value ) {
+static Error_t _parser_snapshot_unpack_argument( const Snapshot_Layout_t *layout, const uint32_t function_index, const uint64_t packed_argument, void ( **function )( const Arg * ),
+                                                 Arg *argument ) {
 
-	if ( parent_setting == NULL || path == NULL || parsed_value == NULL ) return ERROR_NULL_VALUE;
+	*function = NULL;
 
-	const Error_t lookup_error = _libconfig_generic_lookup( parent_setting, path, CONFIG_TYPE_STRING, parsed_value );
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	if ( function_index == SNAPSHOT_NULL_INDEX ) return ERROR_NONE;
+	if ( function_index >= LENGTH( FUNCTION_ALIAS_MAP ) ) return ERROR_RANGE;
 
-	if ( *parsed_value && strcasecmp( *parsed_value, "NULL" ) == 0 ) {
-		*parsed_value = NULL;
+	*function = FUNCTION_ALIAS_MAP[ function_index ].function;
+
+	if ( FUNCTION_ALIAS_MAP[ function_index ].argument_type == TYPE_STRING ) {
+		const char *string = NULL;
+		Error_t string_error = _parser_snapshot_string( layout, packed_argument, &string );
+		if ( string_error == ERROR_NONE ) string_error = _parser_intern_string( &string );
+		argument->v = string;
+		return string_error;
+	}
+
+	if ( FUNCTION_ALIAS_MAP[ function_index ].argument_type == TYPE_COMMAND ) {
+		const char *string = NULL;
+		Error_t string_error = _parser_snapshot_string( layout, packed_argument, &string );
+		argument->v = NULL;
+		if ( string_error == ERROR_NONE && string != NULL ) string_error = _parser_tokenize_command( string, (const Spawn_Command_t **) &argument->v );
+		return string_error;
 	}
 
+	memcpy( argument, &packed_argument, _parser_data_type_size( FUNCTION_ALIAS_MAP[ function_index ].argument_type ) );
+
 	return ERROR_NONE;
 }
 
 /**
- * @brief Look up an unsigned integer value in a libconfig setting.
+ * @brief Read the monotonic clock, for timing the phases of a parse.
  *
- * TODO
+ * @return The current time of the monotonic clock in nanoseconds.
+ */
+static uint64_t _parser_time_now( void ) {
+
+	struct timespec now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * @brief Split a spawn command into the arguments it is executed with.
  *
- * @param[in] parent_setting Pointer to the libconfig setting to perform the lookup in.
- * @param[in] path Path expression to search within @p parent_setting.
- * @param[in] range_min Minimum value that can be saved to @p parsed_value.
- * @param[in] range_max Maximum value that can be saved to @p parsed_value.
- * @param[out] parsed_value Pointer to where the parsed value will be stored on success.
+ * Commands made only of words separated by blanks are split on them, so they
+ * can be executed directly instead of through a shell. Commands using any
+ * quoting, expansion, redirection or other shell syntax are left whole and
+ * run as `/bin/sh -c` @p command, like before. Everything is allocated in
+ * @ref config_arena, and lives as long as the configuration does.
+ *
+ * @param[in] command Null terminated command to split.
+ * @param[out] tokenized Pointer to where to store the split command.
  *
  * @return @ref ERROR_NONE on success.
  * @return @ref ERROR_NULL_VALUE if a NULL argument is provided.
- * @return @ref ERROR_RANGE if @p range_min exceeds @p range_max or if the
- * parsed value at @p path is less than zero or outside the provided range.
- * @return Any error returned from @ref _libconfig_generic_lookup().
+ * @return @ref ERROR_RANGE if @p command holds no words.
+ * @return @ref ERROR_ALLOCATION if there is no @ref config_arena, or memory failed to be allocated.
  */
-static Error_t _libconfig_lookup_uint( config_setting_t *parent_setting, const char *path, const unsigned int range_min, const unsigned int range_max, unsigned int *parsed_value ) {
+static Error_t _parser_tokenize_command( const char *command, const Spawn_Command_t **tokenized ) {
 
-	if ( parent_setting == NULL || path == NULL || parsed_value == NULL ) return ERROR_NULL_VALUE;
-	if ( range_min > range_max ) return ERROR_RANGE;
+	RETURN_VALUE_IF_NULL( command, ERROR_NULL_VALUE, "%s:\"command\"\n", POINTER_NULL_PRINT_STRING );
+	RETURN_VALUE_IF_NULL( tokenized, ERROR_NULL_VALUE, "%s:\"tokenized\"\n", POINTER_NULL_PRINT_STRING );
 
-	int tmp_int = 0;
-	const Error_t lookup_error = _libconfig_generic_lookup( parent_setting, path, CONFIG_TYPE_INT, &tmp_int );
-	if ( lookup_error != ERROR_NONE ) return lookup_error;
+	const Error_t intern_error = _parser_intern_string( &command );
+	if ( intern_error != ERROR_NONE ) return intern_error;
 
-	if ( tmp_int < 0 ) return ERROR_RANGE;
+	const bool needs_shell = command[ strcspn( command, "\n|&;<>()$`\\\"'*?[]#~=%!{}" ) ] != '\0';
+	unsigned int words = 0;
 
-	const unsigned int tmp_uint = (unsigned int) tmp_int;
+	for ( const char *c = command; *c != '\0'; c++ ) {
+		if ( *c != ' ' && *c != '\t' && ( c == command || c[ -1 ] == ' ' || c[ -1 ] == '\t' ) ) words++;
+	}
 
-	if ( tmp_uint < range_min || tmp_uint > range_max ) return ERROR_RANGE;
+	if ( words == 0 ) {
+		LOG_WARN( "Spawn command \"%s\" is empty\n", command );
+		return ERROR_RANGE;
+	}
 
-	*parsed_value = tmp_uint;
+	if ( needs_shell ) words = 3;
+
+	Spawn_Command_t *spawn_command = _parser_arena_alloc( config_arena, 1, sizeof( Spawn_Command_t ) );
+	char **argv = _parser_arena_alloc( config_arena, words + 1, sizeof( char * ) );
+
+	RETURN_VALUE_IF_NULL( spawn_command, ERROR_ALLOCATION, "%s for the command \"%s\"\n", FAILED_ALLOC_PRINT_STRING, command );
+	RETURN_VALUE_IF_NULL( argv, ERROR_ALLOCATION, "%s for the arguments of \"%s\"\n", FAILED_ALLOC_PRINT_STRING, command );
+
+	if ( needs_shell ) {
+		argv[ 0 ] = "/bin/sh";
+		argv[ 1 ] = "-c";
+		argv[ 2 ] = (char *) command;
+	} else {
+		const size_t length = strlen( command );
+		char *words_buffer = _parser_arena_alloc( config_arena, length + 1, sizeof( char ) );
+
+		RETURN_VALUE_IF_NULL( words_buffer, ERROR_ALLOCATION, "%s for the arguments of \"%s\"\n", FAILED_ALLOC_PRINT_STRING, command );
+
+		memcpy( words_buffer, command, length + 1 );
+
+		unsigned int word = 0;
+		for ( char *c = words_buffer; *c != '\0'; c++ ) {
+			if ( *c == ' ' || *c == '\t' ) {
+				*c = '\0';
+			} else if ( c == words_buffer || c[ -1 ] == '\0' ) {
+				argv[ word++ ] = c;
+			}
+		}
+	}
+
+	argv[ words ] = NULL;
+	spawn_command->command = command;
+	spawn_command->argv = argv;
+	*tokenized = spawn_command;
 
 	return ERROR_NONE;
 }
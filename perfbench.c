@@ -0,0 +1,597 @@
+/* See LICENSE file for copyright and license details.
+ *
+ * Window manager benchmark, run with `make perfbench`, see perfbench.sh.
+ *
+ * Connects to a display dwm manages, maps synthetic clients, like
+ * transient.c does, and replays scripted workloads on them: map and unmap
+ * storms, tag switching and keybinds dispatched through dwm's keypress(),
+ * status updates through the root window's name and the control socket,
+ * and an interactive resize. Every operation is timed until dwm handled it
+ * and the server handled everything dwm did for it, see barrier(). The X
+ * requests dwm makes for them are counted with the RECORD extension in a
+ * second pass, so the times are not slowed down by it.
+ *
+ * With -g it writes the configuration perfbench.sh starts dwm with instead,
+ * with the binds the workloads use and thousands more keybinds, buttonbinds
+ * and rules that never match, so the indexes are measured at that size.
+ */
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <X11/keysym.h>
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/record.h>
+#include <X11/extensions/XTest.h>
+
+#include "util.h"
+
+#define TIMEOUT                 5000 /* ms to wait for dwm before giving up */
+#define PROBECLASS              "perfbench-probe"
+
+enum { WlBarrier, WlMap, WlUnmap, WlView, WlKey, WlStatusRoot, WlStatusIpc,
+       WlResize, WlLast }; /* workloads */
+
+typedef struct {
+	double *us;           /* time of each operation */
+	unsigned int n;
+	unsigned long requests; /* made by dwm for the recorded operations */
+	unsigned int recorded;  /* operations RECORD counted the requests of */
+} Result;
+
+static const char *wlnames[] = {
+	[WlBarrier]    = "barrier",
+	[WlMap]        = "map",
+	[WlUnmap]      = "unmap",
+	[WlView]       = "view",
+	[WlKey]        = "key",
+	[WlStatusRoot] = "status-root",
+	[WlStatusIpc]  = "status-ipc",
+	[WlResize]     = "resize",
+};
+
+static const char *fillermods[] = { "Alt", "Alt + Shift", "Alt + Control",
+	"Alt + Control + Shift", "Control", "Control + Shift" };
+static const char *fillerkeys[] = { "A", "B", "C", "D", "E", "F", "G", "H", "I",
+	"K", "L", "M", "N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y",
+	"Z", "5", "6", "7", "8", "9", "0", "F1", "F2", "F3", "F4", "F5", "F6", "F7",
+	"F8", "F9", "F10", "F11", "F12", "Return", "space" };
+static const char *fillerbuttons[] = { "Leftclick", "Middleclick", "Scrollup",
+	"Scrolldown" };
+
+static Display *dpy, *rdpy;   /* rdpy receives what RECORD intercepts */
+static Window root, probe, *wins;
+static unsigned int nwins;
+static Window dwmwin;         /* dwm's _NET_SUPPORTING_WM_CHECK window */
+static int mapped;            /* client windows dwm mapped */
+static unsigned long barriers, requests;
+static int recording;          /* 1 until RECORD started, 2 until it ended */
+static KeyCode superkey;
+static int ipc = -1;
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void
+nextevent(XEvent *ev)
+{
+	struct pollfd pfd = { .fd = ConnectionNumber(dpy), .events = POLLIN };
+
+	while (!XPending(dpy))
+		if (poll(&pfd, 1, TIMEOUT) == 0)
+			die("dwm-perfbench: dwm did not answer within %dms", TIMEOUT);
+	XNextEvent(dpy, ev);
+}
+
+/* handles one event, counting the ones the workloads wait for */
+static void
+pump(void)
+{
+	XEvent ev;
+
+	nextevent(&ev);
+	if (ev.type == MapNotify && ev.xmap.window != probe)
+		mapped++;
+	else if (ev.type == UnmapNotify && !ev.xunmap.send_event && ev.xunmap.window != probe)
+		mapped--;
+	else if (ev.type == ConfigureNotify && ev.xconfigure.send_event && ev.xconfigure.window == probe)
+		barriers++;
+}
+
+/* returns once dwm handled every request made before, and the server every
+ * request dwm made for them. dwm answers a configure request of a tiled
+ * client with a synthetic ConfigureNotify, which can still be followed by
+ * the work dispatch() deferred to the end of its batch, so the second
+ * request is only made after the first is answered */
+static void
+barrier(void)
+{
+	unsigned long target;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		target = barriers + 1;
+		XMoveWindow(dpy, probe, i, 0);
+		while (barriers < target)
+			pump();
+	}
+	if (recording)
+		XRecordProcessReplies(rdpy);
+}
+
+static void
+countrequest(XPointer unused, XRecordInterceptData *d)
+{
+	if (d->category == XRecordFromClient)
+		requests++;
+	else if (d->category == XRecordStartOfData)
+		recording = 2;
+	else if (d->category == XRecordEndOfData)
+		recording = 0;
+	XRecordFreeData(d);
+}
+
+/* starts counting dwm's requests, returns the context to stop with, or 0
+ * without RECORD */
+static XRecordContext
+startrecord(void)
+{
+	XRecordClientSpec spec = dwmwin; /* any resource identifies its client */
+	XRecordRange *range;
+	XRecordContext ctx;
+	struct pollfd pfd = { .events = POLLIN };
+
+	if (!rdpy || !(range = XRecordAllocRange()))
+		return 0;
+	range->core_requests.first = 1;
+	range->core_requests.last = 255; /* extension requests too */
+	ctx = XRecordCreateContext(dpy, 0, &spec, 1, &range, 1);
+	XFree(range);
+	XSync(dpy, False);
+	if (!ctx)
+		return 0;
+	if (!XRecordEnableContextAsync(rdpy, ctx, countrequest, NULL)) {
+		XRecordFreeContext(dpy, ctx);
+		return 0;
+	}
+	requests = 0;
+	recording = 1;
+	XFlush(rdpy);
+	pfd.fd = ConnectionNumber(rdpy);
+	while (recording == 1) { /* or dwm's first requests are missed */
+		XRecordProcessReplies(rdpy);
+		if (recording == 1 && poll(&pfd, 1, TIMEOUT) == 0)
+			die("dwm-perfbench: RECORD did not start within %dms", TIMEOUT);
+	}
+	return ctx;
+}
+
+static unsigned long
+stoprecord(XRecordContext ctx)
+{
+	struct pollfd pfd = { .events = POLLIN };
+
+	XRecordDisableContext(dpy, ctx);
+	XSync(dpy, False);
+	pfd.fd = ConnectionNumber(rdpy);
+	while (recording) {
+		XRecordProcessReplies(rdpy);
+		if (recording && poll(&pfd, 1, TIMEOUT) == 0)
+			die("dwm-perfbench: RECORD did not end within %dms", TIMEOUT);
+	}
+	XRecordFreeContext(dpy, ctx);
+	return requests;
+}
+
+static void
+key(KeySym sym)
+{
+	KeyCode kc = XKeysymToKeycode(dpy, sym);
+
+	XTestFakeKeyEvent(dpy, superkey, True, 0);
+	XTestFakeKeyEvent(dpy, kc, True, 0);
+	XTestFakeKeyEvent(dpy, kc, False, 0);
+	XTestFakeKeyEvent(dpy, superkey, False, 0);
+}
+
+static Window
+createclient(const char *class, unsigned int i, Window transientfor)
+{
+	XClassHint ch = { (char *)class, (char *)class };
+	char name[32];
+	Window w;
+
+	w = XCreateSimpleWindow(dpy, root, 0, 0, 200, 100, 0, 0, 0);
+	snprintf(name, sizeof name, "%s %u", class, i);
+	XStoreName(dpy, w, name);
+	XSetClassHint(dpy, w, &ch);
+	if (transientfor)
+		XSetTransientForHint(dpy, w, transientfor);
+	XSelectInput(dpy, w, StructureNotifyMask);
+	return w;
+}
+
+/* maps windows first to last, waiting for dwm to map them all */
+static void
+mapclients(unsigned int first, unsigned int last)
+{
+	int target = mapped + (last - first);
+	unsigned int i;
+
+	for (i = first; i < last; i++)
+		XMapWindow(dpy, wins[i]);
+	while (mapped < target)
+		pump();
+	barrier();
+}
+
+static void
+unmapclients(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < nwins; i++)
+		XUnmapWindow(dpy, wins[i]);
+	while (mapped > 0)
+		pump();
+	barrier();
+}
+
+static void
+ipcstatus(unsigned int i)
+{
+	char buf[256];
+	size_t len;
+	ssize_t n;
+
+	len = snprintf(buf, sizeof buf, "status ipc %u | load 0.%02u | %u clients\n", i, i % 100, nwins);
+	if (write(ipc, buf, len) != (ssize_t)len)
+		die("dwm-perfbench: write:");
+	for (len = 0; !len || buf[len - 1] != '\n'; len += n)
+		if ((n = read(ipc, buf + len, sizeof buf - 1 - len)) <= 0)
+			die("dwm-perfbench: control socket closed");
+	buf[len - 1] = '\0';
+	if (strcmp(buf, "ok"))
+		die("dwm-perfbench: dwm answered the status with: %s", buf);
+	barrier();
+}
+
+static void
+resizestep(unsigned int i)
+{
+	int d = i % 20 < 10 ? 4 : -4; /* grow, then shrink back */
+
+	XTestFakeRelativeMotionEvent(dpy, d, d, 0);
+	barrier();
+}
+
+static void
+resizebegin(void)
+{
+	XWindowAttributes wa;
+
+	key(XK_1);
+	barrier();
+	XGetWindowAttributes(dpy, wins[0], &wa);
+	XTestFakeMotionEvent(dpy, DefaultScreen(dpy), wa.x + wa.width / 2, wa.y + wa.height / 2, 0);
+	XTestFakeKeyEvent(dpy, superkey, True, 0);
+	XTestFakeButtonEvent(dpy, Button3, True, 0);
+	barrier();
+}
+
+static void
+resizeend(void)
+{
+	XTestFakeButtonEvent(dpy, Button3, False, 0);
+	XTestFakeKeyEvent(dpy, superkey, False, 0);
+	barrier();
+}
+
+/* runs one operation of a workload, the i-th */
+static void
+runop(int wl, unsigned int i)
+{
+	static const KeySym tagkeys[] = { XK_1, XK_2, XK_3, XK_4 };
+	char status[64];
+
+	switch (wl) {
+	case WlBarrier:
+		barrier();
+		break;
+	case WlMap:
+		mapclients(0, nwins);
+		break;
+	case WlUnmap:
+		unmapclients();
+		break;
+	case WlView:
+		key(tagkeys[i % LENGTH(tagkeys)]);
+		barrier();
+		break;
+	case WlKey:
+		key(XK_j);
+		barrier();
+		break;
+	case WlStatusRoot:
+		snprintf(status, sizeof status, "root %u | load 0.%02u | %u clients", i, i % 100, nwins);
+		XStoreName(dpy, root, status);
+		barrier();
+		break;
+	case WlStatusIpc:
+		ipcstatus(i);
+		break;
+	case WlResize:
+		resizestep(i);
+		break;
+	}
+}
+
+/* times every operation on its own, then counts the requests dwm made for
+ * each in a second pass, as RECORD copying them to rdpy slows dwm down. The
+ * storms the map and unmap workloads need between operations are neither */
+static void
+runworkload(int wl, unsigned int reps, Result *r)
+{
+	XRecordContext ctx;
+	unsigned int i;
+	double start;
+
+	r->us = ecalloc(reps, sizeof(double));
+	r->n = r->recorded = 0;
+	r->requests = 0;
+	if (wl == WlStatusIpc && ipc == -1)
+		return;
+	if (wl == WlResize)
+		resizebegin();
+	for (i = 0; i < reps; i++) {
+		if (wl == WlUnmap)
+			mapclients(0, nwins);
+		start = now();
+		runop(wl, i);
+		r->us[r->n++] = now() - start;
+		if (wl == WlMap)
+			unmapclients();
+	}
+	for (i = 0; rdpy && i < reps; i++) {
+		if (wl == WlUnmap)
+			mapclients(0, nwins);
+		ctx = startrecord();
+		runop(wl, reps + i); /* even uncounted, the storms stay paired */
+		if (ctx) {
+			r->requests += stoprecord(ctx);
+			r->recorded++;
+		}
+		if (wl == WlMap)
+			unmapclients();
+		if (!ctx)
+			break;
+	}
+	if (wl == WlResize)
+		resizeend();
+}
+
+static int
+cmpdouble(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static void
+report(int wl, Result *r, const char *unit)
+{
+	double sum = 0;
+	unsigned int i;
+
+	if (!r->n) {
+		printf("%-12s %8s\n", wlnames[wl], "skipped");
+		return;
+	}
+	qsort(r->us, r->n, sizeof(double), cmpdouble);
+	for (i = 0; i < r->n; i++)
+		sum += r->us[i];
+	printf("%-12s %8u %10.1f %10.1f %10.1f %10.1f", wlnames[wl], r->n, sum / r->n,
+	       r->us[r->n / 2], r->us[r->n * 95 / 100], r->us[r->n - 1]);
+	if (!r->recorded)
+		printf(" %12s %s\n", "-", unit);
+	else
+		printf(" %12.1f %s\n", (double)r->requests / r->recorded, unit);
+}
+
+static int
+generate(const char *path, const char *sock, unsigned int n)
+{
+	FILE *f;
+	unsigned int i;
+
+	if (!(f = fopen(path, "w")))
+		return -1;
+	fputs("themes = ( { fonts = ( \"monospace:size=10\" );\n"
+	      "\tnormal-foreground = \"#bbbbbb\"; normal-background = \"#222222\"; normal-border = \"#444444\";\n"
+	      "\tselected-foreground = \"#eeeeee\"; selected-background = \"#005577\"; selected-border = \"#005577\"; } );\n", f);
+	/* the probe is kept on the last tag, out of the way of the workloads */
+	fputs("rules = (\n\t{ class = \"" PROBECLASS "\"; instance = \"NULL\"; title = \"NULL\"; tag-mask = 256; floating = 0; monitor = -1; }", f);
+	for (i = 0; i < n; i++)
+		fprintf(f, ",\n\t{ class = \"Filler%u\"; instance = \"%s\"; title = \"Title %u\"; tag-mask = %u; floating = %u; monitor = -1; }",
+		        i, i % 4 ? "NULL" : "instance", i % 16, i % 512, i % 2);
+	fputs("\n);\nkeybinds = (\n", f);
+	for (i = 0; i < 4; i++)
+		fprintf(f, "\t{ modifier = \"Super\", key = \"%u\", function = \"view\", argument = %u },\n", i + 1, 1u << i);
+	fputs("\t{ modifier = \"Super\", key = \"J\", function = \"focusstack\", argument = +1 }", f);
+	for (i = 0; i < n; i++) {
+		fprintf(f, ",\n\t{ modifier = \"%s\", key = \"%s\", ", fillermods[i % LENGTH(fillermods)],
+		        fillerkeys[i / LENGTH(fillermods) % LENGTH(fillerkeys)]);
+		switch (i % 3) {
+		case 0: fprintf(f, "function = \"spawn\", argument = \"true filler-%u\" }", i % 64); break;
+		case 1: fprintf(f, "function = \"view\", argument = %u }", 1u << (i % 9)); break;
+		case 2: fputs("function = \"zoom\" }", f); break;
+		}
+	}
+	fputs("\n);\nbuttonbinds = (\n"
+	      "\t{ modifier = \"Super\", button = \"Rightclick\", click = \"Client\", function = \"resizemouse\" }", f);
+	for (i = 0; i < n; i++)
+		fprintf(f, ",\n\t{ modifier = \"Control\", button = \"%s\", click = \"%s\", function = \"zoom\" }",
+		        fillerbuttons[i % LENGTH(fillerbuttons)], i % 2 ? "Title" : "Layout");
+	/* redraw on every status change and process every pointer motion, so
+	 * the work is measured instead of what statusrate and refreshrate skip */
+	fprintf(f, "\n);\ntags = ( \"1\", \"2\", \"3\", \"4\", \"5\", \"6\", \"7\", \"8\", \"9\" );\n"
+	        "showbar = true; topbar = true; resizehints = true; lockfullscreen = true;\n"
+	        "borderpx = 1; snap = 32; nmaster = 1; refreshrate = 0; statusrate = 0; mfact = 0.55;\n"
+	        "ipcsocket = \"%s\";\n", sock ? sock : "");
+	return fclose(f);
+}
+
+/* waits for dwm to set up, returning its _NET_SUPPORTING_WM_CHECK window */
+static Window
+finddwm(void)
+{
+	Atom check = XInternAtom(dpy, "_NET_SUPPORTING_WM_CHECK", False), type;
+	unsigned long n, extra;
+	unsigned char *p;
+	Window w = None;
+	int i, format;
+
+	for (i = 0; i < TIMEOUT / 10 && !w; i++) {
+		if (XGetWindowProperty(dpy, root, check, 0, 1, False, XA_WINDOW, &type, &format,
+		    &n, &extra, &p) == Success && p) {
+			if (n)
+				w = *(Window *)p;
+			XFree(p);
+		}
+		if (!w)
+			usleep(10000);
+	}
+	return w;
+}
+
+static int
+connectipc(const char *path)
+{
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	int fd;
+
+	if (!path || strlen(path) >= sizeof(addr.sun_path))
+		return -1;
+	strcpy(addr.sun_path, path);
+	if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) == -1)
+		return -1;
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static void
+usage(void)
+{
+	die("usage: dwm-perfbench [-n clients] [-r runs] [-s socket]\n"
+	    "       dwm-perfbench -g file [-b binds] [-s socket]");
+}
+
+int
+main(int argc, char *argv[])
+{
+	const char *conf = NULL, *sock = NULL;
+	unsigned int i, nclients = 64, reps = 200, nbinds = 10000;
+	int major, minor, dummy;
+	XModifierKeymap *modmap;
+	Result results[WlLast];
+
+	for (i = 1; i < (unsigned int)argc; i++) {
+		if (i + 1 == (unsigned int)argc)
+			usage();
+		else if (!strcmp(argv[i], "-g"))
+			conf = argv[++i];
+		else if (!strcmp(argv[i], "-b"))
+			nbinds = strtoul(argv[++i], NULL, 10);
+		else if (!strcmp(argv[i], "-s"))
+			sock = argv[++i];
+		else if (!strcmp(argv[i], "-n"))
+			nclients = MAX(1, strtoul(argv[++i], NULL, 10));
+		else if (!strcmp(argv[i], "-r"))
+			reps = MAX(1, strtoul(argv[++i], NULL, 10));
+		else
+			usage();
+	}
+	if (conf) {
+		if (generate(conf, sock, nbinds))
+			die("dwm-perfbench: cannot write %s:", conf);
+		return 0;
+	}
+
+	if (!(dpy = XOpenDisplay(NULL)))
+		die("dwm-perfbench: cannot open display");
+	root = DefaultRootWindow(dpy);
+	if (!XTestQueryExtension(dpy, &dummy, &dummy, &major, &minor))
+		die("dwm-perfbench: the server has no XTEST extension");
+	if (!(dwmwin = finddwm()))
+		die("dwm-perfbench: no window manager is running");
+	if (!XRecordQueryVersion(dpy, &major, &minor) || !(rdpy = XOpenDisplay(NULL)))
+		fputs("dwm-perfbench: the server has no RECORD extension, not counting requests\n", stderr);
+	if (sock && (ipc = connectipc(sock)) == -1)
+		fprintf(stderr, "dwm-perfbench: cannot connect to '%s': %s\n", sock, strerror(errno));
+
+	/* the first key on Mod4, which the configuration calls Super */
+	modmap = XGetModifierMapping(dpy);
+	for (i = 0; i < (unsigned int)modmap->max_keypermod && !superkey; i++)
+		superkey = modmap->modifiermap[Mod4MapIndex * modmap->max_keypermod + i];
+	XFreeModifiermap(modmap);
+	if (!superkey)
+		die("dwm-perfbench: no key is mapped to Mod4");
+
+	probe = createclient(PROBECLASS, 0, None);
+	XMapWindow(dpy, probe);
+	XSync(dpy, False);
+	barrier();
+
+	/* every eighth client is a transient of the one before, and floats */
+	nwins = nclients;
+	wins = ecalloc(nwins, sizeof(Window));
+	for (i = 0; i < nwins; i++)
+		wins[i] = createclient("perfbench", i, i % 8 == 7 ? wins[i - 1] : None);
+
+	printf("dwm-perfbench: %u clients, %u runs\n", nwins, reps);
+	printf("%-12s %8s %10s %10s %10s %10s %12s\n", "workload", "ops", "avg (us)",
+	       "p50 (us)", "p95 (us)", "max (us)", "requests/op");
+	for (i = WlBarrier; i <= WlUnmap; i++) {
+		runworkload(i, i == WlBarrier ? reps : MAX(1, reps / 10), &results[i]);
+		report(i, &results[i], i == WlMap || i == WlUnmap ? "(whole storm)" : "");
+	}
+
+	/* the rest run with the clients spread over the first four tags */
+	for (i = 0; i < 4; i++) {
+		key(XK_1 + i);
+		barrier();
+		mapclients(nwins * i / 4, nwins * (i + 1) / 4);
+	}
+	for (i = WlView; i < WlLast; i++) {
+		runworkload(i, reps, &results[i]);
+		report(i, &results[i], "");
+	}
+
+	for (i = 0; i < WlLast; i++)
+		free(results[i].us);
+	unmapclients();
+	free(wins);
+	if (ipc != -1)
+		close(ipc);
+	if (rdpy)
+		XCloseDisplay(rdpy);
+	XCloseDisplay(dpy);
+	return 0;
+}
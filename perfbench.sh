@@ -0,0 +1,41 @@
+#!/bin/sh
+# Runs dwm-perfbench against dwm on a display of its own, see perfbench.c.
+# Uses Xvfb, or Xephyr to watch it with PERFBENCH_SERVER=Xephyr. Arguments
+# are passed to dwm-perfbench, e.g. ./perfbench.sh -n 256 -r 1000, and
+# PERFBENCH_BINDS sets how many keybinds, buttonbinds and rules dwm loads.
+
+PERFBENCH_SERVER=${PERFBENCH_SERVER:-Xvfb}
+PERFBENCH_BINDS=${PERFBENCH_BINDS:-10000}
+
+dir=$(mktemp -d /tmp/dwm-perfbench.XXXXXX) || exit 1
+trap 'kill $DWM_PID $SERVER_PID 2>/dev/null; rm -rf "$dir"' EXIT INT TERM
+
+./dwm-perfbench -g "$dir/dwm.conf" -b "$PERFBENCH_BINDS" -s "$dir/dwm.sock" || exit 1
+
+case $PERFBENCH_SERVER in
+Xephyr) Xephyr -displayfd 3 -ac -br -noreset -screen 1920x1080 +extension RECORD 3>"$dir/display" 2>"$dir/server.log" & ;;
+*)      Xvfb -displayfd 3 -nolisten tcp -screen 0 1920x1080x24 +extension RECORD 3>"$dir/display" 2>"$dir/server.log" & ;;
+esac
+SERVER_PID=$!
+# the server writes its display number once it accepts connections
+while [ ! -s "$dir/display" ]; do
+	if ! kill -0 $SERVER_PID 2>/dev/null; then
+		cat "$dir/server.log" >&2
+		exit 1
+	fi
+	sleep 0.1
+done
+DISPLAY=:$(cat "$dir/display")
+export DISPLAY
+
+# keep the configuration backup, snapshot and font cache in $dir
+XDG_DATA_HOME=$dir ./dwm -c "$dir/dwm.conf" 2>"$dir/dwm.log" &
+DWM_PID=$!
+
+./dwm-perfbench -s "$dir/dwm.sock" "$@"
+status=$?
+if [ $status -ne 0 ]; then
+	echo "dwm-perfbench failed, dwm's log:" >&2
+	cat "$dir/dwm.log" >&2
+fi
+exit $status